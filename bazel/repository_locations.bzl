@@ -598,6 +598,7 @@ REPOSITORY_LOCATIONS_SPEC = dict(
         use_category = ["observability_ext"],
         extensions = [
             "envoy.tracers.opentelemetry",
+            "envoy.tracers.opentelemetry.samplers.adaptive",
             "envoy.tracers.opentelemetry.samplers.always_on",
             "envoy.tracers.opentelemetry.samplers.dynatrace",
         ],
@@ -84,6 +84,31 @@ bool Matcher::match(absl::string_view value) const {
   return matched;
 }
 
+absl::optional<unsigned int> Matcher::lowestMatchingId(absl::string_view value) const {
+  absl::optional<unsigned int> lowest_id;
+  ScratchThreadLocalPtr local_scratch;
+  hs_scratch_t* scratch = getScratch(local_scratch);
+  hs_error_t err = hs_scan(
+      database_, value.data(), value.size(), 0, scratch,
+      [](unsigned int id, unsigned long long, unsigned long long, unsigned int,
+         void* context) -> int {
+        auto* lowest_id = static_cast<absl::optional<unsigned int>*>(context);
+        if (!lowest_id->has_value() || id < lowest_id->value()) {
+          *lowest_id = id;
+        }
+
+        // Matches are reported in the order of their end offset, so continue searching for a lower
+        // id unless no id can be lower.
+        return id == 0 ? 1 : 0;
+      },
+      &lowest_id);
+  if (err != HS_SUCCESS && err != HS_SCAN_TERMINATED) {
+    IS_ENVOY_BUG(fmt::format("unable to scan, error code {}", err));
+  }
+
+  return lowest_id;
+}
+
 std::string Matcher::replaceAll(absl::string_view value, absl::string_view substitution) const {
   // Find matched bounds.
   std::vector<Bound> bounds;
@@ -44,6 +44,9 @@ public:
   // Envoy::Matcher::InputMatcher
   bool match(const ::Envoy::Matcher::MatchingDataType& input) override;
 
+  // Returns the lowest id of the expressions matching the value, or absl::nullopt if none matches.
+  absl::optional<unsigned int> lowestMatchingId(absl::string_view value) const;
+
 private:
   hs_database_t* database_{};
   hs_database_t* start_of_match_database_{};
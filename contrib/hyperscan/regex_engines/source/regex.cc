@@ -1,10 +1,46 @@
 #include "contrib/hyperscan/regex_engines/source/regex.h"
 
+#include <numeric>
+
 namespace Envoy {
 namespace Extensions {
 namespace Regex {
 namespace Hyperscan {
 
+namespace {
+
+std::vector<const char*> expressions(const std::vector<std::string>& regexes) {
+  std::vector<const char*> expressions;
+  expressions.reserve(regexes.size());
+  for (const std::string& regex : regexes) {
+    expressions.push_back(regex.c_str());
+  }
+  return expressions;
+}
+
+std::vector<unsigned int> ids(const std::vector<std::string>& regexes) {
+  std::vector<unsigned int> ids(regexes.size());
+  std::iota(ids.begin(), ids.end(), 0);
+  return ids;
+}
+
+} // namespace
+
+SetMatcher::SetMatcher(const std::vector<std::string>& regexes, Event::Dispatcher& dispatcher,
+                       ThreadLocal::SlotAllocator& tls)
+    // Each id only needs to be reported once.
+    : matcher_(expressions(regexes),
+               std::vector<unsigned int>(regexes.size(), HS_FLAG_UTF8 | HS_FLAG_SINGLEMATCH),
+               ids(regexes), dispatcher, tls, false) {}
+
+absl::optional<uint32_t> SetMatcher::firstMatch(absl::string_view value) const {
+  return matcher_.lowestMatchingId(value);
+}
+
+bool SetMatcher::matchAny(absl::string_view value) const {
+  return static_cast<const Envoy::Regex::CompiledMatcher&>(matcher_).match(value);
+}
+
 HyperscanEngine::HyperscanEngine(Event::Dispatcher& dispatcher, ThreadLocal::SlotAllocator& tls)
     : dispatcher_(dispatcher), tls_(tls) {}
 
@@ -18,6 +54,11 @@ HyperscanEngine::matcher(const std::string& regex) const {
                                                                        dispatcher_, tls_, true);
 }
 
+absl::StatusOr<Envoy::Regex::CompiledSetMatcherPtr>
+HyperscanEngine::setMatcher(const std::vector<std::string>& regexes) const {
+  return std::make_unique<SetMatcher>(regexes, dispatcher_, tls_);
+}
+
 } // namespace Hyperscan
 } // namespace Regex
 } // namespace Extensions
@@ -9,10 +9,27 @@ namespace Extensions {
 namespace Regex {
 namespace Hyperscan {
 
+// Matches a set of regexes with a single Hyperscan database, in which each regex has its index as
+// id.
+class SetMatcher : public Envoy::Regex::CompiledSetMatcher {
+public:
+  SetMatcher(const std::vector<std::string>& regexes, Event::Dispatcher& dispatcher,
+             ThreadLocal::SlotAllocator& tls);
+
+  // Envoy::Regex::CompiledSetMatcher
+  absl::optional<uint32_t> firstMatch(absl::string_view value) const override;
+  bool matchAny(absl::string_view value) const override;
+
+private:
+  const Matching::InputMatchers::Hyperscan::Matcher matcher_;
+};
+
 class HyperscanEngine : public Envoy::Regex::Engine {
 public:
   explicit HyperscanEngine(Event::Dispatcher& dispatcher, ThreadLocal::SlotAllocator& tls);
   absl::StatusOr<Envoy::Regex::CompiledMatcherPtr> matcher(const std::string& regex) const override;
+  absl::StatusOr<Envoy::Regex::CompiledSetMatcherPtr>
+  setMatcher(const std::vector<std::string>& regexes) const override;
 
 private:
   Event::Dispatcher& dispatcher_;
@@ -33,6 +33,24 @@ TEST_F(EngineTest, Matcher) {
   EXPECT_TRUE(engine_->matcher("^/asdf/.+").status().ok());
 }
 
+// Verify that the set matcher reports the lowest index of the matching regexes.
+TEST_F(EngineTest, SetMatcher) {
+  setup();
+
+  auto matcher = engine_->setMatcher({"^/asdf/.+", "^/qwer/.+", "^/asdf/a.+"});
+  ASSERT_TRUE(matcher.status().ok());
+  EXPECT_EQ(0, (*matcher)->firstMatch("/asdf/abc"));
+  EXPECT_EQ(1, (*matcher)->firstMatch("/qwer/abc"));
+  EXPECT_EQ(absl::nullopt, (*matcher)->firstMatch("/zxcv/abc"));
+  EXPECT_TRUE((*matcher)->matchAny("/qwer/abc"));
+  EXPECT_FALSE((*matcher)->matchAny("/zxcv/abc"));
+
+  matcher = engine_->setMatcher({"^/qwer/.+", "^/asdf/a.+", "^/asdf/.+"});
+  ASSERT_TRUE(matcher.status().ok());
+  EXPECT_EQ(1, (*matcher)->firstMatch("/asdf/abc"));
+  EXPECT_EQ(2, (*matcher)->firstMatch("/asdf/bcd"));
+}
+
 } // namespace Hyperscan
 } // namespace Regex
 } // namespace Extensions
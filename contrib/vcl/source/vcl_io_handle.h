@@ -53,6 +53,7 @@ public:
 
   bool supportsMmsg() const override;
   bool supportsUdpGro() const override { return false; }
+  bool supportsAdaptiveReadSize() const override { return true; }
 
   Api::SysCallIntResult bind(Envoy::Network::Address::InstanceConstSharedPtr address) override;
   Api::SysCallIntResult listen(int backlog) override;
@@ -296,6 +296,18 @@ public:
    */
   virtual Reservation reserveForRead() PURE;
 
+  /**
+   * Reserve space in the buffer for reading at most max_length bytes into, e.g. when the caller
+   * predicts the size of the next read. The reservation is not larger than the one which would be
+   * returned by reserveForRead(), but may still be larger than max_length.
+   * @param max_length supplies the maximum number of bytes which will be read.
+   * @return a `Reservation`, on which `commit()` can be called, or which can
+   *   be destructed to discard any resources in the `Reservation`.
+   */
+  virtual Reservation reserveForReadWithMaxLength(uint64_t /* max_length */) {
+    return reserveForRead();
+  }
+
   /**
    * Reserve space in the buffer in a single slice.
    * @param length the exact length of the reservation.
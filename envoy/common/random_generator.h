@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
 #include <string>
@@ -8,6 +10,9 @@
 
 #include "source/common/common/interval_value.h"
 
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
 namespace Envoy {
 namespace Random {
 
@@ -25,6 +30,23 @@ public:
    */
   virtual result_type random() PURE;
 
+  /**
+   * @return uint64_t a new random number which must not be used where unpredictability matters
+   * (e.g. for secrets or nonces), but is good enough for sampling, load balancing or jitter.
+   * Implementations may return it from a cheaper source than random(), which is used by default.
+   */
+  virtual result_type fastRandom() { return random(); }
+
+  /**
+   * Fills the span with random numbers as returned by fastRandom(), for the callers which need
+   * several of them at once.
+   */
+  virtual void fastRandomFill(absl::Span<result_type> out) {
+    for (result_type& value : out) {
+      value = fastRandom();
+    }
+  }
+
   /*
    * @return the smallest value that `operator()` may return. The value is
    * strictly less than `max()`.
@@ -49,6 +71,19 @@ public:
    */
   virtual std::string uuid() PURE;
 
+  using UuidBuffer = std::array<char, 36>;
+
+  /**
+   * Writes a uuid4 as returned by uuid() into the buffer, without allocating a string for it.
+   * @return absl::string_view the uuid in the buffer.
+   */
+  virtual absl::string_view writeUuid(UuidBuffer& buffer) {
+    const std::string value = uuid();
+    const size_t length = std::min(value.size(), buffer.size());
+    std::copy_n(value.data(), length, buffer.data());
+    return {buffer.data(), length};
+  }
+
   /**
    * @return a random boolean value, with probability `p` equaling true.
    */
@@ -1,11 +1,16 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "envoy/common/matchers.h"
 #include "envoy/config/typed_config.h"
 #include "envoy/server/factory_context.h"
 
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Regex {
 
@@ -26,6 +31,30 @@ public:
 
 using CompiledMatcherPtr = std::unique_ptr<const CompiledMatcher>;
 
+/**
+ * A set of regex expressions compiled together, so that a value is matched against all of them in
+ * a single pass.
+ */
+class CompiledSetMatcher {
+public:
+  virtual ~CompiledSetMatcher() = default;
+
+  /**
+   * @param value supplies the value to match.
+   * @return the index of the first expression, in the order they were compiled, which matches the
+   *         value, or absl::nullopt if none matches.
+   */
+  virtual absl::optional<uint32_t> firstMatch(absl::string_view value) const PURE;
+
+  /**
+   * @param value supplies the value to match.
+   * @return true if any of the expressions matches the value.
+   */
+  virtual bool matchAny(absl::string_view value) const PURE;
+};
+
+using CompiledSetMatcherPtr = std::unique_ptr<const CompiledSetMatcher>;
+
 /**
  * A regular expression engine which turns regular expressions into compiled matchers.
  */
@@ -38,6 +67,14 @@ public:
    * @param regex the regex expression match string
    */
   virtual absl::StatusOr<CompiledMatcherPtr> matcher(const std::string& regex) const PURE;
+
+  /**
+   * Create a @ref CompiledSetMatcher with the given regex expressions. Each expression matches the
+   * same values as the @ref CompiledMatcher created from it by matcher().
+   * @param regexes the regex expression match strings.
+   */
+  virtual absl::StatusOr<CompiledSetMatcherPtr>
+  setMatcher(const std::vector<std::string>& regexes) const PURE;
 };
 
 using EnginePtr = std::shared_ptr<Engine>;
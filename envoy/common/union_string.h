@@ -1,6 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
 
 #include "source/common/common/assert.h"
 #include "source/common/common/utility.h"
@@ -11,16 +14,26 @@
 
 namespace Envoy {
 
+// The number of characters stored inline by InlinedString, beyond which it allocates.
+inline constexpr size_t InlinedStringCapacity{128};
+
 /**
  * Convenient type for an inline vector that will be used by InlinedString.
  */
-using InlinedStringVector = absl::InlinedVector<char, 128>;
+using InlinedStringVector = absl::InlinedVector<char, InlinedStringCapacity>;
+
+/**
+ * Convenient type for an immutable string shared between UnionStrings, such as the values interned
+ * by Http::HeaderValueInterner.
+ */
+using InternedStringSharedPtr = std::shared_ptr<const std::string>;
 
 /**
  * Convenient type for the underlying type of InlinedString that allows a variant
- * between string_view and the InlinedVector.
+ * between string_view, the InlinedVector and an interned string.
  */
-using VariantStringOrView = absl::variant<absl::string_view, InlinedStringVector>;
+using VariantStringOrView =
+    absl::variant<absl::string_view, InlinedStringVector, InternedStringSharedPtr>;
 
 // This includes the NULL (StringUtil::itoa technically only needs 21).
 inline constexpr size_t MaxIntegerLength{32};
@@ -44,12 +57,18 @@ inline const InlinedStringVector& getInVec(const VariantStringOrView& buffer) {
   return absl::get<InlinedStringVector>(buffer);
 }
 
+inline const std::string& getInterned(const VariantStringOrView& buffer) {
+  return *absl::get<InternedStringSharedPtr>(buffer);
+}
+
 /**
  * This is a string implementation that unified string reference and owned string. It is heavily
- * optimized for performance. It supports 2 different types of storage and can switch between them:
+ * optimized for performance. It supports 3 different types of storage and can switch between them:
  * 1) A string reference.
  * 2) A string InlinedVector (an optimized interned string for small strings, but allows heap
  * allocation if needed).
+ * 3) A reference counted immutable string, shared with other strings of the same value. Any
+ * mutation switches it to an InlinedVector.
  */
 template <class Validator> class UnionStringBase {
 public:
@@ -95,14 +114,16 @@ public:
     ASSERT(valid(absl::string_view(data, data_size)));
 
     switch (type()) {
-    case Type::Reference: {
+    case Type::Reference:
+    case Type::Interned: {
       // Rather than be too clever and optimize this uncommon case, we switch to
       // Inline mode and copy.
-      const absl::string_view prev = getStrView(buffer_);
-      buffer_ = InlinedStringVector();
+      InlinedStringVector copy;
       // Assigning new_capacity to avoid resizing when appending the new data
-      getInVec(buffer_).reserve(new_capacity);
-      getInVec(buffer_).assign(prev.begin(), prev.end());
+      copy.reserve(new_capacity);
+      const absl::string_view prev = getStringView();
+      copy.assign(prev.begin(), prev.end());
+      buffer_ = std::move(copy);
       break;
     }
     case Type::Inline: {
@@ -144,20 +165,31 @@ public:
    * @return an absl::string_view.
    */
   absl::string_view getStringView() const {
-    if (type() == Type::Reference) {
+    switch (type()) {
+    case Type::Reference:
       return getStrView(buffer_);
+    case Type::Inline:
+      return {getInVec(buffer_).data(), getInVec(buffer_).size()};
+    case Type::Interned:
+      return getInterned(buffer_);
     }
-    ASSERT(type() == Type::Inline);
-    return {getInVec(buffer_).data(), getInVec(buffer_).size()};
+    PANIC_DUE_TO_CORRUPT_ENUM;
   }
 
   /**
    * Return the string to a default state. Reference strings are not touched. Both inline/dynamic
-   * strings are reset to zero size.
+   * strings are reset to zero size, and interned strings are released.
    */
   void clear() {
-    if (type() == Type::Inline) {
+    switch (type()) {
+    case Type::Reference:
+      break;
+    case Type::Inline:
       getInVec(buffer_).clear();
+      break;
+    case Type::Interned:
+      buffer_ = InlinedStringVector();
+      break;
     }
   }
 
@@ -172,9 +204,11 @@ public:
    * Set the value of the string by copying data into it. This overwrites any existing string.
    */
   void setCopy(const char* data, uint32_t size) {
+    // An interned string is released only once copied, in case the data points into it.
+    Storage previous;
     if (!absl::holds_alternative<InlinedStringVector>(buffer_)) {
-      // Switching from Type::Reference to Type::Inline
-      buffer_ = InlinedStringVector();
+      // Switching from Type::Reference or Type::Interned to Type::Inline
+      previous = std::exchange(buffer_, InlinedStringVector());
     }
 
     getInVec(buffer_).reserve(size);
@@ -200,8 +234,8 @@ public:
     char inner_buffer[MaxIntegerLength];
     const uint32_t int_length = StringUtil::itoa(inner_buffer, MaxIntegerLength, value);
 
-    if (type() == Type::Reference) {
-      // Switching from Type::Reference to Type::Inline
+    if (type() != Type::Inline) {
+      // Switching from Type::Reference or Type::Interned to Type::Inline
       buffer_ = InlinedStringVector();
     }
     ASSERT((getInVec(buffer_).capacity()) > MaxIntegerLength);
@@ -218,21 +252,30 @@ public:
     ASSERT(valid());
   }
 
+  /**
+   * Set the value of the string to an interned string, which is shared rather than copied.
+   * @param interned_value the non-null interned string.
+   */
+  void setInterned(InternedStringSharedPtr interned_value) {
+    ASSERT(interned_value != nullptr);
+    buffer_ = std::move(interned_value);
+    ASSERT(valid());
+  }
+
   /**
    * @return whether the string is a reference or an InlinedVector.
    */
   bool isReference() const { return type() == Type::Reference; }
 
+  /**
+   * @return whether the string is an interned string.
+   */
+  bool isInterned() const { return type() == Type::Interned; }
+
   /**
    * @return the size of the string, not including the null terminator.
    */
-  uint32_t size() const {
-    if (type() == Type::Reference) {
-      return getStrView(buffer_).size();
-    }
-    ASSERT(type() == Type::Inline);
-    return getInVec(buffer_).size();
-  }
+  uint32_t size() const { return getStringView().size(); }
 
   bool operator==(const char* rhs) const {
     return getStringView() == absl::NullSafeStringView(rhs);
@@ -261,7 +304,7 @@ public:
   Storage& storage() { return buffer_; }
 
 protected:
-  enum class Type { Reference, Inline };
+  enum class Type { Reference, Inline, Interned };
 
   bool valid() const { return Validator()(getStringView()); }
 
@@ -271,13 +314,15 @@ protected:
    * @return the type of backing storage for the string.
    */
   Type type() const {
-    // buffer_.index() is correlated with the order of Reference and Inline in the
+    // buffer_.index() is correlated with the order of Reference, Inline and Interned in the
     // enum.
-    ASSERT((buffer_.index() == 0) || (buffer_.index() == 1));
+    ASSERT((buffer_.index() == 0) || (buffer_.index() == 1) || (buffer_.index() == 2));
     ASSERT((buffer_.index() == 0 && absl::holds_alternative<absl::string_view>(buffer_)) ||
            (buffer_.index() != 0));
     ASSERT((buffer_.index() == 1 && absl::holds_alternative<InlinedStringVector>(buffer_)) ||
            (buffer_.index() != 1));
+    ASSERT((buffer_.index() == 2 && absl::holds_alternative<InternedStringSharedPtr>(buffer_)) ||
+           (buffer_.index() != 2));
     return Type(buffer_.index());
   }
 
@@ -26,6 +26,7 @@
 #include "absl/types/optional.h"
 
 namespace Envoy {
+class MonotonicArena;
 namespace Router {
 class RouteConfigProvider;
 }
@@ -1250,6 +1251,13 @@ public:
    * @param return the worker thread's dispatcher.
    */
   virtual Event::Dispatcher& dispatcher() PURE;
+
+  /**
+   * Allows filters to be allocated from the arena of the stream, see makeSharedInArena(). A filter
+   * may only be allocated from it if nothing references the filter once the stream is destroyed.
+   * @return the arena of the stream, if the filter chain is created for a stream which has one.
+   */
+  virtual OptRef<MonotonicArena> streamArena() { return {}; }
 };
 } // namespace Http
 } // namespace Envoy
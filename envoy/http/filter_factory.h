@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <map>
 
@@ -52,6 +53,14 @@ public:
    *         nullopt if no decision can be made explicitly for the filter.
    */
   virtual absl::optional<bool> filterDisabled(absl::string_view config_name) const PURE;
+
+  /**
+   * @return a never reused id of the object which the filterDisabled() decisions are derived from,
+   *         e.g. the route of the stream, so that the filters enabled by the decisions may be
+   *         computed once for it and reused by the filter chains created with options of the same
+   *         id. 0 if the decisions may not be reused.
+   */
+  virtual uint64_t filterDisabledCacheId() const { return 0; }
 };
 
 class EmptyFilterChainOptions : public FilterChainOptions {
@@ -226,6 +226,13 @@ public:
    */
   virtual bool supportsUdpGro() const PURE;
 
+  /**
+   * @return true if reads should be capped by a size predicted from the previous reads of the
+   * connection. Handles which move buffered slices instead of copying from the kernel return
+   * false, as a cap would only split and copy those slices.
+   */
+  virtual bool supportsAdaptiveReadSize() const PURE;
+
   /**
    * Bind to address. The handle should have been created with a call to socket()
    * @param address address to bind to.
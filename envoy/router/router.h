@@ -1240,6 +1240,13 @@ public:
    */
   virtual absl::optional<bool> filterDisabled(absl::string_view config_name) const PURE;
 
+  /**
+   * @return an id of the route, which is never reused by another route, so that its
+   *         filterDisabled() decisions may be cached by the id. 0 if they may not be cached, e.g.
+   *         for a route created for a single stream.
+   */
+  virtual uint64_t filterDisabledCacheId() const { return 0; }
+
   /**
    * This is a helper to get the route's per-filter config if it exists, up along the config
    * hierarchy(Route --> VirtualHost --> RouteConfiguration). Or nullptr if none of them exist.
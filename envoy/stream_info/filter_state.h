@@ -7,6 +7,8 @@
 #include "envoy/config/typed_config.h"
 
 #include "source/common/common/fmt.h"
+#include "source/common/common/inline_map.h"
+#include "source/common/common/macros.h"
 #include "source/common/common/utility.h"
 #include "source/common/protobuf/protobuf.h"
 
@@ -144,8 +146,74 @@ public:
   using Objects = std::vector<FilterObject>;
   using ObjectsPtr = std::unique_ptr<Objects>;
 
+  using InlineKeyDescriptor = InlineMapDescriptor<std::string>;
+
+  // A key to a well-known data name, see registerInlineKey().
+  class InlineKey {
+  public:
+    // The name of the data.
+    absl::string_view name() const { return name_; }
+    // The slot of the data, or absl::nullopt if the name was registered after finalizeInlineKeys(),
+    // in which case the data is looked up by name.
+    const absl::optional<InlineKeyDescriptor::Handle>& handle() const { return handle_; }
+
+  private:
+    friend class FilterState;
+
+    InlineKey(absl::string_view name, absl::optional<InlineKeyDescriptor::Handle> handle)
+        : name_(name), handle_(handle) {}
+
+    const std::string name_;
+    const absl::optional<InlineKeyDescriptor::Handle> handle_;
+  };
+
   virtual ~FilterState() = default;
 
+  /**
+   * @return the descriptor of the well-known data names, see finalizeInlineKeys().
+   */
+  static InlineKeyDescriptor& inlineKeyDescriptor() {
+    MUTABLE_CONSTRUCT_ON_FIRST_USE(InlineKeyDescriptor);
+  }
+
+  /**
+   * Registers a well-known data name. The data stored with this name, whether it is set by name
+   * or not, is kept in a fixed slot of each filter state rather than in a hash map, and can be
+   * looked up with the returned key without hashing the name. Registering the same name again
+   * returns the same key.
+   *
+   * Names only get a slot if they are registered before finalizeInlineKeys(), typically to
+   * initialize a global:
+   *
+   *   const FilterState::InlineKey MyInlineKey = FilterState::registerInlineKey("my.data.name");
+   *
+   * A name registered later, e.g. by a dynamically loaded extension, gets a key which looks the
+   * data up by name instead, and the descriptor is not accessed, as workers may be reading it.
+   *
+   * @param data_name the name of the data.
+   * @return the key to look up the data with.
+   */
+  static InlineKey registerInlineKey(absl::string_view data_name) {
+    InlineKeyDescriptor& descriptor = inlineKeyDescriptor();
+    if (descriptor.finalized()) {
+      return {data_name, absl::nullopt};
+    }
+    return {data_name, descriptor.addInlineKey(data_name)};
+  }
+
+  /**
+   * Finalizes the well-known data names. This must be called on the main thread before any other
+   * thread creates a filter state or registers a name, as the descriptor is not synchronized.
+   * Filter states only keep data in slots once the names are finalized, and keep all the data by
+   * name before. Calling it again is a no-op.
+   */
+  static void finalizeInlineKeys() {
+    InlineKeyDescriptor& descriptor = inlineKeyDescriptor();
+    if (!descriptor.finalized()) {
+      descriptor.finalize();
+    }
+  }
+
   /**
    * @param data_name the name of the data being set.
    * @param data an owning pointer to the data to be stored.
@@ -180,6 +248,21 @@ public:
    */
   virtual const Object* getDataReadOnlyGeneric(absl::string_view data_name) const PURE;
 
+  /**
+   * @param data_key the key of the well-known data being looked up (mutable/readonly).
+   * @return a typed pointer to the stored data or nullptr if the data does not exist or the data
+   * type does not match the expected type.
+   */
+  template <typename T> const T* getDataReadOnly(const InlineKey& data_key) const {
+    return dynamic_cast<const T*>(getDataReadOnlyGeneric(data_key));
+  }
+
+  /**
+   * @param data_key the key of the well-known data being looked up (mutable/readonly).
+   * @return a const pointer to the stored data or nullptr if the data does not exist.
+   */
+  virtual const Object* getDataReadOnlyGeneric(const InlineKey& data_key) const PURE;
+
   /**
    * @param data_name the name of the data being looked up (mutable/readonly).
    * @return a typed pointer to the stored data or nullptr if the data does not exist or the data
@@ -201,6 +284,21 @@ public:
    */
   virtual std::shared_ptr<Object> getDataSharedMutableGeneric(absl::string_view data_name) PURE;
 
+  /**
+   * @param data_key the key of the well-known data being looked up (mutable/readonly).
+   * @return a typed pointer to the stored data or nullptr if the data does not exist or the data
+   * type does not match the expected type.
+   */
+  template <typename T> T* getDataMutable(const InlineKey& data_key) {
+    return dynamic_cast<T*>(getDataSharedMutableGeneric(data_key).get());
+  }
+
+  /**
+   * @param data_key the key of the well-known data being looked up (mutable/readonly).
+   * @return a shared pointer to the stored data or nullptr if the data does not exist.
+   */
+  virtual std::shared_ptr<Object> getDataSharedMutableGeneric(const InlineKey& data_key) PURE;
+
   /**
    * @param data_name the name of the data being probed.
    * @return Whether data of the type and name specified exists in the
@@ -210,6 +308,14 @@ public:
     return getDataReadOnly<T>(data_name) != nullptr;
   }
 
+  /**
+   * @param data_key the key of the well-known data being probed.
+   * @return Whether data of the type and key specified exists in the data store.
+   */
+  template <typename T> bool hasData(const InlineKey& data_key) const {
+    return getDataReadOnly<T>(data_key) != nullptr;
+  }
+
   /**
    * @param data_name the name of the data being probed.
    * @return Whether data of any type and the name specified exists in the
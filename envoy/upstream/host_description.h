@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
@@ -86,6 +87,16 @@ public:
 
 class ClusterInfo;
 
+/**
+ * The outcome of the last successful happy eyeballs connection to a host.
+ */
+struct HappyEyeballsOutcome {
+  // The address family of the connection.
+  Network::Address::IpVersion family_;
+  // The time it took to establish the connection.
+  std::chrono::milliseconds connect_time_;
+};
+
 /**
  * A description of an upstream host.
  */
@@ -241,6 +252,17 @@ public:
    */
   virtual void setLastHcPassTime(MonotonicTime last_hc_pass_time) PURE;
 
+  /**
+   * @return the outcome of the last successful happy eyeballs connection to the host, if any.
+   */
+  virtual absl::optional<HappyEyeballsOutcome> happyEyeballsOutcome() const PURE;
+
+  /**
+   * Set or clear the outcome of the last happy eyeballs connection to the host. This may be called
+   * from any thread.
+   */
+  virtual void setHappyEyeballsOutcome(absl::optional<HappyEyeballsOutcome> outcome) const PURE;
+
   virtual Network::UpstreamTransportSocketFactory&
   resolveTransportSocketFactory(const Network::Address::InstanceConstSharedPtr& dest_address,
                                 const envoy::config::core::v3::Metadata* metadata) const PURE;
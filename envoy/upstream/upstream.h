@@ -732,6 +732,8 @@ public:
   COUNTER(upstream_cx_destroy_remote)                                                              \
   COUNTER(upstream_cx_destroy_remote_with_active_rq)                                               \
   COUNTER(upstream_cx_destroy_with_active_rq)                                                      \
+  COUNTER(upstream_cx_happy_eyeballs_cached_delay)                                                 \
+  COUNTER(upstream_cx_happy_eyeballs_cached_family)                                                \
   COUNTER(upstream_cx_http1_total)                                                                 \
   COUNTER(upstream_cx_http2_total)                                                                 \
   COUNTER(upstream_cx_http3_total)                                                                 \
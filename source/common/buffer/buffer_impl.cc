@@ -363,6 +363,10 @@ Reservation OwnedImpl::reserveForRead() {
   return reserveWithMaxLength(default_read_reservation_size_);
 }
 
+Reservation OwnedImpl::reserveForReadWithMaxLength(uint64_t max_length) {
+  return reserveWithMaxLength(std::min(max_length, default_read_reservation_size_));
+}
+
 Reservation OwnedImpl::reserveWithMaxLength(uint64_t max_length) {
   Reservation reservation = Reservation::bufferImplUseOnlyConstruct(*this);
   if (max_length == 0) {
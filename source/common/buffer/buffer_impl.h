@@ -690,6 +690,7 @@ public:
   void move(Instance& rhs, uint64_t length) override;
   void move(Instance& rhs, uint64_t length, bool reset_drain_trackers_and_accounting) override;
   Reservation reserveForRead() override;
+  Reservation reserveForReadWithMaxLength(uint64_t max_length) override;
   ReservationSingleSlice reserveSingleSlice(uint64_t length, bool separate_slice = false) override;
   ssize_t search(const void* data, uint64_t size, size_t start, size_t length) const override;
   bool startsWith(absl::string_view data) const override;
@@ -78,11 +78,15 @@ SliceDataPtr WatermarkBuffer::extractMutableFrontSlice() {
   return result;
 }
 
+Reservation WatermarkBuffer::reserveForRead() {
+  return reserveForReadWithMaxLength(default_read_reservation_size_);
+}
+
 // Adjust the reservation size based on space available before hitting
 // the high watermark to avoid overshooting by a lot and thus violating the limits
 // the watermark is imposing.
-Reservation WatermarkBuffer::reserveForRead() {
-  constexpr auto preferred_length = default_read_reservation_size_;
+Reservation WatermarkBuffer::reserveForReadWithMaxLength(uint64_t max_length) {
+  const uint64_t preferred_length = std::min(max_length, default_read_reservation_size_);
   uint64_t adjusted_length = preferred_length;
 
   if (high_watermark_ > 0 && preferred_length > 0) {
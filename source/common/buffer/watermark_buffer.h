@@ -41,6 +41,7 @@ public:
   void move(Instance& rhs, uint64_t length, bool reset_drain_trackers_and_accounting) override;
   SliceDataPtr extractMutableFrontSlice() override;
   Reservation reserveForRead() override;
+  Reservation reserveForReadWithMaxLength(uint64_t max_length) override;
   void postProcess() override { checkLowWatermark(); }
   void appendSliceForTest(const void* data, uint64_t size) override;
   void appendSliceForTest(absl::string_view data) override;
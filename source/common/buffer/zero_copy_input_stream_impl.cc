@@ -19,6 +19,12 @@ void ZeroCopyInputStreamImpl::move(Buffer::Instance& instance) {
   buffer_->move(instance);
 }
 
+void ZeroCopyInputStreamImpl::move(Buffer::Instance& instance, uint64_t length) {
+  ASSERT(!finished_);
+
+  buffer_->move(instance, length);
+}
+
 void ZeroCopyInputStreamImpl::drainLastSlice() {
   if (position_ != 0) {
     buffer_->drain(position_);
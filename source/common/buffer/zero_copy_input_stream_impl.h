@@ -23,6 +23,9 @@ public:
   // if the stream is not finished
   void move(Buffer::Instance& instance);
 
+  // Add the first length bytes of a buffer to input stream, if the stream is not finished
+  void move(Buffer::Instance& instance, uint64_t length);
+
   // Mark the stream is finished
   void finish() { finished_ = true; }
 
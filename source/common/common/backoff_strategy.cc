@@ -15,7 +15,7 @@ uint64_t JitteredExponentialBackOffStrategy::nextBackOffMs() {
   ASSERT(backoff > 0);
   // Set next_interval_ to max_interval_ if doubling the interval would exceed the max or overflow.
   next_interval_ = (next_interval_ < doubling_limit_) ? (next_interval_ * 2u) : max_interval_;
-  return (random_.random() % backoff);
+  return (random_.fastRandom() % backoff);
 }
 
 void JitteredExponentialBackOffStrategy::reset() { next_interval_ = base_interval_; }
@@ -28,7 +28,7 @@ JitteredLowerBoundBackOffStrategy::JitteredLowerBoundBackOffStrategy(
 
 uint64_t JitteredLowerBoundBackOffStrategy::nextBackOffMs() {
   // random(min_interval_, 1.5 * min_interval_)
-  return (random_.random() % (min_interval_ >> 1)) + min_interval_;
+  return (random_.fastRandom() % (min_interval_ >> 1)) + min_interval_;
 }
 
 FixedBackOffStrategy::FixedBackOffStrategy(uint64_t interval_ms) : interval_ms_(interval_ms) {
@@ -1,12 +1,14 @@
 #include "source/common/common/base64.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
 
-#include "absl/container/fixed_array.h"
 #include "absl/strings/str_cat.h"
 
 namespace Envoy {
@@ -50,167 +52,258 @@ constexpr unsigned char URL_REVERSE_LOOKUP_TABLE[256] = {
     64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64};
 // clang-format on
 
-inline bool decodeBase(const uint8_t cur_char, uint64_t pos, std::string& ret,
-                       const unsigned char* const reverse_lookup_table) {
-  const unsigned char c = reverse_lookup_table[static_cast<uint32_t>(cur_char)];
-  if (c == 64) {
-    // Invalid character
-    return false;
-  }
-
-  switch (pos % 4) {
-  case 0:
-    ret.push_back(c << 2);
-    break;
-  case 1:
-    ret.back() |= c >> 4;
-    ret.push_back(c << 4);
-    break;
-  case 2:
-    ret.back() |= c >> 2;
-    ret.push_back(c << 6);
-    break;
-  case 3:
-    ret.back() |= c;
-    break;
+// Tables for the block decoder: entry [i][c] is the 6-bit value of character c shifted into the
+// position of the i-th character of a four character block, or INVALID_BITS if c is not part of
+// the alphabet. OR-ing the four lookups of a block yields its three bytes in the low 24 bits and
+// tells whether any of the characters was invalid, without a branch per character.
+using DecodeTable = std::array<std::array<uint32_t, 256>, 4>;
+constexpr uint32_t INVALID_BITS = 1 << 24;
+
+constexpr DecodeTable makeDecodeTable(const unsigned char* reverse_lookup_table) {
+  DecodeTable table{};
+  for (size_t c = 0; c < 256; ++c) {
+    const uint32_t value = reverse_lookup_table[c];
+    for (size_t i = 0; i < 4; ++i) {
+      table[i][c] = value == 64 ? INVALID_BITS : value << (18 - 6 * i);
+    }
   }
-  return true;
+  return table;
 }
 
-inline bool decodeLast(const uint8_t cur_char, uint64_t pos, std::string& ret,
-                       const unsigned char* const reverse_lookup_table) {
-  const unsigned char c = reverse_lookup_table[static_cast<uint32_t>(cur_char)];
-  if (c == 64) {
-    // Invalid character
-    return false;
-  }
-
-  switch (pos % 4) {
-  case 0:
-    return false;
-  case 1:
-    ret.back() |= c >> 4;
-    return (c & 0b1111) == 0;
-  case 2:
-    ret.back() |= c >> 2;
-    return (c & 0b11) == 0;
-  case 3:
-    ret.back() |= c;
-    break;
+constexpr DecodeTable DECODE_TABLE = makeDecodeTable(REVERSE_LOOKUP_TABLE);
+constexpr DecodeTable URL_DECODE_TABLE = makeDecodeTable(URL_REVERSE_LOOKUP_TABLE);
+
+/**
+ * Decode whole blocks of four characters.
+ * @param input the characters to decode. Its size must be a multiple of 4.
+ * @param output receives the decoded bytes, 3 per block.
+ * @return false if any of the characters is invalid, in which case output has unspecified
+ *         content.
+ */
+bool decodeBlocks(const uint8_t* input, uint64_t size, uint8_t* output, const DecodeTable& table) {
+  ASSERT(size % 4 == 0);
+  uint32_t invalid = 0;
+  for (; size > 0; size -= 4, input += 4, output += 3) {
+    const uint32_t bits = table[0][input[0]] | table[1][input[1]] | table[2][input[2]] |
+                          table[3][input[3]];
+    invalid |= bits;
+    output[0] = bits >> 16;
+    output[1] = bits >> 8;
+    output[2] = bits;
   }
-  return true;
+  return invalid < INVALID_BITS;
 }
 
-inline void encodeBase(const uint8_t cur_char, uint64_t pos, uint8_t& next_c, std::string& ret,
-                       const char* const char_table) {
-  switch (pos % 3) {
+/**
+ * Decode the trailing partial block of an unpadded input.
+ * @param input the characters to decode.
+ * @param size the number of characters, 0 to 3.
+ * @param output receives the size - 1 decoded bytes.
+ * @return false if the block is invalid: it has a single character, an invalid character, or
+ *         non-zero bits which do not fit in the decoded bytes.
+ */
+bool decodeTail(const uint8_t* input, uint64_t size, uint8_t* output, const DecodeTable& table) {
+  switch (size) {
   case 0:
-    ret.push_back(char_table[cur_char >> 2]);
-    next_c = (cur_char & 0x03) << 4;
-    break;
-  case 1:
-    ret.push_back(char_table[next_c | (cur_char >> 4)]);
-    next_c = (cur_char & 0x0f) << 2;
-    break;
-  case 2:
-    ret.push_back(char_table[next_c | (cur_char >> 6)]);
-    ret.push_back(char_table[cur_char & 0x3f]);
-    next_c = 0;
-    break;
+    return true;
+  case 2: {
+    const uint32_t bits = table[0][input[0]] | table[1][input[1]];
+    output[0] = bits >> 16;
+    return (bits & ~0xff0000) == 0;
+  }
+  case 3: {
+    const uint32_t bits = table[0][input[0]] | table[1][input[1]] | table[2][input[2]];
+    output[0] = bits >> 16;
+    output[1] = bits >> 8;
+    return (bits & ~0xffff00) == 0;
   }
-}
-
-inline void encodeLast(uint64_t pos, uint8_t last_char, std::string& ret,
-                       const char* const char_table, bool add_padding) {
-  switch (pos % 3) {
-  case 1:
-    ret.push_back(char_table[last_char]);
-    if (add_padding) {
-      ret.push_back('=');
-      ret.push_back('=');
-    }
-    break;
-  case 2:
-    ret.push_back(char_table[last_char]);
-    if (add_padding) {
-      ret.push_back('=');
-    }
-    break;
   default:
-    break;
+    return false;
   }
 }
 
-} // namespace
-
-std::string Base64::decode(absl::string_view input) {
-  if (input.length() % 4) {
+/**
+ * Decode an input without padding.
+ * @return the decoded bytes, or an empty string if the input is invalid.
+ */
+std::string decodeUnpadded(absl::string_view input, const DecodeTable& table) {
+  const uint64_t tail = input.size() % 4;
+  const uint64_t blocks_size = input.size() - tail;
+  std::string ret(blocks_size / 4 * 3 + (tail > 0 ? tail - 1 : 0), '\0');
+
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(input.data());
+  uint8_t* out = reinterpret_cast<uint8_t*>(ret.data());
+  if (!decodeBlocks(in, blocks_size, out, table) ||
+      !decodeTail(in + blocks_size, tail, out + blocks_size / 4 * 3, table)) {
     return EMPTY_STRING;
   }
-  return decodeWithoutPadding(input);
+  return ret;
 }
 
-std::string Base64::decodeWithoutPadding(absl::string_view input) {
-  if (input.empty()) {
-    return EMPTY_STRING;
-  }
-
-  // At most last two chars can be '='.
-  size_t n = input.length();
-  if (input[n - 1] == '=') {
+/**
+ * @return the length of the input, without its padding characters. At most two '='
+ *         characters are padding.
+ */
+uint64_t unpaddedLength(absl::string_view input) {
+  uint64_t n = input.size();
+  if (n > 0 && input[n - 1] == '=') {
     n--;
     if (n > 0 && input[n - 1] == '=') {
       n--;
     }
   }
-  // Last position before "valid" padding character.
-  uint64_t last = n - 1;
-  // Determine output length.
-  size_t max_length = (n + 3) / 4 * 3;
-  if (n % 4 == 3) {
-    max_length -= 1;
-  }
-  if (n % 4 == 2) {
-    max_length -= 2;
-  }
+  return n;
+}
 
-  std::string ret;
-  ret.reserve(max_length);
-  for (uint64_t i = 0; i < last; ++i) {
-    if (!decodeBase(input[i], i, ret, REVERSE_LOOKUP_TABLE)) {
-      return EMPTY_STRING;
+/**
+ * Decode whole blocks of four characters, any of which may be padded, as in the concatenation of
+ * separately encoded inputs.
+ * @param output receives the decoded bytes.
+ * @return the end of the output, or nullptr if the input is invalid.
+ */
+uint8_t* decodePaddedBlocks(const uint8_t* input, uint64_t size, uint8_t* output) {
+  // Padding is rare, so all the blocks are first decoded as if they were not padded.
+  if (decodeBlocks(input, size, output, DECODE_TABLE)) {
+    return output + size / 4 * 3;
+  }
+  for (; size > 0; size -= 4, input += 4) {
+    const uint64_t length =
+        unpaddedLength(absl::string_view(reinterpret_cast<const char*>(input), 4));
+    if (length == 4) {
+      if (!decodeBlocks(input, 4, output, DECODE_TABLE)) {
+        return nullptr;
+      }
+      output += 3;
+    } else {
+      if (!decodeTail(input, length, output, DECODE_TABLE)) {
+        return nullptr;
+      }
+      output += length - 1;
     }
   }
+  return output;
+}
 
-  if (!decodeLast(input[last], last, ret, REVERSE_LOOKUP_TABLE)) {
-    return EMPTY_STRING;
+/**
+ * Encode whole blocks of three bytes.
+ * @param input the bytes to encode. Its size must be a multiple of 3.
+ * @param output receives the encoded characters, 4 per block.
+ * @return the end of the output.
+ */
+char* encodeBlocks(const uint8_t* input, uint64_t size, char* output, const char* char_table) {
+  ASSERT(size % 3 == 0);
+  for (; size > 0; size -= 3, input += 3, output += 4) {
+    const uint32_t bits = (input[0] << 16) | (input[1] << 8) | input[2];
+    output[0] = char_table[bits >> 18];
+    output[1] = char_table[(bits >> 12) & 0x3f];
+    output[2] = char_table[(bits >> 6) & 0x3f];
+    output[3] = char_table[bits & 0x3f];
   }
+  return output;
+}
 
-  ASSERT(ret.size() == max_length);
-  return ret;
+/**
+ * Encode the trailing bytes of an input which do not make a whole block.
+ * @param input the bytes to encode.
+ * @param size the number of bytes, 0 to 2.
+ * @param output receives the encoded characters.
+ * @return the end of the output.
+ */
+char* encodeTail(const uint8_t* input, uint64_t size, char* output, const char* char_table,
+                 bool add_padding) {
+  if (size == 0) {
+    return output;
+  }
+  const uint32_t bits = (input[0] << 16) | (size == 2 ? input[1] << 8 : 0);
+  *output++ = char_table[bits >> 18];
+  *output++ = char_table[(bits >> 12) & 0x3f];
+  if (size == 2) {
+    *output++ = char_table[(bits >> 6) & 0x3f];
+  }
+  if (add_padding) {
+    for (uint64_t i = size; i < 3; ++i) {
+      *output++ = '=';
+    }
+  }
+  return output;
 }
 
-std::string Base64::encode(const Buffer::Instance& buffer, uint64_t length) {
-  uint64_t output_length = (std::min(length, buffer.length()) + 2) / 3 * 4;
-  std::string ret;
-  ret.reserve(output_length);
+uint64_t encodedLength(uint64_t length, bool add_padding) {
+  if (add_padding) {
+    return (length + 2) / 3 * 4;
+  }
+  return length / 3 * 4 + (length % 3 > 0 ? length % 3 + 1 : 0);
+}
 
-  uint64_t j = 0;
-  uint8_t next_c = 0;
+/**
+ * Invoke process(data, size) on the first `length` bytes of the slices of `buffer`, where each
+ * size is a multiple of BlockSize, so that whole blocks are processed in place. Blocks which
+ * straddle slices are gathered into `tail` first.
+ * @param pending the number of bytes already in `tail`, which come before the buffer.
+ * @return the number of bytes at the end which do not make a whole block, which are left in
+ *         `tail`.
+ */
+template <uint64_t BlockSize, class Process>
+uint64_t forEachBlock(const Buffer::Instance& buffer, uint64_t length, uint8_t (&tail)[BlockSize],
+                      uint64_t pending, Process process) {
+  ASSERT(pending < BlockSize);
   for (const Buffer::RawSlice& slice : buffer.getRawSlices()) {
-    const uint8_t* slice_mem = static_cast<const uint8_t*>(slice.mem_);
-
-    for (uint64_t i = 0; i < slice.len_ && j < length; ++i, ++j) {
-      encodeBase(slice_mem[i], j, next_c, ret, CHAR_TABLE);
+    if (length == 0) {
+      break;
+    }
+    const uint8_t* data = static_cast<const uint8_t*>(slice.mem_);
+    uint64_t size = std::min<uint64_t>(slice.len_, length);
+    length -= size;
+
+    if (pending > 0) {
+      const uint64_t count = std::min(BlockSize - pending, size);
+      memcpy(tail + pending, data, count);
+      pending += count;
+      data += count;
+      size -= count;
+      if (pending < BlockSize) {
+        continue;
+      }
+      process(tail, BlockSize);
     }
 
-    if (j == length) {
-      break;
+    const uint64_t blocks_size = size - size % BlockSize;
+    if (blocks_size > 0) {
+      process(data, blocks_size);
+    }
+    pending = size - blocks_size;
+    if (pending > 0) {
+      memcpy(tail, data + blocks_size, pending);
     }
   }
+  return pending;
+}
+
+} // namespace
+
+std::string Base64::decode(absl::string_view input) {
+  if (input.length() % 4) {
+    return EMPTY_STRING;
+  }
+  return decodeWithoutPadding(input);
+}
 
-  encodeLast(j, next_c, ret, CHAR_TABLE, true);
+std::string Base64::decodeWithoutPadding(absl::string_view input) {
+  return decodeUnpadded(input.substr(0, unpaddedLength(input)), DECODE_TABLE);
+}
 
+std::string Base64::encode(const Buffer::Instance& buffer, uint64_t length) {
+  length = std::min(length, buffer.length());
+  std::string ret(encodedLength(length, true), '\0');
+  char* out = ret.data();
+
+  uint8_t tail[3];
+  const uint64_t pending =
+      forEachBlock(buffer, length, tail, 0, [&out](const uint8_t* data, uint64_t size) {
+        out = encodeBlocks(data, size, out, CHAR_TABLE);
+      });
+  out = encodeTail(tail, pending, out, CHAR_TABLE, true);
+  ASSERT(out == ret.data() + ret.size());
   return ret;
 }
 
@@ -219,19 +312,12 @@ std::string Base64::encode(const char* input, uint64_t length) {
 }
 
 std::string Base64::encode(const char* input, uint64_t length, bool add_padding) {
-  uint64_t output_length = (length + 2) / 3 * 4;
-  std::string ret;
-  ret.reserve(output_length);
-
-  uint64_t pos = 0;
-  uint8_t next_c = 0;
-
-  for (uint64_t i = 0; i < length; ++i) {
-    encodeBase(input[i], pos++, next_c, ret, CHAR_TABLE);
-  }
-
-  encodeLast(pos, next_c, ret, CHAR_TABLE, add_padding);
-
+  std::string ret(encodedLength(length, add_padding), '\0');
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+  const uint64_t blocks_size = length - length % 3;
+  char* out = encodeBlocks(in, blocks_size, ret.data(), CHAR_TABLE);
+  out = encodeTail(in + blocks_size, length - blocks_size, out, CHAR_TABLE, add_padding);
+  ASSERT(out == ret.data() + ret.size());
   return ret;
 }
 
@@ -243,42 +329,79 @@ void Base64::completePadding(std::string& encoded) {
 }
 
 std::string Base64Url::decode(absl::string_view input) {
-  if (input.empty()) {
-    return EMPTY_STRING;
-  }
-
-  std::string ret;
-  ret.reserve(input.length() / 4 * 3 + 3);
-
-  uint64_t last = input.length() - 1;
-  for (uint64_t i = 0; i < last; ++i) {
-    if (!decodeBase(input[i], i, ret, URL_REVERSE_LOOKUP_TABLE)) {
-      return EMPTY_STRING;
-    }
-  }
-
-  if (!decodeLast(input[last], last, ret, URL_REVERSE_LOOKUP_TABLE)) {
-    return EMPTY_STRING;
-  }
+  return decodeUnpadded(input, URL_DECODE_TABLE);
+}
 
+std::string Base64Url::encode(const char* input, uint64_t length) {
+  std::string ret(encodedLength(length, false), '\0');
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(input);
+  const uint64_t blocks_size = length - length % 3;
+  char* out = encodeBlocks(in, blocks_size, ret.data(), URL_CHAR_TABLE);
+  out = encodeTail(in + blocks_size, length - blocks_size, out, URL_CHAR_TABLE, false);
+  ASSERT(out == ret.data() + ret.size());
   return ret;
 }
 
-std::string Base64Url::encode(const char* input, uint64_t length) {
-  uint64_t output_length = (length + 2) / 3 * 4;
-  std::string ret;
-  ret.reserve(output_length);
+void Base64StreamEncoder::encode(Buffer::Instance& input, uint64_t length,
+                                 Buffer::Instance& output) {
+  length = std::min(length, input.length());
+  const uint64_t output_length = (pending_size_ + length) / 3 * 4;
+  if (output_length == 0) {
+    // Not enough data for a whole block.
+    input.copyOut(0, length, pending_ + pending_size_);
+    pending_size_ += length;
+    input.drain(length);
+    return;
+  }
 
-  uint64_t pos = 0;
-  uint8_t next_c = 0;
+  Buffer::ReservationSingleSlice reservation = output.reserveSingleSlice(output_length);
+  char* const start = static_cast<char*>(reservation.slice().mem_);
+  char* out = start;
+  pending_size_ = forEachBlock(input, length, pending_, pending_size_,
+                               [&out](const uint8_t* data, uint64_t size) {
+                                 out = encodeBlocks(data, size, out, CHAR_TABLE);
+                               });
+  ASSERT(static_cast<uint64_t>(out - start) == output_length);
+  reservation.commit(output_length);
+  input.drain(length);
+}
 
-  for (uint64_t i = 0; i < length; ++i) {
-    encodeBase(input[i], pos++, next_c, ret, URL_CHAR_TABLE);
+void Base64StreamEncoder::finish(Buffer::Instance& output) {
+  if (pending_size_ == 0) {
+    return;
   }
+  char encoded[4];
+  const char* end = encodeTail(pending_, pending_size_, encoded, CHAR_TABLE, true);
+  output.add(encoded, end - encoded);
+  pending_size_ = 0;
+}
 
-  encodeLast(pos, next_c, ret, URL_CHAR_TABLE, false);
+bool Base64StreamDecoder::decode(Buffer::Instance& input, Buffer::Instance& output) {
+  const uint64_t length = input.length();
+  const uint64_t max_output_length = (pending_size_ + length) / 4 * 3;
+  if (max_output_length == 0) {
+    // Not enough data for a whole block.
+    input.copyOut(0, length, pending_ + pending_size_);
+    pending_size_ += length;
+    input.drain(length);
+    return true;
+  }
 
-  return ret;
+  Buffer::ReservationSingleSlice reservation = output.reserveSingleSlice(max_output_length);
+  uint8_t* const start = static_cast<uint8_t*>(reservation.slice().mem_);
+  uint8_t* out = start;
+  pending_size_ = forEachBlock(input, length, pending_, pending_size_,
+                               [&out](const uint8_t* data, uint64_t size) {
+                                 if (out != nullptr) {
+                                   out = decodePaddedBlocks(data, size, out);
+                                 }
+                               });
+  input.drain(length);
+  if (out == nullptr) {
+    return false;
+  }
+  reservation.commit(out - start);
+  return true;
 }
 
 } // namespace Envoy
@@ -85,4 +85,58 @@ public:
   static std::string decode(absl::string_view input);
 };
 
+/**
+ * Incrementally base64 encodes a stream of data which arrives in several buffers, directly from
+ * the slices of the input into the output. The bytes at the end of the input which do not make a
+ * whole block of 3 bytes are kept until more data arrives.
+ */
+class Base64StreamEncoder {
+public:
+  /**
+   * Encode and drain the front of the input, appending the encoding of whole blocks to the output.
+   * @param input supplies the data to encode.
+   * @param length supplies the length to encode which may be <= the input length.
+   * @param output supplies the buffer the encoded data is appended to.
+   */
+  void encode(Buffer::Instance& input, uint64_t length, Buffer::Instance& output);
+
+  /**
+   * Encode the bytes kept from the previous input, with padding, so that the output is the
+   * complete encoding of the input so far. The encoder can then be reused for another input.
+   * @param output supplies the buffer the encoded data is appended to.
+   */
+  void finish(Buffer::Instance& output);
+
+private:
+  uint8_t pending_[3];
+  uint64_t pending_size_{0};
+};
+
+/**
+ * Incrementally base64 decodes a stream of data which arrives in several buffers, directly from
+ * the slices of the input into the output. The characters at the end of the input which do not make
+ * a whole block of 4 characters are kept until more data arrives. Any block may be padded, as in
+ * the concatenation of separately encoded inputs.
+ */
+class Base64StreamDecoder {
+public:
+  /**
+   * Decode and drain the input, appending the decoding of whole blocks to the output.
+   * @param input supplies the data to decode.
+   * @param output supplies the buffer the decoded data is appended to.
+   * @return false if the input is invalid, in which case the decoder must not be used anymore.
+   */
+  bool decode(Buffer::Instance& input, Buffer::Instance& output);
+
+  /**
+   * @return the number of characters kept from the previous input, which do not make a whole
+   *         block. The input is complete only if this is 0.
+   */
+  uint64_t pendingSize() const { return pending_size_; }
+
+private:
+  uint8_t pending_[4];
+  uint64_t pending_size_{0};
+};
+
 } // namespace Envoy
@@ -415,17 +415,13 @@ public:
   }
 
   /**
-   * Create an inline map with the given descriptor. If the descriptor is not finalized, it will be
-   * finalized before creating the inline map.
+   * Create an inline map with the given descriptor. The descriptor must be finalized first. It is
+   * not finalized here as maps may be created on any thread while finalize() is not thread safe.
    * @param descriptor the descriptor that contains the inline keys.
    * @return the created inline map.
    */
   static std::unique_ptr<InlineMap> create(TypedInlineMapDescriptor& descriptor) {
-    if (!descriptor.finalized()) {
-      // Call finalize() to make sure that the descriptor is finalized and no any new inline
-      // keys could be registered.
-      descriptor.finalize();
-    }
+    ASSERT(descriptor.finalized(), "Cannot create inline map before finalize()");
 
     return std::unique_ptr<InlineMap>(new ((descriptor.inlineKeysNum() * sizeof(Value)))
                                           InlineMap(descriptor));
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 #include "source/common/common/macros.h"
@@ -24,7 +25,11 @@ public:
   static std::string escapeString(absl::string_view input, uint64_t required_size) {
     // Create a result string of necessary size.
     std::string result(input.size() + required_size, '\\');
-    uint64_t position = 0;
+
+    // Copy the prefix without special characters as-is.
+    uint64_t position = escapeFreePrefixLength(input, false);
+    input.copy(result.data(), position);
+    input.remove_prefix(position);
 
     for (const auto& character : input) {
       switch (character) {
@@ -86,6 +91,7 @@ public:
   // @return uint64_t the number of extra characters required to to build a JSON escaped string.
   static uint64_t extraSpace(absl::string_view input) {
     uint64_t result = 0;
+    input.remove_prefix(escapeFreePrefixLength(input, false));
     for (const auto& character : input) {
       switch (character) {
       case '"':
@@ -117,5 +123,61 @@ public:
     }
     return result;
   }
+
+  // Scan a string for the special characters, 32 characters at a time with bitwise operations on
+  // 8-byte words, so that strings which need no escaping are not inspected character by character.
+  // @param input input string.
+  // @param non_ascii whether characters above 0x7e are also special, as they are for the JSON
+  //        sanitizer which must validate their UTF-8 encoding.
+  // @return uint64_t the length of a prefix of the input without special characters. The
+  //         characters which follow it are within a block of 8 characters containing at least one
+  //         special character, or are the last characters of the string.
+  static uint64_t escapeFreePrefixLength(absl::string_view input, bool non_ascii) {
+    constexpr uint64_t BlockSize = 4 * sizeof(uint64_t);
+    const char* data = input.data();
+    uint64_t position = 0;
+    for (; position + BlockSize <= input.size(); position += BlockSize) {
+      uint64_t words[4];
+      memcpy(words, data + position, BlockSize); // NOLINT(safe-memcpy)
+      if (wordsHaveSpecialCharacter(words[0], words[1], words[2], words[3], non_ascii)) {
+        break;
+      }
+    }
+    for (; position + sizeof(uint64_t) <= input.size(); position += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, data + position, sizeof(word)); // NOLINT(safe-memcpy)
+      if (hasSpecialCharacter(word, non_ascii)) {
+        break;
+      }
+    }
+    return position;
+  }
+
+private:
+  static constexpr uint64_t broadcast(uint8_t byte) { return 0x0101010101010101ULL * byte; }
+
+  // @return whether a byte of word is zero.
+  static constexpr bool hasZeroByte(uint64_t word) {
+    return ((word - broadcast(0x01)) & ~word & broadcast(0x80)) != 0;
+  }
+
+  // @return whether a byte of word is a special character.
+  static constexpr bool hasSpecialCharacter(uint64_t word, bool non_ascii) {
+    // A byte below 0x20 has its high bit set once 0x20 is subtracted from it, unlike bytes with
+    // their high bit already set.
+    const bool control = ((word - broadcast(0x20)) & ~word & broadcast(0x80)) != 0;
+    // A byte above 0x7e has its high bit set once 0x01 is added to its low 7 bits, or already.
+    const bool above_ascii =
+        non_ascii && ((((word & broadcast(0x7f)) + broadcast(0x01)) | word) & broadcast(0x80)) != 0;
+    return control || above_ascii || hasZeroByte(word ^ broadcast('"')) ||
+           hasZeroByte(word ^ broadcast('\\'));
+  }
+
+  static constexpr bool wordsHaveSpecialCharacter(uint64_t word0, uint64_t word1, uint64_t word2,
+                                                  uint64_t word3, bool non_ascii) {
+    // Non-short-circuiting, so that the words are checked without branches.
+    return hasSpecialCharacter(word0, non_ascii) | hasSpecialCharacter(word1, non_ascii) |
+           hasSpecialCharacter(word2, non_ascii) | hasSpecialCharacter(word3, non_ascii);
+  }
 };
 } // namespace Envoy
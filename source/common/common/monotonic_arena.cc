@@ -0,0 +1,48 @@
+#include "source/common/common/monotonic_arena.h"
+
+#include <algorithm>
+#include <new>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+
+MonotonicArena::~MonotonicArena() {
+  while (last_block_ != nullptr) {
+    Block* previous = last_block_->previous_;
+    ::operator delete(last_block_);
+    last_block_ = previous;
+  }
+}
+
+void* MonotonicArena::allocate(size_t size, size_t alignment) {
+  ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0 &&
+         alignment <= alignof(std::max_align_t));
+  ++allocations_;
+  // Allocations of zero bytes still get distinct addresses.
+  size = std::max<size_t>(size, 1);
+  uintptr_t address = (reinterpret_cast<uintptr_t>(current_) + alignment - 1) & ~(alignment - 1);
+  if (current_ == nullptr || address + size > reinterpret_cast<uintptr_t>(end_)) {
+    newBlock(size, alignment);
+    address = (reinterpret_cast<uintptr_t>(current_) + alignment - 1) & ~(alignment - 1);
+  }
+  current_ = reinterpret_cast<char*>(address + size);
+  return reinterpret_cast<void*>(address);
+}
+
+void MonotonicArena::newBlock(size_t size, size_t alignment) {
+  const size_t block_size = std::max(next_block_size_, sizeof(Block) + alignment + size);
+  next_block_size_ = std::min(next_block_size_ * 2, MaxBlockSize);
+
+  // The block has room for the header and the allocation at any alignment up to the requested one.
+  char* memory = static_cast<char*>(::operator new(block_size));
+  Block* block = reinterpret_cast<Block*>(memory);
+  block->previous_ = last_block_;
+  last_block_ = block;
+  ++blocks_;
+
+  current_ = memory + sizeof(Block);
+  end_ = memory + block_size;
+}
+
+} // namespace Envoy
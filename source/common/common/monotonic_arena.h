@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "envoy/common/optref.h"
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+
+/**
+ * A monotonic allocator for objects which share a lifetime, such as the filter chain of an HTTP
+ * stream. Memory is carved out of blocks which are only released when the arena is destroyed, so
+ * that an allocation is a pointer bump and a deallocation is a no-op. The blocks grow geometrically
+ * from the initial block size, so a short-lived owner with few objects allocates a single block.
+ *
+ * The objects allocated from the arena must be destroyed before it. The arena is not thread safe.
+ */
+class MonotonicArena : NonCopyable {
+public:
+  explicit MonotonicArena(size_t initial_block_size = DefaultInitialBlockSize)
+      : next_block_size_(initial_block_size) {}
+  ~MonotonicArena();
+
+  /**
+   * @param size supplies the number of bytes to allocate.
+   * @param alignment supplies the alignment of the allocation, which must be a power of two no
+   *        larger than alignof(std::max_align_t).
+   * @return the allocated memory, which is valid until the arena is destroyed.
+   */
+  void* allocate(size_t size, size_t alignment);
+
+  /**
+   * @return the number of blocks allocated from the heap.
+   */
+  uint64_t blocks() const { return blocks_; }
+
+  /**
+   * @return the number of allocations served by the arena.
+   */
+  uint64_t allocations() const { return allocations_; }
+
+  static constexpr size_t DefaultInitialBlockSize = 1024;
+  static constexpr size_t MaxBlockSize = 16 * 1024;
+
+private:
+  struct Block {
+    Block* previous_;
+  };
+
+  void newBlock(size_t size, size_t alignment);
+
+  Block* last_block_{};
+  char* current_{};
+  char* end_{};
+  size_t next_block_size_;
+  uint64_t blocks_{};
+  uint64_t allocations_{};
+};
+
+/**
+ * An allocator for standard containers and std::allocate_shared() which allocates from a
+ * MonotonicArena.
+ */
+template <class T> class ArenaAllocator {
+public:
+  using value_type = T; // NOLINT(readability-identifier-naming)
+
+  explicit ArenaAllocator(MonotonicArena& arena) : arena_(&arena) {}
+  template <class U> ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena_) {}
+
+  T* allocate(size_t n) { return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T))); }
+  void deallocate(T*, size_t) {}
+
+  template <class U> bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+
+private:
+  template <class U> friend class ArenaAllocator;
+
+  MonotonicArena* arena_;
+};
+
+/**
+ * Mixin for classes whose objects are always created in a MonotonicArena, with
+ * `new (arena) T(...)`. The objects may be owned by a std::unique_ptr as usual: deleting them runs
+ * their destructor, while their memory is released with the arena.
+ */
+class ArenaAllocated {
+public:
+  static void* operator new(size_t size, MonotonicArena& arena) {
+    return arena.allocate(size, alignof(std::max_align_t));
+  }
+  static void operator delete(void*, MonotonicArena&) {}
+  static void operator delete(void*) {}
+};
+
+/**
+ * @return a shared object allocated from the arena if there is one, or from the heap otherwise.
+ * The object must not be referenced after the arena is destroyed.
+ */
+template <class T, class... Args>
+std::shared_ptr<T> makeSharedInArena(OptRef<MonotonicArena> arena, Args&&... args) {
+  if (!arena.has_value()) {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+  return std::allocate_shared<T>(ArenaAllocator<T>(*arena), std::forward<Args>(args)...);
+}
+
+} // namespace Envoy
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "source/common/common/assert.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+
+/**
+ * A radix tree (a trie where chains of single-child nodes are merged into one node) used for
+ * lookups of exact keys and of the longest matching prefix of a key. It has the same interface as
+ * TrieLookupTable, but is much more compact when there are many long keys which share prefixes,
+ * e.g. URL paths: a node only exists where keys diverge or end, rather than for every byte.
+ *
+ * Type of Value must be empty-constructible and moveable, e.g. smart pointers and POD types.
+ */
+template <class Value> class RadixTree {
+  static constexpr int32_t NoNode = -1;
+
+  // A branch from a node to a child, keyed by the first byte of the label of the child.
+  struct Edge {
+    uint8_t key_;
+    int32_t node_;
+  };
+
+  // Similarly to CompiledStringMap and TrieLookupTable, the nodes are stored in a flat vector and
+  // refer to each other by index, which keeps them localized and prevents recursive deletion
+  // which can provoke a stack overflow. The labels of all the nodes are stored in a single string,
+  // so that a node costs no allocation besides its edges; splitting a label (when a key diverges
+  // in the middle of it) only moves the offsets of the nodes.
+  struct RadixTreeNode {
+    Value value_{};
+    // The bytes of the key between the parent node and this node, as a range of labels_.
+    uint32_t label_offset_{0};
+    uint32_t label_size_{0};
+    // Sorted by key.
+    std::vector<Edge> edges_;
+  };
+
+  absl::string_view label(const RadixTreeNode& node) const {
+    return {labels_.data() + node.label_offset_, node.label_size_};
+  }
+
+  /**
+   * Get the index of the child of `node` whose label starts with `char_key`.
+   * @param node the node to follow a branch from.
+   * @param char_key the first byte of the label of the child.
+   */
+  static int32_t getChildIndex(const RadixTreeNode& node, uint8_t char_key) {
+    const auto it = std::lower_bound(node.edges_.begin(), node.edges_.end(), char_key,
+                                     [](const Edge& edge, uint8_t key) { return edge.key_ < key; });
+    if (it == node.edges_.end() || it->key_ != char_key) {
+      return NoNode;
+    }
+    return it->node_;
+  }
+
+  /**
+   * Make the branch whose key is `char_key`, of the node indexed by `current`
+   * point to node indexed by `child_index`.
+   * @param current the index of the node whose child is to be updated.
+   * @param char_key the one-byte key of the branch to be updated.
+   * @param child_index the index of the node the branch will lead to.
+   */
+  void setChildIndex(int32_t current, uint8_t char_key, int32_t child_index) {
+    ASSERT(current >= 0 && static_cast<size_t>(current) < nodes_.size());
+    ASSERT(child_index >= 0 && static_cast<size_t>(child_index) < nodes_.size());
+    std::vector<Edge>& edges = nodes_[current].edges_;
+    const auto it = std::lower_bound(edges.begin(), edges.end(), char_key,
+                                     [](const Edge& edge, uint8_t key) { return edge.key_ < key; });
+    if (it != edges.end() && it->key_ == char_key) {
+      it->node_ = child_index;
+      return;
+    }
+    edges.insert(it, Edge{char_key, child_index});
+  }
+
+  /**
+   * Add a node at the end of nodes_.
+   * @return the index of the new node.
+   */
+  int32_t addNode(uint32_t label_offset, uint32_t label_size) {
+    const int32_t index = nodes_.size();
+    nodes_.emplace_back();
+    nodes_.back().label_offset_ = label_offset;
+    nodes_.back().label_size_ = label_size;
+    return index;
+  }
+
+public:
+  /**
+   * Adds an entry to the tree at the given Key.
+   * @param key the key used to add the entry.
+   * @param value the value to be associated with the key.
+   * @param overwrite_existing will overwrite the value when the value for a given key already
+   * exists.
+   * @return false when a value already exists for the given key.
+   */
+  bool add(absl::string_view key, Value value, bool overwrite_existing = true) {
+    int32_t current = 0;
+    while (!key.empty()) {
+      const int32_t next = getChildIndex(nodes_[current], key[0]);
+      if (next == NoNode) {
+        // No other key continues with the rest of this one: it all goes in the label of a leaf.
+        const int32_t leaf = addNode(labels_.size(), key.size());
+        labels_.append(key.data(), key.size());
+        setChildIndex(current, key[0], leaf);
+        current = leaf;
+        break;
+      }
+      const absl::string_view next_label = label(nodes_[next]);
+      const size_t common =
+          std::mismatch(next_label.begin(), next_label.end(), key.begin(), key.end()).first -
+          next_label.begin();
+      if (common < next_label.size()) {
+        // The key diverges from, or ends within, the label of the child. Split the label with a
+        // node for the common part, whose child is the rest of the label.
+        const int32_t split = addNode(nodes_[next].label_offset_, common);
+        nodes_[next].label_offset_ += common;
+        nodes_[next].label_size_ -= common;
+        setChildIndex(split, labels_[nodes_[next].label_offset_], next);
+        setChildIndex(current, key[0], split);
+        current = split;
+      } else {
+        current = next;
+      }
+      key.remove_prefix(common);
+    }
+    if (nodes_[current].value_ && !overwrite_existing) {
+      return false;
+    }
+    nodes_[current].value_ = std::move(value);
+    return true;
+  }
+
+  /**
+   * Finds the entry associated with the key.
+   * @param key the key used to find.
+   * @return the Value associated with the key, or an empty-initialized Value
+   *         if there is no matching key.
+   */
+  Value find(absl::string_view key) const {
+    int32_t current = 0;
+    while (!key.empty()) {
+      current = getChildIndex(nodes_[current], key[0]);
+      if (current == NoNode) {
+        return {};
+      }
+      const absl::string_view current_label = label(nodes_[current]);
+      if (!absl::StartsWith(key, current_label)) {
+        return {};
+      }
+      key.remove_prefix(current_label.size());
+    }
+    return nodes_[current].value_;
+  }
+
+  /**
+   * Finds the entry with the longest key that is a prefix of the specified key.
+   * Complexity is O(min(longest key prefix, key length)).
+   * @param key the key used to find.
+   * @return a value whose key is a prefix of the specified key. If there are
+   *         multiple such values, the one with the longest key. If there are
+   *         no keys that are a prefix of the input key, an empty-initialized Value.
+   */
+  Value findLongestPrefix(absl::string_view key) const {
+    int32_t current = 0;
+    int32_t result = 0;
+
+    while (!key.empty()) {
+      current = getChildIndex(nodes_[current], key[0]);
+      if (current == NoNode) {
+        break;
+      }
+      const absl::string_view current_label = label(nodes_[current]);
+      if (!absl::StartsWith(key, current_label)) {
+        break;
+      }
+      if (nodes_[current].value_) {
+        result = current;
+      }
+      key.remove_prefix(current_label.size());
+    }
+    return nodes_[result].value_;
+  }
+
+  /**
+   * @return the number of nodes of the tree, including the root. Used for testing.
+   */
+  size_t nodeCount() const { return nodes_.size(); }
+
+private:
+  // Flat representation of the tree - each node has a vector of edges to its child nodes.
+  // Initialized with a single empty node as the root node.
+  std::vector<RadixTreeNode> nodes_ = {RadixTreeNode()};
+  // The labels of all the nodes.
+  std::string labels_;
+};
+
+} // namespace Envoy
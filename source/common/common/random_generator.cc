@@ -1,5 +1,9 @@
 #include "source/common/common/random_generator.h"
 
+#include <array>
+#include <bit>
+#include <cstring>
+
 #include "source/common/common/assert.h"
 
 #include "openssl/rand.h"
@@ -9,6 +13,60 @@ namespace Random {
 
 constexpr size_t CONSTEXPR_UUID_LENGTH = 36;
 const size_t RandomGeneratorImpl::UUID_LENGTH = CONSTEXPR_UUID_LENGTH;
+static_assert(std::tuple_size_v<RandomGenerator::UuidBuffer> == CONSTEXPR_UUID_LENGTH);
+
+namespace {
+
+// The two lowercase hex digits of each byte value.
+constexpr std::array<std::array<char, 2>, 256> HexPairs = [] {
+  constexpr const char* hex = "0123456789abcdef";
+  std::array<std::array<char, 2>, 256> pairs{};
+  for (size_t i = 0; i < pairs.size(); i++) {
+    pairs[i] = {hex[i >> 4], hex[i & 0x0f]};
+  }
+  return pairs;
+}();
+
+// The offsets in a UUID string of the digits of each of its 16 bytes.
+constexpr std::array<uint8_t, 16> UuidHexOffsets = {0,  2,  4,  6,  9,  11, 14, 16,
+                                                    19, 21, 24, 26, 28, 30, 32, 34};
+
+// xoshiro256** (https://prng.di.unimi.it/), a small and fast generator of good statistical quality
+// which is not cryptographically secure. Each thread has its own generator, seeded by
+// RandomUtility::random(), so that no locking is needed.
+class Xoshiro256StarStar {
+public:
+  static Xoshiro256StarStar& get() {
+    static thread_local Xoshiro256StarStar generator;
+    return generator;
+  }
+
+  Xoshiro256StarStar() {
+    // The state must not be all zeros, which the seed is only with a probability of 2^-256.
+    do {
+      for (uint64_t& word : state_) {
+        word = RandomUtility::random();
+      }
+    } while ((state_[0] | state_[1] | state_[2] | state_[3]) == 0);
+  }
+
+  uint64_t next() {
+    const uint64_t result = std::rotl(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = std::rotl(state_[3], 45);
+    return result;
+  }
+
+private:
+  std::array<uint64_t, 4> state_;
+};
+
+} // namespace
 
 uint64_t RandomUtility::random() {
   // Prefetch 256 * sizeof(uint64_t) bytes of randomness. buffered_idx is initialized to 256,
@@ -47,7 +105,7 @@ uint64_t RandomUtility::random() {
   return buffered[buffered_idx++];
 }
 
-std::string RandomUtility::uuid() {
+absl::string_view RandomUtility::writeUuid(RandomGenerator::UuidBuffer& buffer) {
   // Prefetch 2048 bytes of randomness. buffered_idx is initialized to sizeof(buffered),
   // i.e. out-of-range value, so the buffer will be filled with randomness on the first
   // call to this function.
@@ -87,53 +145,44 @@ std::string RandomUtility::uuid() {
   rand[6] = (rand[6] & 0x0f) | 0x40; // UUID version 4 (random)
   rand[8] = (rand[8] & 0x3f) | 0x80; // UUID variant 1 (RFC4122)
 
-  // Convert UUID to a string representation, e.g. a121e9e1-feae-4136-9e0e-6fac343d56c9.
-  static const char* const hex = "0123456789abcdef";
-  char uuid[CONSTEXPR_UUID_LENGTH];
-
-  for (uint8_t i = 0; i < 4; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i] = hex[d >> 4];
-    uuid[2 * i + 1] = hex[d & 0x0f];
+  // Convert UUID to a string representation, e.g. a121e9e1-feae-4136-9e0e-6fac343d56c9. Each byte
+  // is written as a pair of digits looked up in a table, and the dashes are at fixed positions, so
+  // the conversion is branch free and the loop is unrolled by the compiler.
+  char* uuid = buffer.data();
+  for (size_t i = 0; i < UuidHexOffsets.size(); i++) {
+    memcpy(uuid + UuidHexOffsets[i], HexPairs[rand[i]].data(), 2); // NOLINT(safe-memcpy)
   }
-
   uuid[8] = '-';
-
-  for (uint8_t i = 4; i < 6; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 1] = hex[d >> 4];
-    uuid[2 * i + 2] = hex[d & 0x0f];
-  }
-
   uuid[13] = '-';
-
-  for (uint8_t i = 6; i < 8; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 2] = hex[d >> 4];
-    uuid[2 * i + 3] = hex[d & 0x0f];
-  }
-
   uuid[18] = '-';
+  uuid[23] = '-';
 
-  for (uint8_t i = 8; i < 10; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 3] = hex[d >> 4];
-    uuid[2 * i + 4] = hex[d & 0x0f];
-  }
+  return {uuid, CONSTEXPR_UUID_LENGTH};
+}
 
-  uuid[23] = '-';
+std::string RandomUtility::uuid() {
+  RandomGenerator::UuidBuffer buffer;
+  return std::string(writeUuid(buffer));
+}
 
-  for (uint8_t i = 10; i < 16; i++) {
-    const uint8_t d = rand[i];
-    uuid[2 * i + 4] = hex[d >> 4];
-    uuid[2 * i + 5] = hex[d & 0x0f];
-  }
+uint64_t RandomUtility::fastRandom() { return Xoshiro256StarStar::get().next(); }
 
-  return {uuid, CONSTEXPR_UUID_LENGTH};
+void RandomUtility::fastRandomFill(absl::Span<uint64_t> out) {
+  Xoshiro256StarStar& generator = Xoshiro256StarStar::get();
+  for (uint64_t& value : out) {
+    value = generator.next();
+  }
 }
 
 uint64_t RandomGeneratorImpl::random() { return RandomUtility::random(); }
+uint64_t RandomGeneratorImpl::fastRandom() { return RandomUtility::fastRandom(); }
+void RandomGeneratorImpl::fastRandomFill(absl::Span<uint64_t> out) {
+  RandomUtility::fastRandomFill(out);
+}
 std::string RandomGeneratorImpl::uuid() { return RandomUtility::uuid(); }
+absl::string_view RandomGeneratorImpl::writeUuid(UuidBuffer& buffer) {
+  return RandomUtility::writeUuid(buffer);
+}
 
 } // namespace Random
 } // namespace Envoy
@@ -14,6 +14,14 @@ class RandomUtility {
 public:
   static uint64_t random();
   static std::string uuid();
+  static absl::string_view writeUuid(RandomGenerator::UuidBuffer& buffer);
+
+  /**
+   * Non-cryptographic random numbers, from a per-thread xoshiro256** generator seeded by random().
+   * See RandomGenerator::fastRandom().
+   */
+  static uint64_t fastRandom();
+  static void fastRandomFill(absl::Span<uint64_t> out);
 };
 
 /**
@@ -24,7 +32,10 @@ class RandomGeneratorImpl : public RandomGenerator {
 public:
   // Random::RandomGenerator
   uint64_t random() override;
+  uint64_t fastRandom() override;
+  void fastRandomFill(absl::Span<uint64_t> out) override;
   std::string uuid() override;
+  absl::string_view writeUuid(UuidBuffer& buffer) override;
 
   static const size_t UUID_LENGTH;
 };
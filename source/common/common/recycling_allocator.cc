@@ -0,0 +1,168 @@
+#include "source/common/common/recycling_allocator.h"
+
+#include <array>
+#include <new>
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ENVOY_RECYCLING_ALLOCATOR_DISABLED
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+#define ENVOY_RECYCLING_ALLOCATOR_DISABLED
+#endif
+
+namespace Envoy {
+namespace {
+
+// The size of the block is stored before the memory returned to the caller, in a header which keeps
+// the memory aligned.
+constexpr size_t HeaderSize = alignof(std::max_align_t);
+
+#ifdef ENVOY_RECYCLING_ALLOCATOR_DISABLED
+constexpr bool RecyclingEnabled = false;
+#else
+constexpr bool RecyclingEnabled = true;
+#endif
+
+class ThreadFreeLists {
+public:
+  ~ThreadFreeLists() {
+    destroyed_ = true;
+    release();
+  }
+
+  /**
+   * @return the free lists of the calling thread, or nullptr if they have already been destroyed
+   *         by the exit of the thread.
+   */
+  static ThreadFreeLists* get() {
+    if (destroyed_) {
+      return nullptr;
+    }
+    static thread_local ThreadFreeLists free_lists;
+    return &free_lists;
+  }
+
+  void* pop(size_t block_size) {
+    FreeList* list = find(block_size);
+    if (list == nullptr || list->count_ == 0) {
+      ++heap_allocations_;
+      return nullptr;
+    }
+    ++recycled_allocations_;
+    return list->blocks_[--list->count_];
+  }
+
+  bool push(void* block, size_t block_size) {
+    if (!RecyclingEnabled || !enabled_ || block_size > RecyclingAllocator::MaxBlockSize) {
+      return false;
+    }
+    FreeList* list = find(block_size);
+    if (list == nullptr) {
+      // Claim an unused free list for this size, if any.
+      list = find(0);
+      if (list == nullptr) {
+        return false;
+      }
+      list->size_ = block_size;
+    }
+    if (list->count_ == RecyclingAllocator::MaxFreeBlocks) {
+      return false;
+    }
+    list->blocks_[list->count_++] = block;
+    return true;
+  }
+
+  void setEnabled(bool enabled) {
+    enabled_ = enabled;
+    if (!enabled) {
+      release();
+    }
+  }
+
+  uint64_t heapAllocations() const { return heap_allocations_; }
+  uint64_t recycledAllocations() const { return recycled_allocations_; }
+
+private:
+  struct FreeList {
+    size_t size_{};
+    size_t count_{};
+    std::array<void*, RecyclingAllocator::MaxFreeBlocks> blocks_;
+  };
+
+  void release() {
+    for (FreeList& list : lists_) {
+      for (size_t i = 0; i < list.count_; ++i) {
+        ::operator delete(list.blocks_[i]);
+      }
+      list = FreeList();
+    }
+  }
+
+  FreeList* find(size_t block_size) {
+    for (FreeList& list : lists_) {
+      if (list.size_ == block_size) {
+        return &list;
+      }
+    }
+    return nullptr;
+  }
+
+  // Trivially destructible, so that it can still be read while the thread locals of an exiting
+  // thread are destroyed, e.g. by the destructor of an object freeing recycled memory.
+  static thread_local bool destroyed_;
+
+  std::array<FreeList, RecyclingAllocator::MaxSizes> lists_{};
+  bool enabled_{true};
+  uint64_t heap_allocations_{};
+  uint64_t recycled_allocations_{};
+};
+
+thread_local bool ThreadFreeLists::destroyed_ = false;
+
+} // namespace
+
+void* RecyclingAllocator::allocate(size_t size) {
+  const size_t block_size = size + HeaderSize;
+  ThreadFreeLists* free_lists = ThreadFreeLists::get();
+  void* block = free_lists != nullptr ? free_lists->pop(block_size) : nullptr;
+  if (block == nullptr) {
+    block = ::operator new(block_size);
+  }
+  *static_cast<size_t*>(block) = block_size;
+  return static_cast<char*>(block) + HeaderSize;
+}
+
+void RecyclingAllocator::free(void* memory) {
+  if (memory == nullptr) {
+    return;
+  }
+  void* block = static_cast<char*>(memory) - HeaderSize;
+  const size_t block_size = *static_cast<size_t*>(block);
+  ThreadFreeLists* free_lists = ThreadFreeLists::get();
+  if (free_lists == nullptr || !free_lists->push(block, block_size)) {
+    ::operator delete(block);
+  }
+}
+
+bool RecyclingAllocator::enabled() { return RecyclingEnabled; }
+
+void RecyclingAllocator::setThreadEnabled(bool enabled) {
+  ThreadFreeLists* free_lists = ThreadFreeLists::get();
+  if (free_lists != nullptr) {
+    free_lists->setEnabled(enabled);
+  }
+}
+
+uint64_t RecyclingAllocator::heapAllocations() {
+  const ThreadFreeLists* free_lists = ThreadFreeLists::get();
+  return free_lists != nullptr ? free_lists->heapAllocations() : 0;
+}
+
+uint64_t RecyclingAllocator::recycledAllocations() {
+  const ThreadFreeLists* free_lists = ThreadFreeLists::get();
+  return free_lists != nullptr ? free_lists->recycledAllocations() : 0;
+}
+
+} // namespace Envoy
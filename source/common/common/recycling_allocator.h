@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+
+/**
+ * Bounded per-thread free lists for the memory of objects which are created and destroyed at a
+ * high rate on the workers, such as the streams of a multiplexed HTTP connection and their header
+ * maps. The memory of a freed object is kept on a free list of the freeing thread, so that the next
+ * object of the same size created on that thread reuses it rather than going to the heap.
+ *
+ * Only the memory is recycled: the objects are constructed and destroyed as usual, so no state can
+ * leak from an object to the next one using its memory. The free lists hold MaxSizes sizes of up to
+ * MaxBlockSize bytes and MaxFreeBlocks blocks of each size, i.e. at most 256KiB per thread and
+ * usually far less; other blocks are returned to the heap. Memory may be freed on a different
+ * thread than the one which allocated it.
+ *
+ * The workers release their free lists and stop recycling while the shrink_heap overload action is
+ * saturated, see setThreadEnabled().
+ *
+ * Recycling is disabled when building with AddressSanitizer, which would otherwise not detect the
+ * uses of a freed object whose memory has been recycled.
+ */
+class RecyclingAllocator {
+public:
+  /**
+   * @param size supplies the number of bytes to allocate.
+   * @return memory aligned to alignof(std::max_align_t), which must be released with free().
+   */
+  static void* allocate(size_t size);
+
+  /**
+   * @param memory supplies memory returned by allocate(), or nullptr.
+   */
+  static void free(void* memory);
+
+  /**
+   * @return whether freed memory is recycled.
+   */
+  static bool enabled();
+
+  /**
+   * Stops or resumes recycling the memory freed on the calling thread. Stopping also returns the
+   * memory held by the free lists of the thread to the heap.
+   * @param enabled supplies whether to recycle the memory freed on the calling thread.
+   */
+  static void setThreadEnabled(bool enabled);
+
+  /**
+   * @return the number of allocations of the calling thread which were served by the heap.
+   */
+  static uint64_t heapAllocations();
+
+  /**
+   * @return the number of allocations of the calling thread which were served by the free lists.
+   */
+  static uint64_t recycledAllocations();
+
+  static constexpr size_t MaxSizes = 4;
+  static constexpr size_t MaxFreeBlocks = 8;
+  static constexpr size_t MaxBlockSize = 8 * 1024;
+};
+
+/**
+ * Mixin for classes whose objects are allocated with the RecyclingAllocator.
+ */
+class Recyclable {
+public:
+  static void* operator new(size_t size) { return RecyclingAllocator::allocate(size); }
+  static void operator delete(void* address) { RecyclingAllocator::free(address); }
+};
+
+/**
+ * Variant of InlineStorage (see source/common/common/utility.h) for variable-size objects which are
+ * allocated with the RecyclingAllocator.
+ */
+class RecyclableInlineStorage : public NonCopyable {
+public:
+  static void operator delete(void* address) { RecyclingAllocator::free(address); }
+
+protected:
+  /**
+   * @param object_size the size of the base object; supplied automatically by the compiler.
+   * @param data_size the amount of variable-size storage to be added, in bytes.
+   * @return a variable-size object based on data_size_bytes.
+   */
+  static void* operator new(size_t object_size, size_t data_size_bytes) {
+    return RecyclingAllocator::allocate(object_size + data_size_bytes);
+  }
+};
+
+} // namespace Envoy
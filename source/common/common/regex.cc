@@ -1,5 +1,7 @@
 #include "source/common/common/regex.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.validate.h"
@@ -92,10 +94,73 @@ CompiledGoogleReMatcher::CompiledGoogleReMatcher(
   }
 }
 
+absl::StatusOr<std::unique_ptr<CompiledGoogleReSetMatcher>>
+CompiledGoogleReSetMatcher::create(const std::vector<std::string>& regexes) {
+  absl::Status creation_status = absl::OkStatus();
+  auto ret = std::unique_ptr<CompiledGoogleReSetMatcher>(
+      new CompiledGoogleReSetMatcher(regexes, creation_status));
+  RETURN_IF_NOT_OK(creation_status);
+  return ret;
+}
+
+CompiledGoogleReSetMatcher::CompiledGoogleReSetMatcher(const std::vector<std::string>& regexes,
+                                                       absl::Status& creation_status)
+    : set_(re2::RE2::Quiet, re2::RE2::ANCHOR_BOTH) {
+  regexes_.reserve(regexes.size());
+  for (const std::string& regex : regexes) {
+    std::string error;
+    if (set_.Add(regex, &error) < 0) {
+      creation_status = absl::InvalidArgumentError(error);
+      return;
+    }
+    regexes_.push_back(std::make_unique<const re2::RE2>(regex, re2::RE2::Quiet));
+  }
+  if (!set_.Compile()) {
+    creation_status = absl::ResourceExhaustedError("unable to compile regex set");
+  }
+}
+
+absl::optional<uint32_t> CompiledGoogleReSetMatcher::firstMatch(absl::string_view value) const {
+  std::vector<int> matches;
+  re2::RE2::Set::ErrorInfo error_info;
+  if (!set_.Match(value, &matches, &error_info)) {
+    if (error_info.kind != re2::RE2::Set::kNoError) {
+      return slowFirstMatch(value);
+    }
+    return absl::nullopt;
+  }
+  return *std::min_element(matches.begin(), matches.end());
+}
+
+bool CompiledGoogleReSetMatcher::matchAny(absl::string_view value) const {
+  re2::RE2::Set::ErrorInfo error_info;
+  if (!set_.Match(value, nullptr, &error_info)) {
+    return error_info.kind != re2::RE2::Set::kNoError && slowFirstMatch(value).has_value();
+  }
+  return true;
+}
+
+absl::optional<uint32_t> CompiledGoogleReSetMatcher::slowFirstMatch(absl::string_view value) const {
+  ENVOY_LOG_EVERY_POW_2_MISC(
+      warn, "regex set exceeded its DFA memory budget, matching {} regexes one by one",
+      regexes_.size());
+  for (uint32_t i = 0; i < regexes_.size(); ++i) {
+    if (re2::RE2::FullMatch(value, *regexes_[i])) {
+      return i;
+    }
+  }
+  return absl::nullopt;
+}
+
 absl::StatusOr<CompiledMatcherPtr> GoogleReEngine::matcher(const std::string& regex) const {
   return CompiledGoogleReMatcher::createAndSizeCheck(regex);
 }
 
+absl::StatusOr<CompiledSetMatcherPtr>
+GoogleReEngine::setMatcher(const std::vector<std::string>& regexes) const {
+  return CompiledGoogleReSetMatcher::create(regexes);
+}
+
 EnginePtr GoogleReEngineFactory::createEngine(const Protobuf::Message&,
                                               Server::Configuration::ServerFactoryContext&) {
   return std::make_shared<GoogleReEngine>();
@@ -13,6 +13,7 @@
 #include "source/common/stats/symbol_table.h"
 
 #include "re2/re2.h"
+#include "re2/set.h"
 #include "xds/type/matcher/v3/regex.pb.h"
 
 namespace Envoy {
@@ -61,9 +62,32 @@ public:
       : CompiledGoogleReMatcher(regex) {}
 };
 
+// Matches a set of regexes with a single re2::RE2::Set. If the set runs out of memory for a value,
+// the regexes are matched one by one instead.
+class CompiledGoogleReSetMatcher : public CompiledSetMatcher {
+public:
+  static absl::StatusOr<std::unique_ptr<CompiledGoogleReSetMatcher>>
+  create(const std::vector<std::string>& regexes);
+
+  // CompiledSetMatcher
+  absl::optional<uint32_t> firstMatch(absl::string_view value) const override;
+  bool matchAny(absl::string_view value) const override;
+
+private:
+  explicit CompiledGoogleReSetMatcher(const std::vector<std::string>& regexes,
+                                      absl::Status& creation_status);
+
+  absl::optional<uint32_t> slowFirstMatch(absl::string_view value) const;
+
+  re2::RE2::Set set_;
+  std::vector<std::unique_ptr<const re2::RE2>> regexes_;
+};
+
 class GoogleReEngine : public Engine {
 public:
   absl::StatusOr<CompiledMatcherPtr> matcher(const std::string& regex) const override;
+  absl::StatusOr<CompiledSetMatcherPtr>
+  setMatcher(const std::vector<std::string>& regexes) const override;
 };
 
 class GoogleReEngineFactory : public EngineFactory {
@@ -39,6 +39,7 @@
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/linked_object.h"
+#include "source/common/common/recycling_allocator.h"
 #include "source/common/grpc/common.h"
 #include "source/common/http/conn_manager_config.h"
 #include "source/common/http/filter_manager.h"
@@ -135,9 +136,11 @@ private:
 
   /**
    * Wraps a single active stream on the connection. These are either full request/response pairs
-   * or pushes.
+   * or pushes. The memory of the streams is recycled by the workers, as a multiplexed connection
+   * may create and destroy millions of them.
    */
   struct ActiveStream final : LinkedObject<ActiveStream>,
+                              public Recyclable,
                               public Event::DeferredDeletable,
                               public StreamCallbacks,
                               public CodecEventCallbacks,
@@ -1,7 +1,10 @@
 #include "source/common/http/filter_chain_helper.h"
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/registry/registry.h"
 
@@ -11,36 +14,94 @@
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
 
+#include "absl/container/inlined_vector.h"
+#include "absl/hash/hash.h"
+
 namespace Envoy {
 namespace Http {
 
+namespace {
+
+// A filter chain prebuilt for a source of filterDisabled() decisions. As the ids are never reused,
+// an entry which is no longer used, e.g. after a route configuration update, can never match again
+// and is simply replaced by the next chain mapped to its slot.
+struct PrebuiltFilterChain {
+  uint64_t chains_id_{};
+  uint64_t source_id_{};
+  std::vector<const FilterChainUtility::FilterFactoryProvider*> filter_factories_;
+};
+
+// The cache is direct mapped, as there are usually far fewer routes than slots.
+constexpr size_t PrebuiltFilterChainSlots = 512;
+
+std::array<PrebuiltFilterChain, PrebuiltFilterChainSlots>& prebuiltFilterChainCache() {
+  static thread_local std::array<PrebuiltFilterChain, PrebuiltFilterChainSlots> cache;
+  return cache;
+}
+
+std::atomic<uint64_t> next_prebuilt_filter_chains_id{1};
+
+bool filterEnabled(const FilterChainOptions& options,
+                   const FilterChainUtility::FilterFactoryProvider& filter_factory) {
+  return !options.filterDisabled(filter_factory.provider->name()).value_or(filter_factory.disabled);
+}
+
+} // namespace
+
+FilterChainUtility::PrebuiltFilterChains::PrebuiltFilterChains()
+    : id_(next_prebuilt_filter_chains_id++) {}
+
 void FilterChainUtility::createFilterChainForFactories(
     Http::FilterChainManager& manager, const FilterChainOptions& options,
-    const FilterFactoriesList& filter_factories) {
+    const FilterFactoriesList& filter_factories, const PrebuiltFilterChains* prebuilt_chains) {
   bool added_missing_config_filter = false;
-  for (const auto& filter_config_provider : filter_factories) {
-    // If this filter is disabled explicitly, skip trying to create it.
-    if (options.filterDisabled(filter_config_provider.provider->name())
-            .value_or(filter_config_provider.disabled)) {
-      continue;
+  const uint64_t source_id = prebuilt_chains != nullptr ? options.filterDisabledCacheId() : 0;
+  if (source_id == 0) {
+    for (const auto& filter_factory : filter_factories) {
+      // If this filter is disabled explicitly, skip trying to create it.
+      if (filterEnabled(options, filter_factory)) {
+        applyFilterFactory(manager, filter_factory, added_missing_config_filter);
+      }
     }
+    return;
+  }
 
-    auto config = filter_config_provider.provider->config();
-    if (config.has_value()) {
-      manager.applyFilterFactoryCb({filter_config_provider.provider->name()}, config.ref());
-      continue;
+  const size_t slot = absl::HashOf(prebuilt_chains->id_, source_id) % PrebuiltFilterChainSlots;
+  PrebuiltFilterChain& chain = prebuiltFilterChainCache()[slot];
+  if (chain.chains_id_ != prebuilt_chains->id_ || chain.source_id_ != source_id) {
+    chain.chains_id_ = prebuilt_chains->id_;
+    chain.source_id_ = source_id;
+    chain.filter_factories_.clear();
+    for (const auto& filter_factory : filter_factories) {
+      if (filterEnabled(options, filter_factory)) {
+        chain.filter_factories_.push_back(&filter_factory);
+      }
     }
+  }
+  // The chain is copied, as it could be evicted by a filter chain created by a filter factory.
+  const absl::InlinedVector<const FilterFactoryProvider*, 16> filter_factories_to_apply(
+      chain.filter_factories_.begin(), chain.filter_factories_.end());
+  for (const FilterFactoryProvider* filter_factory : filter_factories_to_apply) {
+    applyFilterFactory(manager, *filter_factory, added_missing_config_filter);
+  }
+}
 
-    // If a filter config is missing after warming, inject a local reply with status 500.
-    if (!added_missing_config_filter) {
-      ENVOY_LOG(trace, "Missing filter config for a provider {}",
-                filter_config_provider.provider->name());
-      manager.applyFilterFactoryCb({}, MissingConfigFilterFactory);
-      added_missing_config_filter = true;
-    } else {
-      ENVOY_LOG(trace, "Provider {} missing a filter config",
-                filter_config_provider.provider->name());
-    }
+void FilterChainUtility::applyFilterFactory(Http::FilterChainManager& manager,
+                                            const FilterFactoryProvider& filter_factory,
+                                            bool& added_missing_config_filter) {
+  auto config = filter_factory.provider->config();
+  if (config.has_value()) {
+    manager.applyFilterFactoryCb({filter_factory.provider->name()}, config.ref());
+    return;
+  }
+
+  // If a filter config is missing after warming, inject a local reply with status 500.
+  if (!added_missing_config_filter) {
+    ENVOY_LOG(trace, "Missing filter config for a provider {}", filter_factory.provider->name());
+    manager.applyFilterFactoryCb({}, MissingConfigFilterFactory);
+    added_missing_config_filter = true;
+  } else {
+    ENVOY_LOG(trace, "Provider {} missing a filter config", filter_factory.provider->name());
   }
 }
 
@@ -8,6 +8,7 @@
 
 #include "source/common/common/empty_string.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/non_copyable.h"
 #include "source/common/filter/config_discovery_impl.h"
 #include "source/common/http/dependency_manager.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
@@ -52,9 +53,29 @@ public:
   using FiltersList = Protobuf::RepeatedPtrField<
       envoy::extensions::filters::network::http_connection_manager::v3::HttpFilter>;
 
+  /**
+   * The filter chains of a list of filter factories prebuilt for each source of filterDisabled()
+   * decisions, i.e. each route: the chain of a route holds the filters which are not disabled for
+   * it, so that the filter chain of a stream is created by a single pass over them instead of
+   * looking up the route configuration of every filter. The chains are built on first use by each
+   * worker and kept in a bounded cache of the worker. They must be used with the list of filter
+   * factories which they are created for.
+   */
+  class PrebuiltFilterChains : NonCopyable {
+  public:
+    PrebuiltFilterChains();
+
+  private:
+    friend class FilterChainUtility;
+
+    // Identifies the chains in the caches of the workers. Unlike an address, it is never reused.
+    const uint64_t id_;
+  };
+
   static void createFilterChainForFactories(Http::FilterChainManager& manager,
                                             const FilterChainOptions& options,
-                                            const FilterFactoriesList& filter_factories);
+                                            const FilterFactoriesList& filter_factories,
+                                            const PrebuiltFilterChains* prebuilt_chains = nullptr);
 
   static std::shared_ptr<DownstreamFilterConfigProviderManager>
   createSingletonDownstreamFilterConfigProviderManager(
@@ -63,6 +84,11 @@ public:
   static std::shared_ptr<UpstreamFilterConfigProviderManager>
   createSingletonUpstreamFilterConfigProviderManager(
       Server::Configuration::ServerFactoryContext& context);
+
+private:
+  static void applyFilterFactory(Http::FilterChainManager& manager,
+                                 const FilterFactoryProvider& filter_factory,
+                                 bool& added_missing_config_filter);
 };
 
 template <class FilterCtx, class NeutralNamedHttpFilterFactory>
@@ -17,6 +17,7 @@
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/monotonic_arena.h"
 #include "source/common/grpc/common.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
@@ -63,6 +64,7 @@ private:
  * memory overhead of unused fields) should apply.
  */
 struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
+                                public ArenaAllocated,
                                 Logger::Loggable<Logger::Id::http> {
   ActiveStreamFilterBase(FilterManager& parent, FilterContext filter_context)
       : parent_(parent), iteration_state_(IterationState::Continue),
@@ -918,26 +920,28 @@ private:
     FilterChainFactoryCallbacksImpl(FilterManager& manager, const Http::FilterContext& context)
         : manager_(manager), context_(context) {}
 
+    // The filter wrappers are allocated from the arena of the stream, as are the filters which opt
+    // into it with streamArena().
     void addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr filter) override {
       manager_.addStreamFilterBase(filter.get());
-      manager_.addStreamDecoderFilter(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, std::move(filter), context_));
+      manager_.addStreamDecoderFilter(ActiveStreamDecoderFilterPtr{
+          new (manager_.arena_) ActiveStreamDecoderFilter(manager_, std::move(filter), context_)});
     }
 
     void addStreamEncoderFilter(Http::StreamEncoderFilterSharedPtr filter) override {
       manager_.addStreamFilterBase(filter.get());
-      manager_.addStreamEncoderFilter(
-          std::make_unique<ActiveStreamEncoderFilter>(manager_, std::move(filter), context_));
+      manager_.addStreamEncoderFilter(ActiveStreamEncoderFilterPtr{
+          new (manager_.arena_) ActiveStreamEncoderFilter(manager_, std::move(filter), context_)});
     }
 
     void addStreamFilter(Http::StreamFilterSharedPtr filter) override {
       StreamDecoderFilter* decoder_filter = filter.get();
       manager_.addStreamFilterBase(decoder_filter);
 
-      manager_.addStreamDecoderFilter(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, filter, context_));
-      manager_.addStreamEncoderFilter(
-          std::make_unique<ActiveStreamEncoderFilter>(manager_, std::move(filter), context_));
+      manager_.addStreamDecoderFilter(ActiveStreamDecoderFilterPtr{
+          new (manager_.arena_) ActiveStreamDecoderFilter(manager_, filter, context_)});
+      manager_.addStreamEncoderFilter(ActiveStreamEncoderFilterPtr{
+          new (manager_.arena_) ActiveStreamEncoderFilter(manager_, std::move(filter), context_)});
     }
 
     void addAccessLogHandler(AccessLog::InstanceSharedPtr handler) override {
@@ -946,6 +950,8 @@ private:
 
     Event::Dispatcher& dispatcher() override { return manager_.dispatcher_; }
 
+    OptRef<MonotonicArena> streamArena() override { return manager_.arena_; }
+
   private:
     FilterManager& manager_;
     const Http::FilterContext& context_;
@@ -958,6 +964,9 @@ private:
     absl::optional<bool> filterDisabled(absl::string_view config_name) const override {
       return route_ != nullptr ? route_->filterDisabled(config_name) : absl::nullopt;
     }
+    uint64_t filterDisabledCacheId() const override {
+      return route_ != nullptr ? route_->filterDisabledCacheId() : 0;
+    }
 
   private:
     const Router::RouteConstSharedPtr route_;
@@ -1035,9 +1044,13 @@ private:
   Buffer::BufferMemoryAccountSharedPtr account_;
   const bool proxy_100_continue_;
 
+  // The filter wrappers, the filters which opt into it and the list of filters are allocated from
+  // this arena, which is thus declared before them to be destroyed after them.
+  MonotonicArena arena_;
   std::list<ActiveStreamDecoderFilterPtr> decoder_filters_;
   std::list<ActiveStreamEncoderFilterPtr> encoder_filters_;
-  std::list<StreamFilterBase*> filters_;
+  std::list<StreamFilterBase*, ArenaAllocator<StreamFilterBase*>> filters_{
+      ArenaAllocator<StreamFilterBase*>(arena_)};
   std::list<AccessLog::InstanceSharedPtr> access_log_handlers_;
 
   // Stores metadata added in the decoding filter that is being processed. Will be cleared before
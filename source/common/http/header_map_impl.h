@@ -13,6 +13,7 @@
 
 #include "source/common/common/compiled_string_map.h"
 #include "source/common/common/non_copyable.h"
+#include "source/common/common/recycling_allocator.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
@@ -488,7 +489,7 @@ protected:
  * headers.
  */
 class RequestHeaderMapImpl final : public TypedHeaderMapImpl<RequestHeaderMap>,
-                                   public InlineStorage {
+                                   public RecyclableInlineStorage {
 public:
   static std::unique_ptr<RequestHeaderMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
@@ -535,7 +536,7 @@ private:
  * headers.
  */
 class RequestTrailerMapImpl final : public TypedHeaderMapImpl<RequestTrailerMap>,
-                                    public InlineStorage {
+                                    public RecyclableInlineStorage {
 public:
   static std::unique_ptr<RequestTrailerMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
@@ -565,7 +566,7 @@ private:
  * headers.
  */
 class ResponseHeaderMapImpl final : public TypedHeaderMapImpl<ResponseHeaderMap>,
-                                    public InlineStorage {
+                                    public RecyclableInlineStorage {
 public:
   static std::unique_ptr<ResponseHeaderMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
@@ -612,7 +613,7 @@ private:
  * inline headers.
  */
 class ResponseTrailerMapImpl final : public TypedHeaderMapImpl<ResponseTrailerMap>,
-                                     public InlineStorage {
+                                     public RecyclableInlineStorage {
 public:
   static std::unique_ptr<ResponseTrailerMapImpl>
   create(const uint32_t max_headers_kb = UINT32_MAX,
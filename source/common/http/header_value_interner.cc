@@ -0,0 +1,37 @@
+#include "source/common/http/header_value_interner.h"
+
+#include <memory>
+#include <string>
+
+#include "source/common/common/hash.h"
+
+namespace Envoy {
+namespace Http {
+
+HeaderValueInterner& HeaderValueInterner::get() {
+  static thread_local HeaderValueInterner interner;
+  return interner;
+}
+
+InternedStringSharedPtr HeaderValueInterner::intern(absl::string_view value) {
+  if (value.size() <= InlinedStringCapacity || value.size() > MaxValueSize) {
+    return nullptr;
+  }
+
+  const uint64_t hash = HashUtil::xxHash64(value);
+  Slot& slot = slots_[hash % Slots];
+  if (slot.value_ != nullptr && slot.hash_ == hash && *slot.value_ == value) {
+    return slot.value_;
+  }
+  if (slot.candidate_hash_ != hash) {
+    slot.candidate_hash_ = hash;
+    return nullptr;
+  }
+  slot.candidate_hash_ = 0;
+  slot.hash_ = hash;
+  slot.value_ = std::make_shared<const std::string>(value);
+  return slot.value_;
+}
+
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "envoy/common/union_string.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * A bounded cache of the header values interned by the codecs of a worker thread, so that the long
+ * values which an upstream repeats in every response (e.g. content-security-policy or vary) are
+ * shared by the header maps of the streams rather than copied into each of them. As the codecs of a
+ * worker are always used on the worker thread, no locking is needed. The interned values are
+ * reference counted, so they may outlive the cache and be released on any thread.
+ *
+ * The cache is direct mapped: a value is interned in the slot selected by its hash once it is seen
+ * twice in a row in that slot, replacing the value interned there before. Values which are seen
+ * only once, such as dates or request ids, thus never displace the repeated ones.
+ */
+class HeaderValueInterner {
+public:
+  /**
+   * @return the interner of the calling thread.
+   */
+  static HeaderValueInterner& get();
+
+  /**
+   * @return the interned string of a header value, or nullptr if the value is not interned.
+   */
+  InternedStringSharedPtr intern(absl::string_view value);
+
+  void clear() { slots_ = {}; }
+
+  // Values which fit in the inline storage of a HeaderString are not interned, as copying them
+  // allocates nothing. Longer values are interned up to this size.
+  static constexpr size_t MaxValueSize = 2048;
+  static constexpr size_t Slots = 256;
+
+private:
+  struct Slot {
+    // The hash of the last value seen in the slot which was not interned.
+    uint64_t candidate_hash_{};
+    uint64_t hash_{};
+    InternedStringSharedPtr value_;
+  };
+
+  std::array<Slot, Slots> slots_;
+};
+
+} // namespace Http
+} // namespace Envoy
@@ -1,8 +1,10 @@
 #include "source/common/http/http1/balsa_parser.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cstdint>
+#include <cstring>
 
 #include "source/common/common/assert.h"
 #include "source/common/http/headers.h"
@@ -30,8 +32,49 @@ constexpr absl::string_view kHttpVersionPrefix = "HTTP/";
 // https://www.rfc-editor.org/rfc/rfc9110.html
 constexpr absl::string_view kValidCharacters =
     "!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`abcdefghijklmnopqrstuvwxyz|~";
-constexpr absl::string_view::iterator kValidCharactersBegin = kValidCharacters.begin();
-constexpr absl::string_view::iterator kValidCharactersEnd = kValidCharacters.end();
+
+// Lookup table of the characters above, so that field names and methods are validated with one
+// load per character.
+constexpr std::array<bool, 256> kValidCharactersTable = [] {
+  std::array<bool, 256> table{};
+  for (const char c : kValidCharacters) {
+    table[static_cast<uint8_t>(c)] = true;
+  }
+  return table;
+}();
+
+bool isValidCharacter(char c) { return kValidCharactersTable[static_cast<uint8_t>(c)]; }
+
+bool isValidToken(absl::string_view token) {
+  return std::all_of(token.begin(), token.end(), isValidCharacter);
+}
+
+// Same set of characters are allowed for path and query.
+constexpr std::array<bool, 256> kValidPathQueryCharactersTable = [] {
+  std::array<bool, 256> table{};
+  table['\t'] = true;
+  table['\f'] = true;
+  for (int c = '!'; c <= 126; ++c) {
+    table[c] = true;
+  }
+  return table;
+}();
+
+bool isValidPathQueryCharacter(char c) {
+  return kValidPathQueryCharactersTable[static_cast<uint8_t>(c)];
+}
+
+// Allowed characters for the host of an absolute URL.
+constexpr std::array<bool, 256> kValidHostCharactersTable = [] {
+  std::array<bool, 256> table{};
+  for (const char c : absl::string_view("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                        "abcdefghijklmnopqrstuvwxyz!$%&'()*+,-.:;=@[]_~")) {
+    table[static_cast<uint8_t>(c)] = true;
+  }
+  return table;
+}();
+
+bool isValidHostCharacter(char c) { return kValidHostCharactersTable[static_cast<uint8_t>(c)]; }
 
 bool isFirstCharacterOfValidMethod(char c) {
   static constexpr char kValidFirstCharacters[] = {'A', 'B', 'C', 'D', 'G', 'H', 'L', 'M',
@@ -46,10 +89,7 @@ bool isFirstCharacterOfValidMethod(char c) {
 // enabled.
 bool isMethodValid(absl::string_view method, bool allow_custom_methods) {
   if (allow_custom_methods) {
-    return !method.empty() &&
-           std::all_of(method.begin(), method.end(), [](absl::string_view::value_type c) {
-             return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-           });
+    return !method.empty() && isValidToken(method);
   }
 
   static constexpr absl::string_view kValidMethods[] = {
@@ -70,15 +110,10 @@ bool isUrlValid(absl::string_view url, bool is_connect) {
     return false;
   }
 
-  // Same set of characters are allowed for path and query.
-  const auto is_valid_path_query_char = [](char c) {
-    return c == 9 || c == 12 || ('!' <= c && c <= 126);
-  };
-
   // The URL may start with a path.
   if (auto it = url.begin(); *it == '/' || *it == '*') {
     ++it;
-    return std::all_of(it, url.end(), is_valid_path_query_char);
+    return std::all_of(it, url.end(), isValidPathQueryCharacter);
   }
 
   // If method is not CONNECT, parse scheme.
@@ -109,17 +144,11 @@ bool isUrlValid(absl::string_view url, bool is_connect) {
   const absl::string_view host = url.substr(0, path_query_begin - url.begin());
   const absl::string_view path_query = url.substr(path_query_begin - url.begin());
 
-  const auto valid_host_char = [](char c) {
-    return std::isalnum(c) || c == '!' || c == '$' || c == '%' || c == '&' || c == '\'' ||
-           c == '(' || c == ')' || c == '*' || c == '+' || c == ',' || c == '-' || c == '.' ||
-           c == ':' || c == ';' || c == '=' || c == '@' || c == '[' || c == ']' || c == '_' ||
-           c == '~';
-  };
-
   // Match http-parser's quirk of allowing any number of '@' characters in host
   // as long as they are not consecutive.
-  return std::all_of(host.begin(), host.end(), valid_host_char) && !absl::StrContains(host, "@@") &&
-         std::all_of(path_query.begin(), path_query.end(), is_valid_path_query_char);
+  return std::all_of(host.begin(), host.end(), isValidHostCharacter) &&
+         !absl::StrContains(host, "@@") &&
+         std::all_of(path_query.begin(), path_query.end(), isValidPathQueryCharacter);
 }
 
 // Returns true if `version_input` is a valid HTTP version string as defined at
@@ -139,10 +168,17 @@ bool isVersionValid(absl::string_view version_input) {
          version_input[1] == '.' && absl::ascii_isdigit(version_input[2]);
 }
 
-bool isHeaderNameValid(absl::string_view name) {
-  return std::all_of(name.begin(), name.end(), [](absl::string_view::value_type c) {
-    return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-  });
+bool isHeaderNameValid(absl::string_view name) { return isValidToken(name); }
+
+// Header values only contain CR or LF characters if they were folded over several lines, so the
+// common case is detected with memchr(), which is vectorized by the C library.
+bool containsCrOrLf(absl::string_view value) {
+  // The data of an empty value may be null, which memchr() must not be called with.
+  if (value.empty()) {
+    return false;
+  }
+  return std::memchr(value.data(), '\r', value.size()) != nullptr ||
+         std::memchr(value.data(), '\n', value.size()) != nullptr;
 }
 
 } // anonymous namespace
@@ -430,7 +466,7 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
 
     // Remove CR and LF characters to match http-parser behavior.
     auto is_cr_or_lf = [](char c) { return c == '\r' || c == '\n'; };
-    if (std::any_of(value.begin(), value.end(), is_cr_or_lf)) {
+    if (containsCrOrLf(value)) {
       std::string value_without_cr_or_lf;
       value_without_cr_or_lf.reserve(value.size());
       for (char c : value) {
@@ -1,5 +1,6 @@
 #include "source/common/http/http1/codec_impl.h"
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -19,6 +20,7 @@
 #include "source/common/grpc/common.h"
 #include "source/common/http/exception.h"
 #include "source/common/http/header_utility.h"
+#include "source/common/http/header_value_interner.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/http1/balsa_parser.h"
 #include "source/common/http/http1/header_formatter.h"
@@ -27,6 +29,7 @@
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/ascii.h"
 
 namespace Envoy {
@@ -88,6 +91,24 @@ StatefulHeaderKeyFormatterPtr statefulFormatterFromSettings(const Http::Http1Set
 
 constexpr size_t CRLF_SIZE = 2;
 
+// Calls `cb` with the key and the value of each header of `headers` which is encoded on the wire.
+template <class Callback> void iterateEncodedHeaders(const HeaderMap& headers, Callback cb) {
+  const absl::string_view host = Http::Headers::get().HostLegacy.get();
+  headers.iterate([host, &cb](const HeaderEntry& header) -> HeaderMap::Iterate {
+    absl::string_view key_to_use = header.key().getStringView();
+    // Translate :authority -> host so that upper layers do not need to deal with this.
+    if (key_to_use.size() > 1 && key_to_use[0] == ':' && key_to_use[1] == 'a') {
+      key_to_use = host;
+    }
+
+    // Skip all headers starting with ':' that make it here.
+    if (key_to_use[0] != ':') {
+      cb(key_to_use, header.value().getStringView());
+    }
+    return HeaderMap::Iterate::Continue;
+  });
+}
+
 } // namespace
 
 static constexpr absl::string_view CRLF = "\r\n";
@@ -118,6 +139,30 @@ void StreamEncoderImpl::encodeHeader(absl::string_view key, absl::string_view va
   bytes_meter_->addHeaderBytesSent(header_size);
 }
 
+void StreamEncoderImpl::encodeHeaderBlock(const RequestOrResponseHeaderMap& headers,
+                                          absl::Span<const absl::string_view> start_line,
+                                          absl::string_view framing_header_key,
+                                          absl::string_view framing_header_value) {
+  // The whole block is copied to the buffer at once, in a single reservation.
+  absl::InlinedVector<absl::string_view, 128> fragments(start_line.begin(), start_line.end());
+  iterateEncodedHeaders(headers, [&fragments](absl::string_view key, absl::string_view value) {
+    ASSERT(!key.empty());
+    fragments.insert(fragments.end(), {key, COLON_SPACE, value, CRLF});
+  });
+  if (!framing_header_key.empty()) {
+    fragments.insert(fragments.end(),
+                     {framing_header_key, COLON_SPACE, framing_header_value, CRLF});
+  }
+  fragments.push_back(CRLF);
+
+  uint64_t start_line_size = 0;
+  for (const absl::string_view fragment : start_line) {
+    start_line_size += fragment.size();
+  }
+  const uint64_t block_size = connection_.buffer().addFragments(fragments);
+  bytes_meter_->addHeaderBytesSent(block_size - start_line_size - CRLF.size());
+}
+
 void StreamEncoderImpl::encodeFormattedHeader(absl::string_view key, absl::string_view value,
                                               HeaderKeyFormatterOptConstRef formatter) {
   if (formatter.has_value()) {
@@ -135,6 +180,7 @@ void ResponseEncoderImpl::encode1xxHeaders(const ResponseHeaderMap& headers) {
 }
 
 void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& headers,
+                                          absl::Span<const absl::string_view> start_line,
                                           absl::optional<uint64_t> status, bool end_stream,
                                           bool bodiless_request) {
   HeaderKeyFormatterOptConstRef formatter(headers.formatter());
@@ -144,25 +190,9 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
 
   const Http::HeaderValues& header_values = Http::Headers::get();
   bool saw_content_length = false;
-  headers.iterate(
-      [this, &header_values, formatter](const HeaderEntry& header) -> HeaderMap::Iterate {
-        absl::string_view key_to_use = header.key().getStringView();
-        uint32_t key_size_to_use = header.key().size();
-        // Translate :authority -> host so that upper layers do not need to deal with this.
-        if (key_size_to_use > 1 && key_to_use[0] == ':' && key_to_use[1] == 'a') {
-          key_to_use = absl::string_view(header_values.HostLegacy.get());
-          key_size_to_use = header_values.HostLegacy.get().size();
-        }
-
-        // Skip all headers starting with ':' that make it here.
-        if (key_to_use[0] == ':') {
-          return HeaderMap::Iterate::Continue;
-        }
-
-        encodeFormattedHeader(key_to_use, header.value().getStringView(), formatter);
-
-        return HeaderMap::Iterate::Continue;
-      });
+  // The header added by the codec to frame the body, if any.
+  absl::string_view framing_header_key;
+  absl::string_view framing_header_value;
 
   if (headers.ContentLength()) {
     saw_content_length = true;
@@ -201,7 +231,8 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // body, per https://tools.ietf.org/html/rfc7230#section-3.3.2
       if (!status || (*status >= 200 && *status != 204)) {
         if (!bodiless_request) {
-          encodeFormattedHeader(header_values.ContentLength.get(), "0", formatter);
+          framing_header_key = header_values.ContentLength.get();
+          framing_header_value = "0";
         }
       }
       chunk_encoding_ = false;
@@ -211,8 +242,8 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // For responses to connect requests, do not send the chunked encoding header:
       // https://tools.ietf.org/html/rfc7231#section-4.3.6.
       if (!is_response_to_connect_request_) {
-        encodeFormattedHeader(header_values.TransferEncoding.get(),
-                              header_values.TransferEncodingValues.Chunked, formatter);
+        framing_header_key = header_values.TransferEncoding.get();
+        framing_header_value = header_values.TransferEncodingValues.Chunked;
       }
       // We do not apply chunk encoding for HTTP upgrades, including CONNECT style upgrades.
       // If there is a body in a response on the upgrade path, the chunks will be
@@ -226,7 +257,20 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
     }
   }
 
-  connection_.buffer().add(CRLF);
+  if (formatter.has_value()) {
+    // The formatted keys are only known once formatted, so the headers are encoded one by one.
+    connection_.buffer().addFragments(start_line);
+    iterateEncodedHeaders(
+        headers, [this, formatter](absl::string_view key, absl::string_view value) {
+          encodeFormattedHeader(key, value, formatter);
+        });
+    if (!framing_header_key.empty()) {
+      encodeFormattedHeader(framing_header_key, framing_header_value, formatter);
+    }
+    connection_.buffer().add(CRLF);
+  } else {
+    encodeHeaderBlock(headers, start_line, framing_header_key, framing_header_value);
+  }
 
   if (end_stream) {
     endEncode();
@@ -398,6 +442,45 @@ const Network::ConnectionInfoProvider& StreamEncoderImpl::connectionInfoProvider
 static constexpr absl::string_view RESPONSE_PREFIX = "HTTP/1.1 ";
 static constexpr absl::string_view HTTP_10_RESPONSE_PREFIX = "HTTP/1.0 ";
 
+namespace {
+
+// The status lines of the responses with the standard reason phrase of their code, preformatted
+// for the codes in [MinCode, MaxCode) so that they are not formatted for each response.
+class StatusLines {
+public:
+  StatusLines() {
+    for (uint64_t code = MinCode; code < MaxCode; ++code) {
+      const char* reason_phrase = CodeUtility::toString(static_cast<Code>(code));
+      http11_lines_[code - MinCode] =
+          absl::StrCat(RESPONSE_PREFIX, code, SPACE, reason_phrase, CRLF);
+      http10_lines_[code - MinCode] =
+          absl::StrCat(HTTP_10_RESPONSE_PREFIX, code, SPACE, reason_phrase, CRLF);
+    }
+  }
+
+  /**
+   * @return the status line of a response with the given code, or an empty string if the code is
+   *         not preformatted.
+   */
+  absl::string_view get(uint64_t code, bool http10) const {
+    if (code < MinCode || code >= MaxCode) {
+      return {};
+    }
+    return http10 ? http10_lines_[code - MinCode] : http11_lines_[code - MinCode];
+  }
+
+private:
+  static constexpr uint64_t MinCode = 100;
+  static constexpr uint64_t MaxCode = 600;
+
+  std::array<std::string, MaxCode - MinCode> http11_lines_;
+  std::array<std::string, MaxCode - MinCode> http10_lines_;
+};
+
+using StatusLinesSingleton = ConstSingleton<StatusLines>;
+
+} // namespace
+
 void ResponseEncoderImpl::encodeHeaders(const ResponseHeaderMap& headers, bool end_stream) {
   started_response_ = true;
 
@@ -405,15 +488,24 @@ void ResponseEncoderImpl::encodeHeaders(const ResponseHeaderMap& headers, bool e
   ASSERT(headers.Status() != nullptr);
   uint64_t numeric_status = Utility::getResponseStatus(headers);
 
-  absl::string_view response_prefix;
-  if (connection_.protocol() == Protocol::Http10 && connection_.supportsHttp10()) {
-    response_prefix = HTTP_10_RESPONSE_PREFIX;
-  } else {
-    response_prefix = RESPONSE_PREFIX;
-  }
+  const bool http10 = connection_.protocol() == Protocol::Http10 && connection_.supportsHttp10();
 
   StatefulHeaderKeyFormatterOptConstRef formatter(headers.formatter());
 
+  if (numeric_status >= 300) {
+    // Don't do special CONNECT logic if the CONNECT was rejected.
+    is_response_to_connect_request_ = false;
+  }
+
+  if (!formatter.has_value() || formatter->getReasonPhrase().empty()) {
+    const absl::string_view status_line = StatusLinesSingleton::get().get(numeric_status, http10);
+    if (!status_line.empty()) {
+      encodeHeadersBase(headers, {status_line}, absl::make_optional<uint64_t>(numeric_status),
+                        end_stream, false);
+      return;
+    }
+  }
+
   absl::string_view reason_phrase;
   if (formatter.has_value() && !formatter->getReasonPhrase().empty()) {
     reason_phrase = formatter->getReasonPhrase();
@@ -423,15 +515,11 @@ void ResponseEncoderImpl::encodeHeaders(const ResponseHeaderMap& headers, bool e
     reason_phrase = {status_string, status_string_len};
   }
 
-  connection_.buffer().addFragments(
-      {response_prefix, absl::StrCat(numeric_status), SPACE, reason_phrase, CRLF});
-
-  if (numeric_status >= 300) {
-    // Don't do special CONNECT logic if the CONNECT was rejected.
-    is_response_to_connect_request_ = false;
-  }
-
-  encodeHeadersBase(headers, absl::make_optional<uint64_t>(numeric_status), end_stream, false);
+  const std::string status_string = absl::StrCat(numeric_status);
+  encodeHeadersBase(headers,
+                    {http10 ? HTTP_10_RESPONSE_PREFIX : RESPONSE_PREFIX, status_string, SPACE,
+                     reason_phrase, CRLF},
+                    absl::make_optional<uint64_t>(numeric_status), end_stream, false);
 }
 
 static constexpr absl::string_view REQUEST_POSTFIX = " HTTP/1.1\r\n";
@@ -486,8 +574,8 @@ Status RequestEncoderImpl::encodeHeaders(const RequestHeaderMap& headers, bool e
     std::string url = absl::StrCat(scheme->value().getStringView(), "://",
                                    host->value().getStringView(), path->value().getStringView());
     ENVOY_CONN_LOG(trace, "Sending fully qualified URL: {}", connection_.connection(), url);
-    connection_.buffer().addFragments(
-        {method->value().getStringView(), SPACE, url, REQUEST_POSTFIX});
+    encodeHeadersBase(headers, {method->value().getStringView(), SPACE, url, REQUEST_POSTFIX},
+                      absl::nullopt, end_stream, HeaderUtility::requestShouldHaveNoBody(headers));
   } else {
     absl::string_view host_or_path_view;
     if (is_connect) {
@@ -496,12 +584,10 @@ Status RequestEncoderImpl::encodeHeaders(const RequestHeaderMap& headers, bool e
       host_or_path_view = path->value().getStringView();
     }
 
-    connection_.buffer().addFragments(
-        {method->value().getStringView(), SPACE, host_or_path_view, REQUEST_POSTFIX});
+    encodeHeadersBase(headers,
+                      {method->value().getStringView(), SPACE, host_or_path_view, REQUEST_POSTFIX},
+                      absl::nullopt, end_stream, HeaderUtility::requestShouldHaveNoBody(headers));
   }
-
-  encodeHeadersBase(headers, absl::nullopt, end_stream,
-                    HeaderUtility::requestShouldHaveNoBody(headers));
   return okStatus();
 }
 
@@ -529,7 +615,8 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
       encode_only_header_key_formatter_(encodeOnlyFormatterFromSettings(settings)),
       processing_trailers_(false), handling_upgrade_(false), reset_stream_called_(false),
       deferred_end_stream_headers_(false), dispatching_(false), max_headers_kb_(max_headers_kb),
-      max_headers_count_(max_headers_count) {
+      max_headers_count_(max_headers_count),
+      intern_header_values_(type == MessageType::Response) {
   if (codec_settings_.use_balsa_parser_) {
     parser_ = std::make_unique<BalsaParser>(type, this, max_headers_kb_ * 1024, enableTrailers(),
                                             codec_settings_.allow_custom_methods_);
@@ -563,8 +650,20 @@ Status ConnectionImpl::completeCurrentHeader() {
     }
     current_header_field_.inlineTransform([](char c) { return absl::ascii_tolower(c); });
 
-    headers_or_trailers.addViaMove(std::move(current_header_field_),
-                                   std::move(current_header_value_));
+    InternedStringSharedPtr interned_value =
+        intern_header_values_
+            ? HeaderValueInterner::get().intern(current_header_value_.getStringView())
+            : nullptr;
+    if (interned_value != nullptr) {
+      // Share the interned value, keeping the storage of the current value for the next header.
+      HeaderString value;
+      value.setInterned(std::move(interned_value));
+      headers_or_trailers.addViaMove(std::move(current_header_field_), std::move(value));
+      current_header_value_.clear();
+    } else {
+      headers_or_trailers.addViaMove(std::move(current_header_field_),
+                                     std::move(current_header_value_));
+    }
   }
 
   // Check if the number of headers exceeds the limit.
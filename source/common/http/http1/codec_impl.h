@@ -92,8 +92,17 @@ public:
 
 protected:
   StreamEncoderImpl(ConnectionImpl& connection, StreamInfo::BytesMeterSharedPtr&& bytes_meter);
-  void encodeHeadersBase(const RequestOrResponseHeaderMap& headers, absl::optional<uint64_t> status,
-                         bool end_stream, bool bodiless_request);
+  /**
+   * Encodes the start line and the headers of a message.
+   * @param headers supplies the headers to encode.
+   * @param start_line supplies the fragments of the request or status line, including its CRLF.
+   * @param status supplies the status of a response.
+   * @param end_stream supplies whether the message has no body.
+   * @param bodiless_request supplies whether the message is a request which should have no body.
+   */
+  void encodeHeadersBase(const RequestOrResponseHeaderMap& headers,
+                         absl::Span<const absl::string_view> start_line,
+                         absl::optional<uint64_t> status, bool end_stream, bool bodiless_request);
   void encodeTrailersBase(const HeaderMap& headers);
 
   Buffer::BufferMemoryAccountSharedPtr buffer_memory_account_;
@@ -114,6 +123,20 @@ private:
    */
   void encodeHeader(absl::string_view key, absl::string_view value);
 
+  /**
+   * Called to encode the start line and the headers of a message with a single copy to the output
+   * buffer, when the header keys are not formatted.
+   * @param headers supplies the headers to encode.
+   * @param start_line supplies the fragments of the request or status line.
+   * @param framing_header_key supplies the key of the header added by the codec to frame the body,
+   *        or an empty string if there is none.
+   * @param framing_header_value supplies the value of the header added by the codec.
+   */
+  void encodeHeaderBlock(const RequestOrResponseHeaderMap& headers,
+                         absl::Span<const absl::string_view> start_line,
+                         absl::string_view framing_header_key,
+                         absl::string_view framing_header_value);
+
   /**
    * Called to finalize a stream encode.
    */
@@ -320,6 +343,9 @@ protected:
   StreamInfo::BytesMeterSharedPtr bytes_meter_before_stream_;
   const uint32_t max_headers_kb_;
   const uint32_t max_headers_count_;
+  // Whether the values of the headers received are interned, which is done for responses, as the
+  // responses of an upstream tend to repeat the same values.
+  const bool intern_header_values_;
 
 private:
   enum class HeaderParsingState { Field, Value, Done };
@@ -22,6 +22,7 @@
 #include "source/common/http/codes.h"
 #include "source/common/http/exception.h"
 #include "source/common/http/header_utility.h"
+#include "source/common/http/header_value_interner.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/http2/codec_stats.h"
 #include "source/common/http/utility.h"
@@ -1833,7 +1834,13 @@ ConnectionImpl::Http2Visitor::OnHeaderForStream(Http2StreamId stream_id,
   HeaderString name;
   name.setCopy(name_view.data(), name_view.size());
   HeaderString value;
-  value.setCopy(value_view.data(), value_view.size());
+  InternedStringSharedPtr interned_value =
+      connection_->intern_header_values_ ? HeaderValueInterner::get().intern(value_view) : nullptr;
+  if (interned_value != nullptr) {
+    value.setInterned(std::move(interned_value));
+  } else {
+    value.setCopy(value_view.data(), value_view.size());
+  }
   const int result = connection_->onHeader(stream_id, std::move(name), std::move(value));
   switch (result) {
   case 0:
@@ -2204,6 +2211,7 @@ ClientConnectionImpl::ClientConnectionImpl(
   }
   http2_session_factory.init(base(), http2_options);
   allow_metadata_ = http2_options.allow_metadata();
+  intern_header_values_ = true;
   idle_session_requires_ping_interval_ = std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
       http2_options.connection_keepalive(), connection_idle_interval, 0));
 }
@@ -724,6 +724,10 @@ protected:
   // Whether to use the new HTTP/2 library.
   bool use_oghttp2_library_;
 
+  // Whether the values of the headers received are interned, which is done by client connections,
+  // as the responses of an upstream tend to repeat the same values.
+  bool intern_header_values_{};
+
   // If deferred processing, the streams will be in LRU order based on when the
   // stream encoded to the http2 connection. The LRU property is used when
   // raising low watermark on the http2 connection to prioritize how streams get
@@ -1,6 +1,7 @@
 #include "source/common/json/json_sanitizer.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/json_escape_string.h"
 #include "source/common/common/thread.h"
 #include "source/common/json/json_internal.h"
 
@@ -52,13 +53,17 @@ absl::string_view sanitize(std::string& buffer, absl::string_view str) {
   // Fast-path to see whether any escapes or utf-encoding are needed. If str has
   // only unescaped ascii characters, we can simply return it.
   //
+  // The bulk of the string is scanned by blocks of 32 characters, and only the
+  // last characters, or the block containing a character requiring an escape,
+  // are looked up in the table.
+  //
   // Benchmarks show it's faster to just rip through the string with no
   // conditionals, so we only check the arithmetically ORed condition after the
   // loop. This avoids branches and allows simpler loop unrolling by the
   // compiler.
   static_assert(ARRAY_SIZE(needs_slow_sanitizer) == 256);
   uint32_t need_slow = 0;
-  for (char c : str) {
+  for (char c : str.substr(JsonEscaper::escapeFreePrefixLength(str, true))) {
     // We need to escape control characters, characters >= 127, and double-quote
     // and backslash.
     need_slow |= needs_slow_sanitizer[static_cast<uint8_t>(c)];
@@ -83,31 +83,35 @@ void ActiveTcpSocket::createListenerFilterBuffer() {
         continueFilterChain(false);
       },
       [this](Network::ListenerFilterBufferImpl& filter_buffer) {
-        Network::FilterStatus status = (*iter_)->onData(filter_buffer);
-        if (status == Network::FilterStatus::StopIteration) {
-          if (socket_->ioHandle().isOpen()) {
-            // The listener filter should not wait for more data when it has already received
-            // all the data it requested.
-            ASSERT(filter_buffer.rawSlice().len_ < (*iter_)->maxReadBytes());
-            // Check if the maxReadBytes is changed or not. If change,
-            // reset the buffer capacity.
-            if ((*iter_)->maxReadBytes() > filter_buffer.capacity()) {
-              filter_buffer.resetCapacity((*iter_)->maxReadBytes());
-              // Activate `Read` event manually in case the data already
-              // available in the socket buffer.
-              filter_buffer.activateFileEvent(Event::FileReadyType::Read);
-            }
-          } else {
-            // The filter closed the socket.
-            continueFilterChain(false);
-          }
-          return;
-        }
-        continueFilterChain(true);
+        onListenerFilterData(filter_buffer);
       },
       (*iter_)->maxReadBytes() == 0, (*iter_)->maxReadBytes());
 }
 
+void ActiveTcpSocket::onListenerFilterData(Network::ListenerFilterBufferImpl& filter_buffer) {
+  Network::FilterStatus status = (*iter_)->onData(filter_buffer);
+  if (status == Network::FilterStatus::StopIteration) {
+    if (socket_->ioHandle().isOpen()) {
+      // The listener filter should not wait for more data when it has already received
+      // all the data it requested.
+      ASSERT(filter_buffer.rawSlice().len_ < (*iter_)->maxReadBytes());
+      // Check if the maxReadBytes is changed or not. If change,
+      // reset the buffer capacity.
+      if ((*iter_)->maxReadBytes() > filter_buffer.capacity()) {
+        filter_buffer.resetCapacity((*iter_)->maxReadBytes());
+        // Activate `Read` event manually in case the data already
+        // available in the socket buffer.
+        filter_buffer.activateFileEvent(Event::FileReadyType::Read);
+      }
+    } else {
+      // The filter closed the socket.
+      continueFilterChain(false);
+    }
+    return;
+  }
+  continueFilterChain(true);
+}
+
 void ActiveTcpSocket::continueFilterChain(bool success) {
   if (success) {
     bool no_error = true;
@@ -141,12 +145,15 @@ void ActiveTcpSocket::continueFilterChain(bool success) {
             if (listener_filter_buffer_->capacity() < (*iter_)->maxReadBytes()) {
               listener_filter_buffer_->resetCapacity((*iter_)->maxReadBytes());
             }
-            if (listener_filter_buffer_ != nullptr) {
-              // There are two cases for activate event manually: One is
-              // the data is already available when connect, activate the read event to peek
-              // data from the socket . Another one is the data already
-              // peeked into the buffer when previous filter processing the data, then activate the
-              // read event to trigger the current filter callback to process the data.
+            if (listener_filter_buffer_->rawSlice().len_ > 0) {
+              // The data peeked for the previous filters is still in the buffer, which is large
+              // enough for the current filter: hand it to the current filter right away rather
+              // than peeking the same data again on another iteration of the event loop. Data
+              // which arrives later triggers a read event as usual.
+              onListenerFilterData(*listener_filter_buffer_);
+            } else {
+              // The data may already be available when connecting: activate the read event to
+              // peek data from the socket.
               listener_filter_buffer_->activateFileEvent(Event::FileReadyType::Read);
             }
           } else {
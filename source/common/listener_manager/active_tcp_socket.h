@@ -88,6 +88,7 @@ public:
 
 private:
   void createListenerFilterBuffer();
+  void onListenerFilterData(Network::ListenerFilterBufferImpl& filter_buffer);
 
   // The owner of this ActiveTcpSocket.
   ActiveStreamListenerBase& listener_;
@@ -1,5 +1,7 @@
 #include "source/common/listener_manager/filter_chain_manager_impl.h"
 
+#include <algorithm>
+
 #include "envoy/config/listener/v3/listener_components.pb.h"
 
 #include "source/common/common/cleanup.h"
@@ -362,6 +364,9 @@ absl::Status FilterChainManagerImpl::addFilterChainForServerNames(
   } else {
     for (const auto& server_name : server_names) {
       if (isWildcardServerName(server_name)) {
+        max_wildcard_server_name_labels_ =
+            std::max<size_t>(max_wildcard_server_name_labels_,
+                             std::count(server_name.begin(), server_name.end(), '.'));
         // Add mapping for the wildcard domain, i.e. ".example.com" for "*.example.com".
         RETURN_IF_NOT_OK(addFilterChainForApplicationProtocols(
             server_names_map[server_name.substr(1)][transport_protocol], application_protocols,
@@ -580,7 +585,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinatio
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName(
     const ServerNamesMap& server_names_map, const Network::ConnectionSocket& socket) const {
   ASSERT(absl::AsciiStrToLower(socket.requestedServerName()) == socket.requestedServerName());
-  const std::string server_name(socket.requestedServerName());
+  const absl::string_view server_name = socket.requestedServerName();
 
   // Match on exact server name, i.e. "www.example.com" for "www.example.com".
   const auto server_name_exact_match = server_names_map.find(server_name);
@@ -588,15 +593,21 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
     return findFilterChainForTransportProtocol(server_name_exact_match->second, socket);
   }
 
-  // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
+  // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com". The
+  // suffixes with more labels than any configured wildcard domain are not looked up.
   size_t pos = server_name.find('.', 1);
-  while (pos < server_name.size() - 1 && pos != std::string::npos) {
-    const std::string wildcard = server_name.substr(pos);
-    const auto server_name_wildcard_match = server_names_map.find(wildcard);
-    if (server_name_wildcard_match != server_names_map.end()) {
-      return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
+  if (max_wildcard_server_name_labels_ > 0 && pos != absl::string_view::npos) {
+    size_t suffix_labels = std::count(server_name.begin() + pos, server_name.end(), '.');
+    for (; pos < server_name.size() - 1 && pos != absl::string_view::npos;
+         pos = server_name.find('.', pos + 1), --suffix_labels) {
+      if (suffix_labels > max_wildcard_server_name_labels_) {
+        continue;
+      }
+      const auto server_name_wildcard_match = server_names_map.find(server_name.substr(pos));
+      if (server_name_wildcard_match != server_names_map.end()) {
+        return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
+      }
     }
-    pos = server_name.find('.', pos + 1);
   }
 
   // Match on a filter chain without server name requirements.
@@ -611,10 +622,9 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForTransportProtocol(
     const TransportProtocolsMap& transport_protocols_map,
     const Network::ConnectionSocket& socket) const {
-  const std::string transport_protocol(socket.detectedTransportProtocol());
-
   // Match on exact transport protocol, e.g. "tls".
-  const auto transport_protocol_match = transport_protocols_map.find(transport_protocol);
+  const auto transport_protocol_match =
+      transport_protocols_map.find(socket.detectedTransportProtocol());
   if (transport_protocol_match != transport_protocols_map.end()) {
     return findFilterChainForApplicationProtocols(transport_protocol_match->second, socket);
   }
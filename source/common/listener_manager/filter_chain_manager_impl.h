@@ -310,6 +310,9 @@ private:
   // Mapping of FilterChain's configured destination ports, IPs, server names, transport protocols
   // and application protocols, using structures defined above.
   DestinationPortsMap destination_ports_map_;
+  // The largest number of labels of the configured wildcard server names, e.g. 2 for
+  // "*.example.com", or 0 if there is none. Longer suffixes of a server name can't match them.
+  size_t max_wildcard_server_name_labels_{};
 
   const std::vector<Network::Address::InstanceConstSharedPtr>& addresses_;
   // This is the reference to a factory context which all the generations of listener share.
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "source/common/common/trie_lookup_table.h"
+#include "source/common/common/radix_tree.h"
 #include "source/common/matcher/map_matcher.h"
 
 namespace Envoy {
@@ -8,7 +8,8 @@ namespace Matcher {
 
 /**
  * Implementation of a trie match tree which resolves to the OnMatch with the longest matching
- * prefix.
+ * prefix. The prefixes are stored in a radix tree, which stays compact with many long prefixes
+ * (e.g. tens of thousands of paths).
  */
 template <class DataType> class PrefixMapMatcher : public MapMatcher<DataType> {
 public:
@@ -40,7 +41,7 @@ protected:
   }
 
 private:
-  TrieLookupTable<std::shared_ptr<OnMatch<DataType>>> children_;
+  RadixTree<std::shared_ptr<OnMatch<DataType>>> children_;
 };
 
 } // namespace Matcher
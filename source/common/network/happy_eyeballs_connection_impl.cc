@@ -1,5 +1,7 @@
 #include "source/common/network/happy_eyeballs_connection_impl.h"
 
+#include <algorithm>
+
 #include "envoy/network/address.h"
 
 #include "source/common/network/connection_impl.h"
@@ -21,7 +23,12 @@ HappyEyeballsConnectionProvider::HappyEyeballsConnectionProvider(
       address_list_(sortAddressesWithConfig(address_list, happy_eyeballs_config)),
       upstream_local_address_selector_(upstream_local_address_selector),
       socket_factory_(socket_factory), transport_socket_options_(transport_socket_options),
-      host_(host), options_(options) {}
+      host_(host), options_(options) {
+  if (happy_eyeballs_config.has_value() && happy_eyeballs_config->prefer_cached_address_family()) {
+    prefer_cached_family_ = true;
+    applyCachedFamily(address_list, happy_eyeballs_config.value());
+  }
+}
 
 bool HappyEyeballsConnectionProvider::hasNextConnection() {
   return next_address_ < address_list_.size();
@@ -52,6 +59,11 @@ size_t HappyEyeballsConnectionProvider::nextConnection() { return next_address_;
 size_t HappyEyeballsConnectionProvider::totalConnections() { return address_list_.size(); }
 
 namespace {
+
+// The lower bound of the attempt delay derived from a cached connect time, as recommended by
+// https://datatracker.ietf.org/doc/html/rfc8305#section-5.
+constexpr std::chrono::milliseconds MinCachedAttemptDelay{100};
+
 bool hasMatchingAddressFamily(const Address::InstanceConstSharedPtr& a,
                               const Address::InstanceConstSharedPtr& b) {
   return (a->type() == Address::Type::Ip && b->type() == Address::Type::Ip &&
@@ -65,6 +77,60 @@ bool hasMatchingIpVersion(const Address::IpVersion& ip_version,
 
 } // namespace
 
+void HappyEyeballsConnectionProvider::applyCachedFamily(
+    const std::vector<Address::InstanceConstSharedPtr>& address_list,
+    const envoy::config::cluster::v3::UpstreamConnectionOptions::HappyEyeballsConfig&
+        happy_eyeballs_config) {
+  const absl::optional<Upstream::HappyEyeballsOutcome> outcome = host_->happyEyeballsOutcome();
+  if (!outcome.has_value()) {
+    return;
+  }
+  const Address::IpVersion family = outcome->family_;
+  if (!hasMatchingIpVersion(family, address_list_[0])) {
+    if (std::none_of(address_list.begin(), address_list.end(),
+                     [&](const auto& val) { return hasMatchingIpVersion(family, val); })) {
+      // The host no longer resolves to addresses of the cached family.
+      return;
+    }
+    using envoy::config::cluster::v3::UpstreamConnectionOptions;
+    auto cached_config = happy_eyeballs_config;
+    cached_config.set_first_address_family_version(family == Address::IpVersion::v4
+                                                       ? UpstreamConnectionOptions::V4
+                                                       : UpstreamConnectionOptions::V6);
+    address_list_ = sortAddressesWithConfig(address_list, cached_config);
+    host_->cluster().trafficStats()->upstream_cx_happy_eyeballs_cached_family_.inc();
+  }
+  // The first attempt is expected to complete within the cached connect time, so the next address
+  // is attempted sooner than the default delay if it does not.
+  next_attempt_delay_ = std::clamp(2 * outcome->connect_time_, MinCachedAttemptDelay,
+                                   ConnectionProvider::DefaultNextAttemptDelay);
+  host_->cluster().trafficStats()->upstream_cx_happy_eyeballs_cached_delay_.inc();
+}
+
+void HappyEyeballsConnectionProvider::onConnectionAttemptComplete(
+    const ClientConnection& connection, bool success) {
+  if (!prefer_cached_family_) {
+    return;
+  }
+  const Address::InstanceConstSharedPtr& address =
+      connection.connectionInfoProvider().remoteAddress();
+  if (address == nullptr || address->type() != Address::Type::Ip) {
+    return;
+  }
+  if (success) {
+    const auto connect_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+        dispatcher_.timeSource().monotonicTime() - connection.streamInfo().startTimeMonotonic());
+    host_->setHappyEyeballsOutcome(
+        Upstream::HappyEyeballsOutcome{address->ip()->version(), connect_time});
+    return;
+  }
+  // Forget the cached family if connecting to it failed.
+  const absl::optional<Upstream::HappyEyeballsOutcome> outcome = host_->happyEyeballsOutcome();
+  if (outcome.has_value() && outcome->family_ == address->ip()->version()) {
+    host_->setHappyEyeballsOutcome(absl::nullopt);
+  }
+}
+
 std::vector<Address::InstanceConstSharedPtr> HappyEyeballsConnectionProvider::sortAddresses(
     const std::vector<Address::InstanceConstSharedPtr>& in) {
   std::vector<Address::InstanceConstSharedPtr> address_list;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/upstream/upstream.h"
 
@@ -32,6 +34,8 @@ public:
   ClientConnectionPtr createNextConnection(const uint64_t id) override;
   size_t nextConnection() override;
   size_t totalConnections() override;
+  std::chrono::milliseconds nextAttemptDelay() override { return next_attempt_delay_; }
+  void onConnectionAttemptComplete(const ClientConnection& connection, bool success) override;
   // Returns a new vector containing the contents of |address_list| sorted
   // with address families interleaved, as per Section 4 of RFC 8305, Happy
   // Eyeballs v2. It is assumed that the list must already be sorted as per
@@ -46,9 +50,15 @@ public:
           happy_eyeballs_config);
 
 private:
+  // Reorders the addresses and derives the attempt delay from the cached outcome of the host.
+  void applyCachedFamily(
+      const std::vector<Address::InstanceConstSharedPtr>& address_list,
+      const envoy::config::cluster::v3::UpstreamConnectionOptions::HappyEyeballsConfig&
+          happy_eyeballs_config);
+
   Event::Dispatcher& dispatcher_;
   // List of addresses to attempt to connect to.
-  const std::vector<Address::InstanceConstSharedPtr> address_list_;
+  std::vector<Address::InstanceConstSharedPtr> address_list_;
   const Upstream::UpstreamLocalAddressSelectorConstSharedPtr upstream_local_address_selector_;
   UpstreamTransportSocketFactory& socket_factory_;
   TransportSocketOptionsConstSharedPtr transport_socket_options_;
@@ -58,6 +68,9 @@ private:
   size_t next_address_ = 0;
   // True if the first connection has been created.
   bool first_connection_created_ = false;
+  // True if the outcome of the connection attempts is cached on the host.
+  bool prefer_cached_family_ = false;
+  std::chrono::milliseconds next_attempt_delay_{ConnectionProvider::DefaultNextAttemptDelay};
 };
 
 /**
@@ -22,6 +22,7 @@ public:
   bool wasConnected() const override;
   bool supportsMmsg() const override;
   bool supportsUdpGro() const override;
+  bool supportsAdaptiveReadSize() const override { return true; }
   Api::SysCallIntResult setOption(int level, int optname, const void* optval,
                                   socklen_t optlen) override;
   Api::SysCallIntResult getOption(int level, int optname, void* optval, socklen_t* optlen) override;
@@ -99,7 +99,9 @@ Api::IoCallUint64Result IoSocketHandleImpl::read(Buffer::Instance& buffer,
   if (max_length == 0) {
     return Api::ioCallUint64ResultNoError();
   }
-  Buffer::Reservation reservation = buffer.reserveForRead();
+  Buffer::Reservation reservation = max_length_opt.has_value()
+                                        ? buffer.reserveForReadWithMaxLength(max_length)
+                                        : buffer.reserveForRead();
   Api::IoCallUint64Result result = readv(std::min(reservation.length(), max_length),
                                          reservation.slices(), reservation.numSlices());
   uint64_t bytes_to_commit = result.ok() ? result.return_value_ : 0;
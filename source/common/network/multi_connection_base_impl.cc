@@ -450,7 +450,7 @@ void MultiConnectionBaseImpl::maybeScheduleNextAttempt() {
     return;
   }
   ENVOY_LOG(trace, "Scheduling next attempt.");
-  next_attempt_timer_->enableTimer(std::chrono::milliseconds(300));
+  next_attempt_timer_->enableTimer(connection_provider_->nextAttemptDelay());
 }
 
 void MultiConnectionBaseImpl::onEvent(ConnectionEvent event, ConnectionCallbacksWrapper* wrapper) {
@@ -458,12 +458,14 @@ void MultiConnectionBaseImpl::onEvent(ConnectionEvent event, ConnectionCallbacks
   case ConnectionEvent::Connected: {
     ENVOY_CONN_LOG_EVENT(debug, "multi_connection_cx_ok", "connection={}", *this,
                          connection_provider_->nextConnection());
+    connection_provider_->onConnectionAttemptComplete(wrapper->connection(), true);
     break;
   }
   case ConnectionEvent::LocalClose:
   case ConnectionEvent::RemoteClose: {
     ENVOY_CONN_LOG_EVENT(debug, "multi_connection_cx_attempt_failed", "connection={}", *this,
                          connection_provider_->nextConnection());
+    connection_provider_->onConnectionAttemptComplete(wrapper->connection(), false);
     // This connection attempt has failed. If possible, start another connection attempt
     // immediately, instead of waiting for the timer.
     if (connection_provider_->hasNextConnection()) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -47,6 +48,21 @@ public:
    *
    */
   virtual size_t totalConnections() PURE;
+
+  /**
+   * Return the delay before the next connection is attempted while the previous attempts are
+   * still in progress.
+   */
+  virtual std::chrono::milliseconds nextAttemptDelay() { return DefaultNextAttemptDelay; }
+
+  /**
+   * Called when a connection attempt succeeds or fails.
+   * @param connection supplies the connection created for the attempt.
+   * @param success whether the connection was established.
+   */
+  virtual void onConnectionAttemptComplete(const ClientConnection&, bool) {}
+
+  static constexpr std::chrono::milliseconds DefaultNextAttemptDelay{300};
 };
 
 using ConnectionProviderPtr = std::unique_ptr<ConnectionProvider>;
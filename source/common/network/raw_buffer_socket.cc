@@ -1,5 +1,7 @@
 #include "source/common/network/raw_buffer_socket.h"
 
+#include <algorithm>
+
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
@@ -8,6 +10,20 @@
 namespace Envoy {
 namespace Network {
 
+void AdaptiveReadSize::onRead(uint64_t bytes_read) {
+  if (bytes_read >= read_size_) {
+    read_size_ = std::min(read_size_ * 2, MaxReadSize);
+    short_reads_ = 0;
+  } else if (read_size_ > MinReadSize && bytes_read < read_size_ / 4) {
+    if (++short_reads_ == ShrinkAfterShortReads) {
+      read_size_ /= 2;
+      short_reads_ = 0;
+    }
+  } else {
+    short_reads_ = 0;
+  }
+}
+
 void RawBufferSocket::setTransportSocketCallbacks(TransportSocketCallbacks& callbacks) {
   ASSERT(!callbacks_);
   callbacks_ = &callbacks;
@@ -18,8 +34,12 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
   uint64_t bytes_read = 0;
   bool end_stream = false;
   absl::optional<Api::IoError::IoErrorCode> err = absl::nullopt;
+  const bool adaptive_read_size = callbacks_->ioHandle().supportsAdaptiveReadSize();
   do {
-    Api::IoCallUint64Result result = callbacks_->ioHandle().read(buffer, absl::nullopt);
+    // A read which is capped by the predicted size is followed by another one, so that a larger
+    // message is still read entirely, at the cost of a few more reads until the prediction grows.
+    Api::IoCallUint64Result result = callbacks_->ioHandle().read(
+        buffer, adaptive_read_size ? absl::make_optional(read_size_.readSize()) : absl::nullopt);
 
     if (result.ok()) {
       ENVOY_CONN_LOG(trace, "read returns: {}", callbacks_->connection(), result.return_value_);
@@ -28,6 +48,9 @@ IoResult RawBufferSocket::doRead(Buffer::Instance& buffer) {
         end_stream = true;
         break;
       }
+      if (adaptive_read_size) {
+        read_size_.onRead(result.return_value_);
+      }
       bytes_read += result.return_value_;
       if (callbacks_->shouldDrainReadBuffer()) {
         callbacks_->setTransportSocketIsReadable();
@@ -10,6 +10,32 @@
 namespace Envoy {
 namespace Network {
 
+/**
+ * Predicts the size of the next read of a connection from its recent reads, so that a connection
+ * which receives small messages reserves and reads a single buffer slice at a time rather than a
+ * full read reservation. A read which fills the predicted size doubles it, up to MaxReadSize, while
+ * the predicted size is halved after a few reads of less than a quarter of it.
+ */
+class AdaptiveReadSize {
+public:
+  uint64_t readSize() const { return read_size_; }
+
+  /**
+   * @param bytes_read supplies the number of bytes returned by a successful read.
+   */
+  void onRead(uint64_t bytes_read);
+
+  // The size of a buffer slice.
+  static constexpr uint64_t MinReadSize = 16 * 1024;
+  // The size of a full read reservation of a buffer.
+  static constexpr uint64_t MaxReadSize = Buffer::Reservation::MAX_SLICES_ * MinReadSize;
+  static constexpr uint32_t ShrinkAfterShortReads = 4;
+
+private:
+  uint64_t read_size_{MinReadSize};
+  uint32_t short_reads_{};
+};
+
 class RawBufferSocket : public TransportSocket, protected Logger::Loggable<Logger::Id::connection> {
 public:
   // Network::TransportSocket
@@ -31,6 +57,7 @@ protected:
 private:
   bool shutdown_{};
   TransportSocketCallbacks* callbacks_{};
+  AdaptiveReadSize read_size_;
 };
 
 class RawBufferSocketFactory : public DownstreamTransportSocketFactory,
@@ -18,6 +18,21 @@
 
 namespace Envoy {
 namespace Network {
+namespace {
+
+// The filter state objects read for every upstream connection are looked up through fixed slots.
+const StreamInfo::FilterState::InlineKey UpstreamServerNameKey =
+    StreamInfo::FilterState::registerInlineKey(UpstreamServerName::key());
+const StreamInfo::FilterState::InlineKey ApplicationProtocolsKey =
+    StreamInfo::FilterState::registerInlineKey(ApplicationProtocols::key());
+const StreamInfo::FilterState::InlineKey UpstreamSubjectAltNamesKey =
+    StreamInfo::FilterState::registerInlineKey(UpstreamSubjectAltNames::key());
+const StreamInfo::FilterState::InlineKey ProxyProtocolFilterStateKey =
+    StreamInfo::FilterState::registerInlineKey(ProxyProtocolFilterState::key());
+const StreamInfo::FilterState::InlineKey Http11ProxyInfoFilterStateKey =
+    StreamInfo::FilterState::registerInlineKey(Http11ProxyInfoFilterState::key());
+
+} // namespace
 
 void CommonUpstreamTransportSocketFactory::hashKey(
     std::vector<uint8_t>& key, TransportSocketOptionsConstSharedPtr options) const {
@@ -63,35 +78,35 @@ TransportSocketOptionsUtility::fromFilterState(const StreamInfo::FilterState& fi
   std::unique_ptr<const TransportSocketOptions::Http11ProxyInfo> proxy_info;
 
   bool needs_transport_socket_options = false;
-  if (auto typed_data = filter_state.getDataReadOnly<UpstreamServerName>(UpstreamServerName::key());
+  if (auto typed_data = filter_state.getDataReadOnly<UpstreamServerName>(UpstreamServerNameKey);
       typed_data != nullptr) {
     server_name = typed_data->value();
     needs_transport_socket_options = true;
   }
 
-  if (auto typed_data = filter_state.getDataReadOnly<Network::ApplicationProtocols>(
-          Network::ApplicationProtocols::key());
+  if (auto typed_data =
+          filter_state.getDataReadOnly<Network::ApplicationProtocols>(ApplicationProtocolsKey);
       typed_data != nullptr) {
     application_protocols = typed_data->value();
     needs_transport_socket_options = true;
   }
 
   if (auto typed_data =
-          filter_state.getDataReadOnly<UpstreamSubjectAltNames>(UpstreamSubjectAltNames::key());
+          filter_state.getDataReadOnly<UpstreamSubjectAltNames>(UpstreamSubjectAltNamesKey);
       typed_data != nullptr) {
     subject_alt_names = typed_data->value();
     needs_transport_socket_options = true;
   }
 
   if (auto typed_data =
-          filter_state.getDataReadOnly<ProxyProtocolFilterState>(ProxyProtocolFilterState::key());
+          filter_state.getDataReadOnly<ProxyProtocolFilterState>(ProxyProtocolFilterStateKey);
       typed_data != nullptr) {
     proxy_protocol_options.emplace(typed_data->value());
     needs_transport_socket_options = true;
   }
 
-  if (auto typed_data = filter_state.getDataReadOnly<Http11ProxyInfoFilterState>(
-          Http11ProxyInfoFilterState::key());
+  if (auto typed_data =
+          filter_state.getDataReadOnly<Http11ProxyInfoFilterState>(Http11ProxyInfoFilterStateKey);
       typed_data != nullptr) {
     proxy_info = std::make_unique<TransportSocketOptions::Http11ProxyInfo>(typed_data->hostname(),
                                                                            typed_data->address());
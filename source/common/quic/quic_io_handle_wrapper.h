@@ -86,6 +86,7 @@ public:
   }
   bool supportsMmsg() const override { return io_handle_.supportsMmsg(); }
   bool supportsUdpGro() const override { return io_handle_.supportsUdpGro(); }
+  bool supportsAdaptiveReadSize() const override { return io_handle_.supportsAdaptiveReadSize(); }
   Api::SysCallIntResult bind(Network::Address::InstanceConstSharedPtr address) override {
     return io_handle_.bind(address);
   }
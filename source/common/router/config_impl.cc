@@ -1,6 +1,7 @@
 #include "source/common/router/config_impl.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <map>
@@ -27,6 +28,7 @@
 #include "source/common/common/fmt.h"
 #include "source/common/common/hash.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/radix_tree.h"
 #include "source/common/common/regex.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/metadata.h"
@@ -54,6 +56,7 @@
 #include "source/extensions/path/rewrite/uri_template/uri_template_rewrite.h"
 
 #include "absl/container/inlined_vector.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 
 namespace Envoy {
@@ -843,6 +846,13 @@ RouteEntryImplBase::sanitizePathBeforePathMatching(const absl::string_view path)
   return ret;
 }
 
+absl::string_view
+RouteEntryImplBase::pathForMatching(const Http::RequestHeaderMap& headers) const {
+  // PathMatcher::match() removes the query and fragment as well.
+  return Http::PathUtil::removeQueryAndFragment(
+      sanitizePathBeforePathMatching(headers.getPathValue()));
+}
+
 bool RouteEntryImplBase::evaluateTlsContextMatch(const StreamInfo::StreamInfo& stream_info) const {
   bool matches = true;
 
@@ -1512,6 +1522,11 @@ absl::Status RouteEntryImplBase::validateClusters(
   return absl::OkStatus();
 }
 
+uint64_t RouteEntryImplBase::nextFilterDisabledCacheId() {
+  static std::atomic<uint64_t> next_id{1};
+  return next_id++;
+}
+
 absl::optional<bool> RouteEntryImplBase::filterDisabled(absl::string_view config_name) const {
   absl::optional<bool> result = per_filter_configs_->disabled(config_name);
   if (result.has_value()) {
@@ -1665,6 +1680,10 @@ PrefixRouteEntryImpl::currentUrlPathAfterRewrite(const Http::RequestHeaderMap& h
   return currentUrlPathAfterRewriteWithMatchedPath(headers, matcher());
 }
 
+bool PrefixRouteEntryImpl::prefixIsCaseSensitive() const {
+  return case_sensitive() || std::none_of(matcher().begin(), matcher().end(), absl::ascii_isalpha);
+}
+
 RouteConstSharedPtr PrefixRouteEntryImpl::matches(const Http::RequestHeaderMap& headers,
                                                   const StreamInfo::StreamInfo& stream_info,
                                                   uint64_t random_value) const {
@@ -2011,6 +2030,113 @@ VirtualHostImpl::VirtualHostImpl(
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+    buildRouteSets(factory_context.regexEngine());
+  }
+}
+
+namespace {
+
+bool canMatchInRegexSet(const RouteEntryImplBaseConstSharedPtr& route) {
+  const auto* regex_route = dynamic_cast<const RegexRouteEntryImpl*>(route.get());
+  return regex_route != nullptr && regex_route->usesRegexEngine();
+}
+
+bool canMatchInPrefixSet(const RouteEntryImplBaseConstSharedPtr& route) {
+  const auto* prefix_route = dynamic_cast<const PrefixRouteEntryImpl*>(route.get());
+  return prefix_route != nullptr && prefix_route->prefixIsCaseSensitive();
+}
+
+/**
+ * A run of regex routes whose path regexes are compiled into a set by the regex engine.
+ */
+class RegexRouteSet : public VirtualHostImpl::RouteSet {
+public:
+  RegexRouteSet(size_t begin, size_t end, const RouteEntryImplBase& first_route,
+                Regex::CompiledSetMatcherPtr matcher)
+      : RouteSet(begin, end, first_route), matcher_(std::move(matcher)) {}
+
+  size_t firstMatch(const Http::RequestHeaderMap& headers) const override {
+    return matcher_->firstMatch(first_route_.pathForMatching(headers)).value_or(end_ - begin_);
+  }
+
+private:
+  const Regex::CompiledSetMatcherPtr matcher_;
+};
+
+/**
+ * A run of prefix routes whose prefixes are stored in a radix tree.
+ */
+class PrefixRouteSet : public VirtualHostImpl::RouteSet {
+public:
+  PrefixRouteSet(size_t begin, size_t end,
+                 absl::Span<const RouteEntryImplBaseConstSharedPtr> routes)
+      : RouteSet(begin, end, *routes.front()) {
+    std::vector<std::pair<absl::string_view, size_t>> prefixes;
+    prefixes.reserve(routes.size());
+    for (size_t i = 0; i < routes.size(); ++i) {
+      prefixes.emplace_back(routes[i]->matcher(), i);
+    }
+    // Add the shorter prefixes first, so that the routes of the prefixes of each prefix are known
+    // when it is added.
+    std::stable_sort(prefixes.begin(), prefixes.end(), [](const auto& a, const auto& b) {
+      return a.first.size() < b.first.size();
+    });
+    for (const auto& [prefix, offset] : prefixes) {
+      const absl::optional<size_t> shorter_prefix_offset = prefixes_.findLongestPrefix(prefix);
+      // Keeps the first route of a duplicate prefix.
+      prefixes_.add(prefix, std::min(offset, shorter_prefix_offset.value_or(offset)), false);
+    }
+  }
+
+  size_t firstMatch(const Http::RequestHeaderMap& headers) const override {
+    return prefixes_.findLongestPrefix(first_route_.pathForMatching(headers))
+        .value_or(end_ - begin_);
+  }
+
+private:
+  // Maps each prefix to the offset of the first route whose prefix is a prefix of it, i.e. of the
+  // first route matching the paths for which it is the longest matching prefix.
+  RadixTree<absl::optional<size_t>> prefixes_;
+};
+
+} // namespace
+
+void VirtualHostImpl::buildRouteSets(Regex::Engine& engine) {
+  // Below this number of routes, matching the paths one by one is cheap enough.
+  constexpr size_t MinRoutesPerSet = 4;
+
+  size_t begin = 0;
+  while (begin < routes_.size()) {
+    const auto route_it = routes_.begin() + begin;
+    if (canMatchInRegexSet(*route_it)) {
+      const size_t end =
+          std::find_if_not(route_it, routes_.end(), canMatchInRegexSet) - routes_.begin();
+      if (end - begin >= MinRoutesPerSet) {
+        std::vector<std::string> regexes;
+        for (size_t i = begin; i < end; ++i) {
+          regexes.push_back(routes_[i]->matcher());
+        }
+        auto matcher_or_error = engine.setMatcher(regexes);
+        if (matcher_or_error.ok()) {
+          route_sets_.push_back(std::make_unique<RegexRouteSet>(
+              begin, end, **route_it, std::move(matcher_or_error.value())));
+        } else {
+          ENVOY_LOG(warn, "unable to compile the path regexes of routes {} to {} together: {}",
+                    begin, end - 1, matcher_or_error.status().message());
+        }
+      }
+      begin = end;
+    } else if (canMatchInPrefixSet(*route_it)) {
+      const size_t end =
+          std::find_if_not(route_it, routes_.end(), canMatchInPrefixSet) - routes_.begin();
+      if (end - begin >= MinRoutesPerSet) {
+        route_sets_.push_back(std::make_unique<PrefixRouteSet>(
+            begin, end, absl::MakeConstSpan(routes_).subspan(begin, end - begin)));
+      }
+      begin = end;
+    } else {
+      ++begin;
+    }
   }
 }
 
@@ -2019,13 +2145,25 @@ const VirtualHost& SslRedirectRoute::virtualHost() const { return *virtual_host_
 RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
     const RouteCallback& cb, const Http::RequestHeaderMap& headers,
     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
-    absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const {
-  for (auto route = routes.begin(); route != routes.end(); ++route) {
-    if (!headers.Path() && !(*route)->supportsPathlessHeaders()) {
+    absl::Span<const RouteEntryImplBaseConstSharedPtr> routes,
+    absl::Span<const RouteSetConstPtr> route_sets) const {
+  auto route_set = route_sets.begin();
+  for (size_t i = 0; i < routes.size(); ++i) {
+    if (route_set != route_sets.end() && i == (*route_set)->begin_) {
+      // Skip to the first route of the run whose path matches. If that route doesn't match the
+      // request, the following routes of the run are matched one by one.
+      i += (*route_set)->firstMatch(headers);
+      ++route_set;
+      if (i == routes.size()) {
+        break;
+      }
+    }
+    const RouteEntryImplBaseConstSharedPtr& route = routes[i];
+    if (!headers.Path() && !route->supportsPathlessHeaders()) {
       continue;
     }
 
-    RouteConstSharedPtr route_entry = (*route)->matches(headers, stream_info, random_value);
+    RouteConstSharedPtr route_entry = route->matches(headers, stream_info, random_value);
     if (route_entry == nullptr) {
       continue;
     }
@@ -2034,9 +2172,8 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
       return route_entry;
     }
 
-    RouteEvalStatus eval_status = (std::next(route) == routes.end())
-                                      ? RouteEvalStatus::NoMoreRoutes
-                                      : RouteEvalStatus::HasMoreRoutes;
+    RouteEvalStatus eval_status = (i + 1 == routes.size()) ? RouteEvalStatus::NoMoreRoutes
+                                                           : RouteEvalStatus::HasMoreRoutes;
     RouteMatchStatus match_status = cb(route_entry, eval_status);
     if (match_status == RouteMatchStatus::Accept) {
       return route_entry;
@@ -2102,7 +2239,7 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
   }
 
   // Check for a route that matches the request.
-  return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
+  return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_, route_sets_);
 }
 
 const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
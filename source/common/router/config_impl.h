@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "envoy/common/regex.h"
 #include "envoy/config/core/v3/base.pb.h"
 #include "envoy/config/route/v3/route.pb.h"
 #include "envoy/config/route/v3/route_components.pb.h"
@@ -401,20 +402,50 @@ public:
                                           const StreamInfo::StreamInfo& stream_info,
                                           uint64_t random_value) const;
 
+  /**
+   * A run of consecutive routes whose paths are matched together (e.g. regex routes whose regexes
+   * are compiled into a set), so that the routes whose path doesn't match are skipped without
+   * matching each of them.
+   */
+  class RouteSet {
+  public:
+    RouteSet(size_t begin, size_t end, const RouteEntryImplBase& first_route)
+        : begin_(begin), end_(end), first_route_(first_route) {}
+    virtual ~RouteSet() = default;
+
+    // Returns the offset in the run of the first route whose path matches the request, or the
+    // size of the run if there is none.
+    virtual size_t firstMatch(const Http::RequestHeaderMap& headers) const PURE;
+
+    // The index of the first route of the run, and the index following its last route.
+    const size_t begin_;
+    const size_t end_;
+
+  protected:
+    // The first route of the run, which provides the path the routes are matched against.
+    const RouteEntryImplBase& first_route_;
+  };
+  using RouteSetConstPtr = std::unique_ptr<const RouteSet>;
+
   RouteConstSharedPtr
   getRouteFromRoutes(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                      const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
-                     absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const;
+                     absl::Span<const RouteEntryImplBaseConstSharedPtr> routes,
+                     absl::Span<const RouteSetConstPtr> route_sets = {}) const;
 
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  void buildRouteSets(Regex::Engine& engine);
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  // Sorted by the index of their first route.
+  std::vector<RouteSetConstPtr> route_sets_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -828,6 +859,7 @@ public:
   const Decorator* decorator() const override { return decorator_.get(); }
   const RouteTracing* tracingConfig() const override { return route_tracing_.get(); }
   absl::optional<bool> filterDisabled(absl::string_view config_name) const override;
+  uint64_t filterDisabledCacheId() const override { return filter_disabled_cache_id_; }
   const RouteSpecificFilterConfig*
   mostSpecificPerFilterConfig(absl::string_view name) const override {
     auto* config = per_filter_configs_->get(name);
@@ -840,6 +872,9 @@ public:
   // path matching to ignore the path-parameters.
   absl::string_view sanitizePathBeforePathMatching(const absl::string_view path) const;
 
+  // Returns the part of the request path the path matcher is matched against.
+  absl::string_view pathForMatching(const Http::RequestHeaderMap& headers) const;
+
   class DynamicRouteEntry : public RouteEntryAndRoute {
   public:
     DynamicRouteEntry(const RouteEntryAndRoute* parent, RouteConstSharedPtr owner,
@@ -1051,6 +1086,7 @@ public:
       }
       return DynamicRouteEntry::filterDisabled(config_name);
     }
+    uint64_t filterDisabledCacheId() const override { return filter_disabled_cache_id_; }
     const RouteSpecificFilterConfig*
     mostSpecificPerFilterConfig(absl::string_view name) const override {
       auto* config = per_filter_configs_->get(name);
@@ -1075,6 +1111,7 @@ public:
     std::unique_ptr<PerFilterConfigs> per_filter_configs_;
     const std::string host_rewrite_;
     const Http::LowerCaseString cluster_header_name_;
+    const uint64_t filter_disabled_cache_id_{nextFilterDisabledCacheId()};
   };
 
   using WeightedClusterEntrySharedPtr = std::shared_ptr<WeightedClusterEntry>;
@@ -1131,6 +1168,9 @@ private:
     envoy::type::v3::FractionalPercent fractional_runtime_default_{};
   };
 
+  // Returns the filterDisabledCacheId() of a new route.
+  static uint64_t nextFilterDisabledCacheId();
+
   /**
    * Returns a vector of request header parsers which applied or will apply header transformations
    * to the request in this route.
@@ -1255,6 +1295,7 @@ private:
   const std::string route_name_;
   TimeSource& time_source_;
   EarlyDataPolicyPtr early_data_policy_;
+  const uint64_t filter_disabled_cache_id_{nextFilterDisabledCacheId()};
 
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   uint32_t retry_shadow_buffer_limit_{std::numeric_limits<uint32_t>::max()};
@@ -1327,6 +1368,10 @@ public:
   absl::optional<std::string>
   currentUrlPathAfterRewrite(const Http::RequestHeaderMap& headers) const override;
 
+  // Whether the prefix is compared to the path byte for byte, i.e. the route is case sensitive or
+  // the prefix has no letters.
+  bool prefixIsCaseSensitive() const;
+
 private:
   friend class RouteCreator;
   PrefixRouteEntryImpl(const CommonVirtualHostSharedPtr& vhost,
@@ -1397,6 +1442,13 @@ public:
   absl::optional<std::string>
   currentUrlPathAfterRewrite(const Http::RequestHeaderMap& headers) const override;
 
+  // Whether the path regex is compiled by the regex engine, rather than by RE2 through the
+  // deprecated google_re2 field.
+  bool usesRegexEngine() const {
+    return path_matcher_ != nullptr &&
+           !path_matcher_->matcher().matcher().safe_regex().has_google_re2();
+  }
+
 private:
   friend class RouteCreator;
   RegexRouteEntryImpl(const CommonVirtualHostSharedPtr& vhost,
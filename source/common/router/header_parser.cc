@@ -1,5 +1,7 @@
 #include "source/common/router/header_parser.h"
 
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <memory>
 #include <regex>
@@ -8,12 +10,15 @@
 #include "envoy/config/core/v3/base.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
 #include "source/common/formatter/substitution_formatter.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
 #include "source/common/json/json_loader.h"
 #include "source/common/protobuf/utility.h"
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 
@@ -22,8 +27,95 @@ namespace Router {
 
 namespace {
 
-absl::StatusOr<Formatter::FormatterPtr>
-parseHttpHeaderFormatter(const envoy::config::core::v3::HeaderValue& header_value) {
+// The commands whose value only depends on the downstream connection. The addresses are not among
+// them: the remote address may be overridden for each stream, e.g. from the x-forwarded-for header,
+// and both the direct remote and the local address of a QUIC connection change when it migrates.
+const absl::flat_hash_set<absl::string_view>& connectionCommands() {
+  CONSTRUCT_ON_FIRST_USE(absl::flat_hash_set<absl::string_view>,
+                         {"CONNECTION_ID",
+                          "DOWNSTREAM_LOCAL_DNS_SAN",
+                          "DOWNSTREAM_LOCAL_IP_SAN",
+                          "DOWNSTREAM_LOCAL_SUBJECT",
+                          "DOWNSTREAM_LOCAL_URI_SAN",
+                          "DOWNSTREAM_PEER_CERT",
+                          "DOWNSTREAM_PEER_CERT_V_END",
+                          "DOWNSTREAM_PEER_CERT_V_START",
+                          "DOWNSTREAM_PEER_DNS_SAN",
+                          "DOWNSTREAM_PEER_FINGERPRINT_1",
+                          "DOWNSTREAM_PEER_FINGERPRINT_256",
+                          "DOWNSTREAM_PEER_IP_SAN",
+                          "DOWNSTREAM_PEER_ISSUER",
+                          "DOWNSTREAM_PEER_SERIAL",
+                          "DOWNSTREAM_PEER_SUBJECT",
+                          "DOWNSTREAM_PEER_URI_SAN",
+                          "DOWNSTREAM_TLS_CIPHER",
+                          "DOWNSTREAM_TLS_SESSION_ID",
+                          "DOWNSTREAM_TLS_VERSION",
+                          "REQUESTED_SERVER_NAME"});
+}
+
+// Classifies a format string which was successfully parsed by the substitution formatter, by
+// scanning its commands: %COMMAND(ARGUMENT):LENGTH%, with '%%' escaping a '%'.
+HeadersToAddEntry::ValueScope valueScope(absl::string_view format) {
+  HeadersToAddEntry::ValueScope scope = HeadersToAddEntry::ValueScope::Constant;
+  for (size_t pos = format.find('%'); pos != absl::string_view::npos;
+       pos = format.find('%', pos)) {
+    if (pos + 1 < format.size() && format[pos + 1] == '%') {
+      pos += 2;
+      continue;
+    }
+    size_t end = format.find_first_of("(:%", pos + 1);
+    if (!connectionCommands().contains(format.substr(pos + 1, end - pos - 1))) {
+      return HeadersToAddEntry::ValueScope::Stream;
+    }
+    scope = HeadersToAddEntry::ValueScope::Connection;
+    if (format[end] == '(') {
+      // The argument may contain '%' but not ')'.
+      end = format.find(')', end);
+    }
+    pos = format.find('%', end) + 1;
+  }
+  return scope;
+}
+
+// The values of the headers of a worker thread which only depend on the downstream connection,
+// so that they are formatted once per connection rather than once per stream. As the streams of a
+// connection are all handled on the same worker, no locking is needed.
+class ConnectionValueCache {
+public:
+  static ConnectionValueCache& get() {
+    static thread_local ConnectionValueCache cache;
+    return cache;
+  }
+
+  // Returns the value of an entry for a connection, formatting it if it is not cached. The value
+  // is only valid until the next call.
+  absl::string_view value(const HeadersToAddEntry& entry, uint64_t connection_id,
+                          const Formatter::HttpFormatterContext& context,
+                          const StreamInfo::StreamInfo& stream_info) {
+    Slot& slot = slots_[absl::HashOf(entry.id_, connection_id) % Slots];
+    if (slot.entry_id_ != entry.id_ || slot.connection_id_ != connection_id) {
+      slot.entry_id_ = entry.id_;
+      slot.connection_id_ = connection_id;
+      slot.value_ = entry.formatter_->formatWithContext(context, stream_info);
+    }
+    return slot.value_;
+  }
+
+private:
+  static constexpr size_t Slots = 1024;
+
+  struct Slot {
+    uint64_t entry_id_{};
+    uint64_t connection_id_{};
+    std::string value_;
+  };
+
+  std::array<Slot, Slots> slots_;
+};
+
+absl::Status parseHttpHeaderFormatter(const envoy::config::core::v3::HeaderValue& header_value,
+                                      HeadersToAddEntry& entry) {
   const std::string& key = header_value.key();
   // PGV constraints provide this guarantee.
   ASSERT(!key.empty());
@@ -45,7 +137,17 @@ parseHttpHeaderFormatter(const envoy::config::core::v3::HeaderValue& header_valu
   final_header_value = HeaderParser::translatePerRequestState(final_header_value);
 
   // Let the substitution formatter parse the final_header_value.
-  return Envoy::Formatter::FormatterImpl::create(final_header_value, true);
+  auto formatter_or_error = Envoy::Formatter::FormatterImpl::create(final_header_value, true);
+  RETURN_IF_NOT_OK_REF(formatter_or_error.status());
+  entry.formatter_ = std::move(formatter_or_error.value());
+
+  static std::atomic<uint64_t> next_id{1};
+  entry.id_ = next_id++;
+  entry.value_scope_ = valueScope(final_header_value);
+  if (entry.value_scope_ == HeadersToAddEntry::ValueScope::Constant) {
+    entry.constant_value_ = absl::StrReplaceAll(final_header_value, {{"%%", "%"}});
+  }
+  return absl::OkStatus();
 }
 
 } // namespace
@@ -70,18 +172,15 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_optio
     append_action_ = header_value_option.append_action();
   }
 
-  auto formatter_or_error = parseHttpHeaderFormatter(header_value_option.header());
-  SET_AND_RETURN_IF_NOT_OK(formatter_or_error.status(), creation_status);
-  formatter_ = std::move(formatter_or_error.value());
+  SET_AND_RETURN_IF_NOT_OK(parseHttpHeaderFormatter(header_value_option.header(), *this),
+                           creation_status);
 }
 
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
                                      HeaderAppendAction append_action,
                                      absl::Status& creation_status)
     : original_value_(header_value.value()), append_action_(append_action) {
-  auto formatter_or_error = parseHttpHeaderFormatter(header_value);
-  SET_AND_RETURN_IF_NOT_OK(formatter_or_error.status(), creation_status);
-  formatter_ = std::move(formatter_or_error.value());
+  SET_AND_RETURN_IF_NOT_OK(parseHttpHeaderFormatter(header_value, *this), creation_status);
 }
 
 absl::StatusOr<HeaderParserPtr>
@@ -157,8 +256,17 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
   // header_formatter_speed_test.cc provides micro-benchmark for evaluating speed of adding and
   // replacing headers and should be used when modifying the code below to access the performance
   // impact of code changes.
-  absl::InlinedVector<std::pair<const Http::LowerCaseString&, const std::string>, 4> headers_to_add,
-      headers_to_overwrite;
+  // The values which are owned by the parser, either Constant ones or the original values when
+  // there is no stream_info, are referenced by the headers like the keys, rather than copied.
+  struct HeaderToSet {
+    const Http::LowerCaseString& key_;
+    // Whether the value is owned by the parser, in which case it is value_reference_ rather than
+    // formatted_value_.
+    const bool reference_value_;
+    const absl::string_view value_reference_;
+    const std::string formatted_value_;
+  };
+  absl::InlinedVector<HeaderToSet, 4> headers_to_add, headers_to_overwrite;
   // value_buffer is used only when stream_info is a valid pointer and stores header value
   // created by a formatter. It is declared outside of 'for' loop for performance reason to avoid
   // stack allocation and unnecessary std::string's memory adjustments for each iteration. The
@@ -167,23 +275,41 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
   // header_formatter_speed_test.cc this approach strikes the best balance between performance and
   // readability.
   std::string value_buffer;
+  const absl::optional<uint64_t> connection_id =
+      stream_info != nullptr ? stream_info->downstreamAddressProvider().connectionID()
+                             : absl::nullopt;
   for (const auto& [key, entry] : headers_to_add_) {
     absl::string_view value;
-    if (stream_info != nullptr) {
+    bool owned_value = true;
+    if (stream_info == nullptr) {
+      value = entry->original_value_;
+    } else if (entry->value_scope_ == HeadersToAddEntry::ValueScope::Constant) {
+      value = entry->constant_value_;
+    } else if (entry->value_scope_ == HeadersToAddEntry::ValueScope::Connection &&
+               connection_id.has_value()) {
+      value = ConnectionValueCache::get().value(*entry, *connection_id, context, *stream_info);
+      owned_value = false;
+    } else {
       value_buffer = entry->formatter_->formatWithContext(context, *stream_info);
       value = value_buffer;
-    } else {
-      value = entry->original_value_;
+      owned_value = false;
     }
     if (!value.empty() || entry->add_if_empty_) {
+      auto header_to_set = [&](absl::InlinedVector<HeaderToSet, 4>& headers_to_set) {
+        if (owned_value) {
+          headers_to_set.push_back({key, true, value, {}});
+        } else {
+          headers_to_set.push_back({key, false, {}, std::string(value)});
+        }
+      };
       switch (entry->append_action_) {
         PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
       case HeaderValueOption::APPEND_IF_EXISTS_OR_ADD:
-        headers_to_add.emplace_back(key, value);
+        header_to_set(headers_to_add);
         break;
       case HeaderValueOption::ADD_IF_ABSENT:
         if (auto header_entry = headers.get(key); header_entry.empty()) {
-          headers_to_add.emplace_back(key, value);
+          header_to_set(headers_to_add);
         }
         break;
       case HeaderValueOption::OVERWRITE_IF_EXISTS:
@@ -192,7 +318,7 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
         }
         FALLTHRU;
       case HeaderValueOption::OVERWRITE_IF_EXISTS_OR_ADD:
-        headers_to_overwrite.emplace_back(key, value);
+        header_to_set(headers_to_overwrite);
         break;
       }
     }
@@ -200,12 +326,20 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
 
   // First overwrite all headers which need to be overwritten.
   for (const auto& header : headers_to_overwrite) {
-    headers.setReferenceKey(header.first, header.second);
+    if (header.reference_value_) {
+      headers.setReference(header.key_, header.value_reference_);
+    } else {
+      headers.setReferenceKey(header.key_, header.formatted_value_);
+    }
   }
 
   // Now add headers which should be added.
   for (const auto& header : headers_to_add) {
-    headers.addReferenceKey(header.first, header.second);
+    if (header.reference_value_) {
+      headers.addReference(header.key_, header.value_reference_);
+    } else {
+      headers.addReferenceKey(header.key_, header.formatted_value_);
+    }
   }
 }
 
@@ -39,12 +39,30 @@ struct HeadersToAddEntry {
     return ret;
   }
 
+  // What the value of the header depends on, which determines how often it is formatted.
+  enum class ValueScope {
+    // The value has no command, so it is the same for all the streams.
+    Constant,
+    // The commands of the value only depend on the downstream connection, so the value is the same
+    // for all the streams of a connection.
+    Connection,
+    // The value is formatted for each stream.
+    Stream,
+  };
+
   std::string original_value_;
   bool add_if_empty_ = false;
 
   Formatter::FormatterPtr formatter_;
   HeaderAppendAction append_action_;
 
+  ValueScope value_scope_ = ValueScope::Stream;
+  // The value of a Constant header, as rendered by the formatter.
+  std::string constant_value_;
+  // Identifies the entry in the values cached per connection. Unlike the address of the entry, it
+  // is never reused.
+  uint64_t id_{};
+
 protected:
   HeadersToAddEntry(const HeaderValue& header_value, HeaderAppendAction append_action,
                     absl::Status& creation_status);
@@ -49,6 +49,12 @@ namespace Router {
 namespace {
 constexpr char NumInternalRedirectsFilterStateName[] = "num_internal_redirects";
 
+// The filter state objects read for every request are looked up through fixed slots.
+const StreamInfo::FilterState::InlineKey DebugConfigKey =
+    StreamInfo::FilterState::registerInlineKey(DebugConfig::key());
+const StreamInfo::FilterState::InlineKey UpstreamSocketOptionsKey =
+    StreamInfo::FilterState::registerInlineKey(Network::UpstreamSocketOptionsFilterState::key());
+
 uint32_t getLength(const Buffer::Instance* instance) { return instance ? instance->length() : 0; }
 
 bool schemeIsHttp(const Http::RequestHeaderMap& downstream_headers,
@@ -437,7 +443,7 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
   // we should append cluster and host headers to the response, and whether to forward the request
   // upstream.
   const StreamInfo::FilterStateSharedPtr& filter_state = callbacks_->streamInfo().filterState();
-  const DebugConfig* debug_config = filter_state->getDataReadOnly<DebugConfig>(DebugConfig::key());
+  const DebugConfig* debug_config = filter_state->getDataReadOnly<DebugConfig>(DebugConfigKey);
 
   // TODO: Maybe add a filter API for this.
   grpc_request_ = Grpc::Common::isGrpcRequestHeaders(headers);
@@ -632,7 +638,7 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
     if (auto typed_state = downstream_connection->streamInfo()
                                .filterState()
                                .getDataReadOnly<Network::UpstreamSocketOptionsFilterState>(
-                                   Network::UpstreamSocketOptionsFilterState::key());
+                                   UpstreamSocketOptionsKey);
         typed_state != nullptr) {
       auto downstream_options = typed_state->value();
       if (!upstream_options_) {
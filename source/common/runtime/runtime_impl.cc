@@ -123,7 +123,7 @@ bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value)
   } else if (cutoff == 100) {
     return true;
   } else {
-    return generator_.random() % 100 < cutoff;
+    return generator_.fastRandom() % 100 < cutoff;
   }
 }
 
@@ -144,7 +144,7 @@ Snapshot::ConstStringOptRef SnapshotImpl::get(absl::string_view key) const {
 
 bool SnapshotImpl::featureEnabled(absl::string_view key,
                                   const envoy::type::v3::FractionalPercent& default_value) const {
-  return featureEnabled(key, default_value, generator_.random());
+  return featureEnabled(key, default_value, generator_.fastRandom());
 }
 
 bool SnapshotImpl::featureEnabled(absl::string_view key,
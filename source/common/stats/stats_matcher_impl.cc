@@ -44,6 +44,7 @@ StatsMatcherImpl::StatsMatcherImpl(const envoy::config::metrics::v3::StatsConfig
     is_inclusive_ = true;
     break;
   }
+  optimizeRegexMatchers(context.regexEngine());
 }
 
 // If the last string-matcher added is a case-sensitive prefix match, and the
@@ -69,12 +70,56 @@ void StatsMatcherImpl::optimizeLastMatcher() {
   }
 }
 
+namespace {
+
+using StringMatcherImpl = Matchers::StringMatcherImpl<envoy::type::matcher::v3::StringMatcher>;
+
+// Whether the matcher is a regex compiled by the regex engine, which can then be compiled together
+// with the others by the engine. The deprecated google_re2 field always compiles with RE2.
+bool isEngineRegex(const StringMatcherImpl& matcher) {
+  return matcher.matcher().match_pattern_case() ==
+             envoy::type::matcher::v3::StringMatcher::MatchPatternCase::kSafeRegex &&
+         !matcher.matcher().safe_regex().has_google_re2();
+}
+
+} // namespace
+
+// Regex matchers are matched against every stat name which is not rejected by a prefix, so
+// matching all of them in a single pass avoids scanning the name once per regex. The individual
+// matchers are still created first, so that each regex is validated the same way.
+void StatsMatcherImpl::optimizeRegexMatchers(Regex::Engine& engine) {
+  std::vector<std::string> regexes;
+  for (const auto& matcher : matchers_) {
+    if (isEngineRegex(matcher)) {
+      regexes.push_back(matcher.matcher().safe_regex().regex());
+    }
+  }
+  if (regexes.size() < 2) {
+    return;
+  }
+  auto regex_set_or_error = engine.setMatcher(regexes);
+  if (!regex_set_or_error.ok()) {
+    ENVOY_LOG_MISC(warn, "unable to compile the stats matcher regexes together: {}",
+                   regex_set_or_error.status().message());
+    return;
+  }
+  regex_set_ = std::move(regex_set_or_error.value());
+
+  std::vector<StringMatcherImpl> matchers;
+  for (auto& matcher : matchers_) {
+    if (!isEngineRegex(matcher)) {
+      matchers.push_back(std::move(matcher));
+    }
+  }
+  matchers_ = std::move(matchers);
+}
+
 StatsMatcher::FastResult StatsMatcherImpl::fastRejects(StatName stat_name) const {
   if (rejectsAll()) {
     return FastResult::Rejects;
   }
   bool matches = fastRejectMatch(stat_name);
-  if ((is_inclusive_ || matchers_.empty()) && matches == is_inclusive_) {
+  if ((is_inclusive_ || !hasSlowMatchers()) && matches == is_inclusive_) {
     // We can short-circuit the slow matchers only if they are empty, or if
     // we are in inclusive-mode and we find a match.
     return FastResult::Rejects;
@@ -109,11 +154,12 @@ bool StatsMatcherImpl::slowRejects(FastResult fast_result, StatName stat_name) c
 }
 
 bool StatsMatcherImpl::slowRejectMatch(StatName stat_name) const {
-  if (matchers_.empty()) {
+  if (!hasSlowMatchers()) {
     return false;
   }
   std::string name = symbol_table_->toString(stat_name);
-  return std::any_of(matchers_.begin(), matchers_.end(),
+  return (regex_set_ != nullptr && regex_set_->matchAny(name)) ||
+         std::any_of(matchers_.begin(), matchers_.end(),
                      [&name](auto& matcher) { return matcher.match(name); });
 }
 
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "envoy/common/optref.h"
+#include "envoy/common/regex.h"
 #include "envoy/config/metrics/v3/stats.pb.h"
 #include "envoy/stats/stats_matcher.h"
 
@@ -34,14 +35,16 @@ public:
   FastResult fastRejects(StatName name) const override;
   bool slowRejects(FastResult, StatName name) const override;
   bool acceptsAll() const override {
-    return is_inclusive_ && matchers_.empty() && prefixes_.empty();
+    return is_inclusive_ && !hasSlowMatchers() && prefixes_.empty();
   }
   bool rejectsAll() const override {
-    return !is_inclusive_ && matchers_.empty() && prefixes_.empty();
+    return !is_inclusive_ && !hasSlowMatchers() && prefixes_.empty();
   }
 
 private:
   void optimizeLastMatcher();
+  void optimizeRegexMatchers(Regex::Engine& engine);
+  bool hasSlowMatchers() const { return !matchers_.empty() || regex_set_ != nullptr; }
   bool fastRejectMatch(StatName name) const;
   bool slowRejectMatch(StatName name) const;
 
@@ -54,6 +57,8 @@ private:
 
   std::vector<Matchers::StringMatcherImpl<envoy::type::matcher::v3::StringMatcher>> matchers_;
   std::vector<StatName> prefixes_;
+  // The regex matchers of matchers_, compiled together when there are several of them.
+  Regex::CompiledSetMatcherPtr regex_set_;
 };
 
 } // namespace Stats
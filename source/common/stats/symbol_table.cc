@@ -340,6 +340,25 @@ std::string SymbolTable::toString(const StatName& stat_name) const {
   return absl::StrJoin(decodeStrings(stat_name), ".");
 }
 
+void SymbolTable::appendTo(const StatName& stat_name, std::string& out) const {
+  using TokenIter = Encoding::TokenIter;
+  TokenIter iter(stat_name);
+  bool first = true;
+  Thread::LockGuard lock(lock_);
+  for (TokenIter::TokenType type = iter.next(); type != TokenIter::TokenType::End;
+       type = iter.next()) {
+    if (!first) {
+      out.push_back('.');
+    }
+    first = false;
+    if (type == TokenIter::TokenType::StringView) {
+      out.append(iter.stringView());
+    } else {
+      out.append(fromSymbol(iter.symbol()));
+    }
+  }
+}
+
 void SymbolTable::incRefCount(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
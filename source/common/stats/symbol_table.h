@@ -218,6 +218,16 @@ public:
    */
   std::string toString(const StatName& stat_name) const;
 
+  /**
+   * Appends the period-delimited stat name to a string. Unlike toString(), this
+   * does not allocate when the string has enough capacity, so that a caller
+   * formatting many stats into a reused string does not allocate per stat.
+   *
+   * @param stat_name the stat name.
+   * @param out the string to append the stat name to.
+   */
+  void appendTo(const StatName& stat_name, std::string& out) const;
+
   /**
    * @return uint64_t the number of symbols in the symbol table.
    */
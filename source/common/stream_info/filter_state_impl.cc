@@ -4,6 +4,20 @@
 
 namespace Envoy {
 namespace StreamInfo {
+namespace {
+
+// The descriptor of the data stored before the well-known data names are finalized, which is
+// all kept by name.
+FilterState::InlineKeyDescriptor& nameOnlyKeyDescriptor() {
+  static FilterState::InlineKeyDescriptor* descriptor = [] {
+    auto* descriptor = new FilterState::InlineKeyDescriptor();
+    descriptor->finalize();
+    return descriptor;
+  }();
+  return *descriptor;
+}
+
+} // namespace
 
 void FilterStateImpl::maybeCreateParent(FilterStateSharedPtr ancestor) {
   // If we already have a parent, or we're at the top span, we don't need to create
@@ -31,6 +45,36 @@ void FilterStateImpl::maybeCreateParent(FilterStateSharedPtr ancestor) {
   parent_ = std::make_shared<FilterStateImpl>(std::move(ancestor), parent_life_span);
 }
 
+template <class Key>
+FilterStateImpl::FilterObject* FilterStateImpl::findLocalObject(const Key& key) const {
+  if (data_storage_ == nullptr) {
+    return nullptr;
+  }
+  const auto object = data_storage_->get(key);
+  return object.has_value() ? object->get() : nullptr;
+}
+
+template <class LocalKey, class Key>
+std::shared_ptr<FilterState::Object>
+FilterStateImpl::getDataSharedMutableInternal(const LocalKey& local_key, const Key& key) {
+  FilterStateImpl::FilterObject* current = findLocalObject(local_key);
+
+  if (current == nullptr) {
+    if (parent_) {
+      return parent_->getDataSharedMutableGeneric(key);
+    }
+    return nullptr;
+  }
+
+  if (current->state_type_ == FilterState::StateType::ReadOnly) {
+    IS_ENVOY_BUG("FilterStateAccessViolation: FilterState accessed immutable data as mutable.");
+    // To reduce the chances of a crash, allow the mutation in this case instead of returning a
+    // nullptr.
+  }
+
+  return current->data_;
+}
+
 void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Object> data,
                               FilterState::StateType state_type, FilterState::LifeSpan life_span,
                               StreamSharingMayImpactPooling stream_sharing) {
@@ -52,12 +96,11 @@ void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Objec
                  "conflicting life_span on the same data_name.");
     return;
   }
-  const auto& it = data_storage_.find(data_name);
-  if (it != data_storage_.end()) {
+  const FilterStateImpl::FilterObject* current = findLocalObject(data_name);
+  if (current != nullptr) {
     // We have another object with same data_name. Check for mutability
     // violations namely: readonly data cannot be overwritten, mutable data
     // cannot be overwritten by readonly data.
-    const FilterStateImpl::FilterObject* current = it->second.get();
     if (current->state_type_ == FilterState::StateType::ReadOnly) {
       IS_ENVOY_BUG("FilterStateAccessViolation: FilterState::setData<T> called twice on same "
                    "ReadOnly state.");
@@ -75,7 +118,13 @@ void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Objec
   filter_object->data_ = data;
   filter_object->state_type_ = state_type;
   filter_object->stream_sharing_ = stream_sharing;
-  data_storage_[data_name] = std::move(filter_object);
+  if (data_storage_ == nullptr) {
+    // The slots are only used once the names are finalized, see finalizeInlineKeys().
+    inline_slots_ = inlineKeyDescriptor().finalized();
+    data_storage_ =
+        DataStorage::create(inline_slots_ ? inlineKeyDescriptor() : nameOnlyKeyDescriptor());
+  }
+  (*data_storage_)[data_name] = std::move(filter_object);
 }
 
 bool FilterStateImpl::hasDataWithName(absl::string_view data_name) const {
@@ -84,16 +133,32 @@ bool FilterStateImpl::hasDataWithName(absl::string_view data_name) const {
 
 const FilterState::Object*
 FilterStateImpl::getDataReadOnlyGeneric(absl::string_view data_name) const {
-  const auto it = data_storage_.find(data_name);
+  const FilterStateImpl::FilterObject* current = findLocalObject(data_name);
 
-  if (it == data_storage_.end()) {
+  if (current == nullptr) {
     if (parent_) {
       return parent_->getDataReadOnlyGeneric(data_name);
     }
     return nullptr;
   }
 
-  const FilterStateImpl::FilterObject* current = it->second.get();
+  return current->data_.get();
+}
+
+const FilterState::Object*
+FilterStateImpl::getDataReadOnlyGeneric(const InlineKey& data_key) const {
+  if (!data_key.handle().has_value() || (data_storage_ != nullptr && !inline_slots_)) {
+    return getDataReadOnlyGeneric(data_key.name());
+  }
+  const FilterStateImpl::FilterObject* current = findLocalObject(*data_key.handle());
+
+  if (current == nullptr) {
+    if (parent_) {
+      return parent_->getDataReadOnlyGeneric(data_key);
+    }
+    return nullptr;
+  }
+
   return current->data_.get();
 }
 
@@ -103,53 +168,51 @@ FilterState::Object* FilterStateImpl::getDataMutableGeneric(absl::string_view da
 
 std::shared_ptr<FilterState::Object>
 FilterStateImpl::getDataSharedMutableGeneric(absl::string_view data_name) {
-  const auto& it = data_storage_.find(data_name);
-
-  if (it == data_storage_.end()) {
-    if (parent_) {
-      return parent_->getDataSharedMutableGeneric(data_name);
-    }
-    return nullptr;
-  }
+  return getDataSharedMutableInternal(data_name, data_name);
+}
 
-  FilterStateImpl::FilterObject* current = it->second.get();
-  if (current->state_type_ == FilterState::StateType::ReadOnly) {
-    IS_ENVOY_BUG("FilterStateAccessViolation: FilterState accessed immutable data as mutable.");
-    // To reduce the chances of a crash, allow the mutation in this case instead of returning a
-    // nullptr.
+std::shared_ptr<FilterState::Object>
+FilterStateImpl::getDataSharedMutableGeneric(const InlineKey& data_key) {
+  if (!data_key.handle().has_value() || (data_storage_ != nullptr && !inline_slots_)) {
+    return getDataSharedMutableGeneric(data_key.name());
   }
-
-  return current->data_;
+  return getDataSharedMutableInternal(*data_key.handle(), data_key);
 }
 
 bool FilterStateImpl::hasDataAtOrAboveLifeSpan(FilterState::LifeSpan life_span) const {
   if (life_span > life_span_) {
     return parent_ && parent_->hasDataAtOrAboveLifeSpan(life_span);
   }
-  return !data_storage_.empty() || (parent_ && parent_->hasDataAtOrAboveLifeSpan(life_span));
+  return (data_storage_ != nullptr && !data_storage_->empty()) ||
+         (parent_ && parent_->hasDataAtOrAboveLifeSpan(life_span));
 }
 
 FilterState::ObjectsPtr FilterStateImpl::objectsSharedWithUpstreamConnection() const {
   auto objects = parent_ ? parent_->objectsSharedWithUpstreamConnection()
                          : std::make_unique<FilterState::Objects>();
-  for (const auto& [name, object] : data_storage_) {
-    switch (object->stream_sharing_) {
-    case StreamSharingMayImpactPooling::SharedWithUpstreamConnection:
-      objects->push_back({object->data_, object->state_type_, object->stream_sharing_, name});
-      break;
-    case StreamSharingMayImpactPooling::SharedWithUpstreamConnectionOnce:
-      objects->push_back(
-          {object->data_, object->state_type_, StreamSharingMayImpactPooling::None, name});
-      break;
-    default:
-      break;
-    }
+  if (data_storage_ == nullptr) {
+    return objects;
   }
+  data_storage_->iterate(
+      [&objects](const std::string& name, const std::unique_ptr<FilterObject>& object) {
+        switch (object->stream_sharing_) {
+        case StreamSharingMayImpactPooling::SharedWithUpstreamConnection:
+          objects->push_back({object->data_, object->state_type_, object->stream_sharing_, name});
+          break;
+        case StreamSharingMayImpactPooling::SharedWithUpstreamConnectionOnce:
+          objects->push_back(
+              {object->data_, object->state_type_, StreamSharingMayImpactPooling::None, name});
+          break;
+        default:
+          break;
+        }
+        return true;
+      });
   return objects;
 }
 
 bool FilterStateImpl::hasDataWithNameInternally(absl::string_view data_name) const {
-  return data_storage_.contains(data_name);
+  return findLocalObject(data_name) != nullptr;
 }
 
 } // namespace StreamInfo
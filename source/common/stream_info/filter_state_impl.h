@@ -6,7 +6,8 @@
 
 #include "envoy/stream_info/filter_state.h"
 
-#include "absl/container/flat_hash_map.h"
+#include "source/common/common/inline_map.h"
+
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -39,8 +40,10 @@ public:
       StreamSharingMayImpactPooling stream_sharing = StreamSharingMayImpactPooling::None) override;
   bool hasDataWithName(absl::string_view) const override;
   const Object* getDataReadOnlyGeneric(absl::string_view data_name) const override;
+  const Object* getDataReadOnlyGeneric(const InlineKey& data_key) const override;
   Object* getDataMutableGeneric(absl::string_view data_name) override;
   std::shared_ptr<Object> getDataSharedMutableGeneric(absl::string_view data_name) override;
+  std::shared_ptr<Object> getDataSharedMutableGeneric(const InlineKey& data_key) override;
   bool hasDataAtOrAboveLifeSpan(FilterState::LifeSpan life_span) const override;
   FilterState::ObjectsPtr objectsSharedWithUpstreamConnection() const override;
 
@@ -48,13 +51,24 @@ public:
   FilterStateSharedPtr parent() const override { return parent_; }
 
 private:
+  using DataStorage = InlineMap<std::string, std::unique_ptr<FilterObject>>;
+
   // This only checks the local data_storage_ for data_name existence.
   bool hasDataWithNameInternally(absl::string_view data_name) const;
   void maybeCreateParent(FilterStateSharedPtr ancestor);
+  // Returns the local object with the given name or handle, if any.
+  template <class Key> FilterObject* findLocalObject(const Key& key) const;
+  // Looks the object up locally with local_key, and in the parents with key.
+  template <class LocalKey, class Key>
+  std::shared_ptr<Object> getDataSharedMutableInternal(const LocalKey& local_key, const Key& key);
 
   FilterStateSharedPtr parent_;
   const FilterState::LifeSpan life_span_;
-  absl::flat_hash_map<std::string, std::unique_ptr<FilterObject>> data_storage_;
+  // Whether data_storage_ keeps the well-known data names registered with registerInlineKey() in
+  // fixed slots, which is the case once they are finalized, see finalizeInlineKeys().
+  bool inline_slots_{};
+  // Created when the first object is stored.
+  std::unique_ptr<DataStorage> data_storage_;
 };
 
 } // namespace StreamInfo
@@ -342,6 +342,9 @@ struct StreamInfoImpl : public StreamInfo {
   absl::optional<uint32_t> attemptCount() const override { return attempt_count_; }
 
   const BytesMeterSharedPtr& getUpstreamBytesMeter() const override {
+    if (upstream_bytes_meter_ == nullptr) {
+      upstream_bytes_meter_ = std::make_shared<BytesMeter>();
+    }
     return upstream_bytes_meter_;
   }
 
@@ -350,7 +353,9 @@ struct StreamInfoImpl : public StreamInfo {
   }
 
   void setUpstreamBytesMeter(const BytesMeterSharedPtr& upstream_bytes_meter) override {
-    upstream_bytes_meter->captureExistingBytesMeter(*upstream_bytes_meter_);
+    if (upstream_bytes_meter_ != nullptr) {
+      upstream_bytes_meter->captureExistingBytesMeter(*upstream_bytes_meter_);
+    }
     upstream_bytes_meter_ = upstream_bytes_meter;
   }
 
@@ -490,15 +495,17 @@ private:
   StreamIdProviderSharedPtr stream_id_provider_;
   absl::optional<DownstreamTiming> downstream_timing_;
   absl::optional<Upstream::ClusterInfoConstSharedPtr> upstream_cluster_info_;
-  Tracing::Reason trace_reason_;
-  // Default construct the object because upstream stream is not constructed in some cases.
-  BytesMeterSharedPtr upstream_bytes_meter_{std::make_shared<BytesMeter>()};
+  // Constructed on first use, as the upstream stream is not constructed in some cases and most
+  // streams which have one replace it with the meter of their upstream request.
+  mutable BytesMeterSharedPtr upstream_bytes_meter_;
   BytesMeterSharedPtr downstream_bytes_meter_;
-  bool is_shadow_{false};
   std::string downstream_transport_failure_reason_;
+  OptRef<const StreamInfo> parent_stream_info_;
+  // The small fields are kept together to avoid padding between the larger ones.
+  Tracing::Reason trace_reason_;
+  bool is_shadow_{false};
   bool should_scheme_match_upstream_{false};
   bool should_drain_connection_{false};
-  OptRef<const StreamInfo> parent_stream_info_;
 };
 
 } // namespace StreamInfo
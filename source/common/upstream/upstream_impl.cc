@@ -1,5 +1,6 @@
 #include "source/common/upstream/upstream_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <limits>
@@ -486,6 +487,26 @@ Network::UpstreamTransportSocketFactory& HostDescriptionImplBase::resolveTranspo
   return match.factory_;
 }
 
+absl::optional<HappyEyeballsOutcome> HostDescriptionImplBase::happyEyeballsOutcome() const {
+  const uint64_t packed = happy_eyeballs_outcome_.load(std::memory_order_relaxed);
+  if (packed == 0) {
+    return absl::nullopt;
+  }
+  return HappyEyeballsOutcome{(packed & 3) == 1 ? Network::Address::IpVersion::v4
+                                                : Network::Address::IpVersion::v6,
+                              std::chrono::milliseconds(packed >> 2)};
+}
+
+void HostDescriptionImplBase::setHappyEyeballsOutcome(
+    absl::optional<HappyEyeballsOutcome> outcome) const {
+  uint64_t packed = 0;
+  if (outcome.has_value()) {
+    const uint64_t connect_ms = std::max<int64_t>(outcome->connect_time_.count(), 0);
+    packed = (connect_ms << 2) | (outcome->family_ == Network::Address::IpVersion::v4 ? 1 : 2);
+  }
+  happy_eyeballs_outcome_.store(packed, std::memory_order_relaxed);
+}
+
 Host::CreateConnectionData HostImplBase::createConnection(
     Event::Dispatcher& dispatcher, const Network::ConnectionSocket::OptionsSharedPtr& options,
     Network::TransportSocketOptionsConstSharedPtr transport_socket_options) const {
@@ -249,6 +249,9 @@ public:
     last_hc_pass_time_.emplace(std::move(last_hc_pass_time));
   }
 
+  absl::optional<HappyEyeballsOutcome> happyEyeballsOutcome() const override;
+  void setHappyEyeballsOutcome(absl::optional<HappyEyeballsOutcome> outcome) const override;
+
 protected:
   /**
    * @return nullptr if address_list is empty, otherwise a shared_ptr copy of address_list.
@@ -276,6 +279,9 @@ private:
       socket_factory_ ABSL_GUARDED_BY(metadata_mutex_);
   const MonotonicTime creation_time_;
   absl::optional<MonotonicTime> last_hc_pass_time_;
+  // The packed HappyEyeballsOutcome: the connect time in milliseconds shifted left by two bits,
+  // or'ed with 1 for IPv4 and 2 for IPv6. 0 when there is no outcome.
+  mutable std::atomic<uint64_t> happy_eyeballs_outcome_{0};
 };
 
 /**
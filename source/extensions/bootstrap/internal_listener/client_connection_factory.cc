@@ -18,6 +18,7 @@ ThreadLocal::TypedSlot<Bootstrap::InternalListener::ThreadLocalRegistryImpl>*
 // The default buffer size is 1024 KiB.
 uint32_t InternalClientConnectionFactory::buffer_size_ =
     InternalClientConnectionFactory::DefaultBufferSize;
+bool InternalClientConnectionFactory::zero_copy_writes_ = false;
 
 Network::ClientConnectionPtr InternalClientConnectionFactory::createClientConnection(
     Event::Dispatcher& dispatcher, Network::Address::InstanceConstSharedPtr address,
@@ -32,7 +33,7 @@ Network::ClientConnectionPtr InternalClientConnectionFactory::createClientConnec
   ENVOY_LOG(debug, "Internal client connection buffer size {}.", buffer_size_);
   auto [io_handle_client, io_handle_server] =
       Extensions::IoSocket::UserSpace::IoHandleFactory::createBufferLimitedIoHandlePair(
-          buffer_size_);
+          buffer_size_, zero_copy_writes_);
 
   auto client_conn = std::make_unique<Network::ClientConnectionImpl>(
       dispatcher,
@@ -40,6 +40,9 @@ public:
   // client connection. Thus the ownership is not followed - client factory needs to
   // access buffer_size config of listener registry.
   static uint32_t buffer_size_;
+  // Whether the internal client connections move whole buffer slices between the peers. Static for
+  // the same reason as buffer_size_.
+  static bool zero_copy_writes_;
   // The default buffer is 1024 K bytes.
   static constexpr uint32_t DefaultBufferSize = 1024;
 };
@@ -16,7 +16,8 @@ InternalListenerExtension::InternalListenerExtension(
     Server::Configuration::ServerFactoryContext& server_context,
     const envoy::extensions::bootstrap::internal_listener::v3::InternalListener& config)
     : server_context_(server_context),
-      tls_registry_(std::make_shared<TlsInternalListenerRegistry>()) {
+      tls_registry_(std::make_shared<TlsInternalListenerRegistry>()),
+      zero_copy_writes_(config.zero_copy_writes()) {
   // Get buffer size config in K bytes. The default buffer size is 1024 KiB.
   buffer_size_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
                      config, buffer_size_kb, InternalClientConnectionFactory::DefaultBufferSize) *
@@ -51,6 +52,7 @@ void InternalListenerExtension::onServerInitialized() {
   // registry.
   InternalClientConnectionFactory::registry_tls_slot_ = tls_registry_->tls_slot_.get();
   InternalClientConnectionFactory::buffer_size_ = buffer_size_;
+  InternalClientConnectionFactory::zero_copy_writes_ = zero_copy_writes_;
 }
 
 Server::BootstrapExtensionPtr InternalListenerFactory::createBootstrapExtension(
@@ -52,6 +52,7 @@ private:
   Server::Configuration::ServerFactoryContext& server_context_;
   std::shared_ptr<TlsInternalListenerRegistry> tls_registry_;
   uint32_t buffer_size_;
+  const bool zero_copy_writes_;
 };
 
 // The factory creates the `InternalListenerExtension` instance when envoy starts.
@@ -115,6 +115,12 @@ public:
   absl::optional<MonotonicTime> lastHcPassTime() const override {
     return logical_host_->lastHcPassTime();
   }
+  absl::optional<HappyEyeballsOutcome> happyEyeballsOutcome() const override {
+    return logical_host_->happyEyeballsOutcome();
+  }
+  void setHappyEyeballsOutcome(absl::optional<HappyEyeballsOutcome> outcome) const override {
+    logical_host_->setHappyEyeballsOutcome(outcome);
+  }
   uint32_t priority() const override { return logical_host_->priority(); }
   Network::UpstreamTransportSocketFactory&
   resolveTransportSocketFactory(const Network::Address::InstanceConstSharedPtr& dest_address,
@@ -294,6 +294,7 @@ EXTENSIONS = {
     # OpenTelemetry tracer samplers
     #
 
+    "envoy.tracers.opentelemetry.samplers.adaptive":          "//source/extensions/tracers/opentelemetry/samplers/adaptive:config",
     "envoy.tracers.opentelemetry.samplers.always_on":         "//source/extensions/tracers/opentelemetry/samplers/always_on:config",
     "envoy.tracers.opentelemetry.samplers.dynatrace":         "//source/extensions/tracers/opentelemetry/samplers/dynatrace:config",
 
@@ -5,6 +5,7 @@
 #include "envoy/registry/registry.h"
 #include "envoy/router/router.h"
 
+#include "source/common/common/monotonic_arena.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/config_impl.h"
 #include "source/extensions/filters/http/cors/cors_filter.h"
@@ -23,7 +24,8 @@ Http::FilterFactoryCb CorsFilterFactory::createFilterFactoryFromProtoTyped(
   CorsFilterConfigSharedPtr config =
       std::make_shared<CorsFilterConfig>(stats_prefix, context.scope());
   return [config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamFilter(std::make_shared<CorsFilter>(config));
+    // The filter is only referenced by the stream, so it may be allocated from its arena.
+    callbacks.addStreamFilter(makeSharedInArena<CorsFilter>(callbacks.streamArena(), config));
   };
 }
 
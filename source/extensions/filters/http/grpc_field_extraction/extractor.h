@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "envoy/buffer/buffer.h"
 #include "envoy/extensions/filters/http/grpc_field_extraction/v3/config.pb.h"
 #include "envoy/extensions/filters/http/grpc_field_extraction/v3/config.pb.validate.h"
 
@@ -12,7 +13,6 @@
 
 #include "absl/status/status.h"
 #include "grpc_transcoding/type_helper.h"
-#include "proto_field_extraction/message_data/message_data.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -35,8 +35,9 @@ public:
   virtual ~Extractor() = default;
 
   // Process a request message to extract targeted fields.
+  // @param message the serialized request message, without the gRPC frame header.
   virtual absl::StatusOr<ExtractionResult>
-  processRequest(Protobuf::field_extraction::MessageData& message) const = 0;
+  processRequest(const Buffer::Instance& message) const = 0;
 };
 
 using ExtractorPtr = std::unique_ptr<Extractor>;
@@ -8,7 +8,6 @@
 #include "source/common/common/logger.h"
 
 #include "proto_field_extraction/field_value_extractor/field_value_extractor_factory.h"
-#include "proto_field_extraction/field_value_extractor/field_value_extractor_interface.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -21,6 +20,9 @@ using Protobuf::field_extraction::FieldValueExtractorFactory;
 } // namespace
 
 absl::Status ExtractorImpl::init() {
+  // The field value extractors of proto_field_extraction are only created to validate the field
+  // paths, so that the same configs are accepted. The values are extracted by scanning the wire
+  // format of the message.
   FieldValueExtractorFactory extractor_factory(type_finder_);
   for (const auto& it : field_extractions_.request_field_extractions()) {
     auto extractor = extractor_factory.Create(request_type_url_, it.first);
@@ -28,24 +30,30 @@ absl::Status ExtractorImpl::init() {
       return extractor.status();
     }
 
-    per_field_extractors_.emplace(it.first, std::move(extractor.value()));
+    paths_.push_back(it.first);
   }
+
+  auto wire_extractor = WireFieldExtractor::create(type_finder_, request_type_url_, paths_);
+  if (!wire_extractor.ok()) {
+    return wire_extractor.status();
+  }
+  wire_extractor_ = std::move(wire_extractor.value());
   return absl::OkStatus();
 }
 
 absl::StatusOr<ExtractionResult>
-ExtractorImpl::processRequest(Protobuf::field_extraction::MessageData& message) const {
+ExtractorImpl::processRequest(const Buffer::Instance& message) const {
+  absl::StatusOr<std::vector<ProtobufWkt::Value>> values = wire_extractor_->extract(message);
+  if (!values.ok()) {
+    return values.status();
+  }
 
   ExtractionResult result;
-  for (const auto& it : per_field_extractors_) {
-    absl::StatusOr<ProtobufWkt::Value> extracted_value = it.second->ExtractValue(message);
-    if (!extracted_value.ok()) {
-      return extracted_value.status();
-    }
-
-    ENVOY_LOG_MISC(debug, "extracted the following resource values from the {} field: {}", it.first,
-                   extracted_value->DebugString());
-    result.push_back({it.first, std::move(*extracted_value)});
+  result.reserve(paths_.size());
+  for (size_t i = 0; i < paths_.size(); ++i) {
+    ENVOY_LOG_MISC(debug, "extracted the following resource values from the {} field: {}",
+                   paths_[i], (*values)[i].DebugString());
+    result.push_back({paths_[i], std::move((*values)[i])});
   }
 
   return result;
@@ -1,24 +1,23 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "envoy/extensions/filters/http/grpc_field_extraction/v3/config.pb.h"
 #include "envoy/extensions/filters/http/grpc_field_extraction/v3/config.pb.validate.h"
 
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/filters/http/grpc_field_extraction/extractor.h"
+#include "source/extensions/filters/http/grpc_field_extraction/wire_field_extractor.h"
 
 #include "absl/status/status.h"
 #include "grpc_transcoding/type_helper.h"
-#include "proto_field_extraction/field_value_extractor/field_value_extractor_factory.h"
 
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace GrpcFieldExtraction {
 
-using FieldValueExtractorPtr =
-    std::unique_ptr<Protobuf::field_extraction::FieldValueExtractorInterface>;
 class ExtractorImpl : public Extractor {
 public:
   explicit ExtractorImpl(
@@ -31,8 +30,7 @@ public:
   //  The init method should be invoked right after the constructor has been called.
   absl::Status init();
 
-  absl::StatusOr<ExtractionResult>
-  processRequest(Protobuf::field_extraction::MessageData& message) const override;
+  absl::StatusOr<ExtractionResult> processRequest(const Buffer::Instance& message) const override;
 
 private:
   const TypeFinder& type_finder_;
@@ -42,7 +40,10 @@ private:
   const envoy::extensions::filters::http::grpc_field_extraction::v3::FieldExtractions&
       field_extractions_;
 
-  absl::flat_hash_map<absl::string_view, FieldValueExtractorPtr> per_field_extractors_;
+  // The configured field paths, in the order of the values extracted by `wire_extractor_`.
+  std::vector<absl::string_view> paths_;
+
+  WireFieldExtractorPtr wire_extractor_;
 };
 
 class ExtractorFactoryImpl : public ExtractorFactory {
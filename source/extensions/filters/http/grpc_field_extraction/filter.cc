@@ -175,7 +175,8 @@ Filter::HandleDecodeDataStatus Filter::handleDecodeData(Envoy::Buffer::Instance&
     if (!extraction_done_) {
       extraction_done_ = true;
 
-      auto result = extractor_->processRequest(*message_data->message());
+      // The fields are extracted from the wire format, directly over the slices of the message.
+      auto result = extractor_->processRequest(*message_data->ownedBytes());
       if (!result.ok()) {
         rejectRequest(result.status().raw_code(), result.status().message(),
                       generateRcDetails(kRcDetailFilterGrpcFieldExtraction,
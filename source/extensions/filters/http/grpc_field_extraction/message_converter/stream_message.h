@@ -54,6 +54,9 @@ public:
     return message_ != nullptr ? message_.get() : nullptr;
   }
 
+  // The serialized message, or nullptr for the final placeholder message of the stream.
+  const Buffer::Instance* ownedBytes() const { return owned_bytes_.get(); }
+
   void set(std::unique_ptr<Protobuf::field_extraction::MessageData> message) {
     message_ = std::move(message);
   }
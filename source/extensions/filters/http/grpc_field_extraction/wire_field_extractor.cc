@@ -0,0 +1,492 @@
+#include "source/extensions/filters/http/grpc_field_extraction/wire_field_extractor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/common/assert.h"
+
+#include "absl/base/casts.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "src/google/protobuf/util/converter/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcFieldExtraction {
+namespace {
+
+using ::Envoy::Protobuf::Field;
+using ::Envoy::Protobuf::internal::WireFormatLite;
+
+// Protobuf parsers reject messages with deeper nesting of groups.
+constexpr int MaxGroupDepth = 100;
+
+bool isSupportedLeafKind(Field::Kind kind) {
+  switch (kind) {
+  case Field::TYPE_STRING:
+  case Field::TYPE_UINT32:
+  case Field::TYPE_UINT64:
+  case Field::TYPE_INT32:
+  case Field::TYPE_INT64:
+  case Field::TYPE_SINT32:
+  case Field::TYPE_SINT64:
+  case Field::TYPE_FIXED32:
+  case Field::TYPE_FIXED64:
+  case Field::TYPE_SFIXED32:
+  case Field::TYPE_SFIXED64:
+  case Field::TYPE_FLOAT:
+  case Field::TYPE_DOUBLE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+WireFormatLite::WireType wireType(Field::Kind kind) {
+  switch (kind) {
+  case Field::TYPE_FIXED32:
+  case Field::TYPE_SFIXED32:
+  case Field::TYPE_FLOAT:
+    return WireFormatLite::WIRETYPE_FIXED32;
+  case Field::TYPE_FIXED64:
+  case Field::TYPE_SFIXED64:
+  case Field::TYPE_DOUBLE:
+    return WireFormatLite::WIRETYPE_FIXED64;
+  case Field::TYPE_STRING:
+  case Field::TYPE_MESSAGE:
+    return WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+  default:
+    return WireFormatLite::WIRETYPE_VARINT;
+  }
+}
+
+std::string varintToString(Field::Kind kind, uint64_t value) {
+  switch (kind) {
+  case Field::TYPE_UINT32:
+    return absl::StrCat(static_cast<uint32_t>(value));
+  case Field::TYPE_INT32:
+    return absl::StrCat(static_cast<int32_t>(value));
+  case Field::TYPE_INT64:
+    return absl::StrCat(static_cast<int64_t>(value));
+  case Field::TYPE_SINT32:
+    return absl::StrCat(WireFormatLite::ZigZagDecode32(static_cast<uint32_t>(value)));
+  case Field::TYPE_SINT64:
+    return absl::StrCat(WireFormatLite::ZigZagDecode64(value));
+  default:
+    return absl::StrCat(value);
+  }
+}
+
+std::string fixed32ToString(Field::Kind kind, uint32_t value) {
+  switch (kind) {
+  case Field::TYPE_SFIXED32:
+    return absl::StrCat(static_cast<int32_t>(value));
+  case Field::TYPE_FLOAT:
+    return absl::StrCat(absl::bit_cast<float>(value));
+  default:
+    return absl::StrCat(value);
+  }
+}
+
+std::string fixed64ToString(Field::Kind kind, uint64_t value) {
+  switch (kind) {
+  case Field::TYPE_SFIXED64:
+    return absl::StrCat(static_cast<int64_t>(value));
+  case Field::TYPE_DOUBLE:
+    return absl::StrCat(absl::bit_cast<double>(value));
+  default:
+    return absl::StrCat(value);
+  }
+}
+
+// Returns the node of the field with the given number, or nullptr if the field is not on any path.
+template <class MessageNode> auto* findField(MessageNode& node, uint32_t number) {
+  const auto it =
+      std::lower_bound(node.begin(), node.end(), number,
+                       [](const auto& field, uint32_t number) { return field.number < number; });
+  return it != node.end() && it->number == number ? &*it : nullptr;
+}
+
+absl::Status malformedMessage() {
+  return absl::InvalidArgumentError("failed to scan the request message: malformed wire format");
+}
+
+// A cursor over the slices of a buffer which reads wire format primitives, without going past a
+// limit which is narrowed down while reading a length-delimited field.
+class WireReader {
+public:
+  explicit WireReader(const Buffer::Instance& buffer)
+      : slices_(buffer.getRawSlices()), limit_(buffer.length()) {}
+
+  uint64_t position() const { return position_; }
+  uint64_t limit() const { return limit_; }
+  void setLimit(uint64_t limit) { limit_ = limit; }
+  bool atLimit() const { return position_ == limit_; }
+
+  bool readVarint(uint64_t& value) {
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+      if (position_ == limit_) {
+        return false;
+      }
+      enterSlice();
+      const uint8_t byte = *current_++;
+      ++position_;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (byte < 0x80) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class T> bool readFixed(T& value) {
+    uint8_t bytes[sizeof(T)];
+    if (!read(bytes, sizeof(T))) {
+      return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      value |= static_cast<T>(bytes[i]) << (8 * i);
+    }
+    return true;
+  }
+
+  bool readString(uint64_t size, std::string& value) {
+    if (size > limit_ - position_) {
+      return false;
+    }
+    value.resize(size);
+    return read(value.data(), size);
+  }
+
+  bool skip(uint64_t size) { return advance(size, nullptr); }
+
+private:
+  // Makes the current slice one with bytes left. Must only be called before the end of the data.
+  void enterSlice() {
+    while (current_ == end_) {
+      ASSERT(slice_index_ < slices_.size());
+      current_ = static_cast<const uint8_t*>(slices_[slice_index_].mem_);
+      end_ = current_ + slices_[slice_index_].len_;
+      ++slice_index_;
+    }
+  }
+
+  bool read(void* dest, uint64_t size) { return advance(size, static_cast<uint8_t*>(dest)); }
+
+  // Moves past `size` bytes, copying them to `dest` if not null.
+  bool advance(uint64_t size, uint8_t* dest) {
+    if (size > limit_ - position_) {
+      return false;
+    }
+    position_ += size;
+    while (size > 0) {
+      enterSlice();
+      const uint64_t length = std::min<uint64_t>(size, end_ - current_);
+      if (dest != nullptr) {
+        memcpy(dest, current_, length); // NOLINT(safe-memcpy)
+        dest += length;
+      }
+      current_ += length;
+      size -= length;
+    }
+    return true;
+  }
+
+  const Buffer::RawSliceVector slices_;
+  size_t slice_index_{0};
+  const uint8_t* current_{nullptr};
+  const uint8_t* end_{nullptr};
+  uint64_t position_{0};
+  uint64_t limit_;
+};
+
+// The state of a single extraction.
+class WireScanner {
+public:
+  WireScanner(const Buffer::Instance& message, size_t path_count)
+      : reader_(message), values_(path_count), last_occurrences_(path_count, NoOccurrence) {
+    for (ProtobufWkt::Value& value : values_) {
+      value.mutable_list_value();
+    }
+  }
+
+  absl::StatusOr<std::vector<ProtobufWkt::Value>>
+  scan(const WireFieldExtractor::MessageNode& root) {
+    RETURN_IF_NOT_OK(scanMessage(root, 0));
+    return std::move(values_);
+  }
+
+private:
+  using FieldNode = WireFieldExtractor::FieldNode;
+  using MessageNode = WireFieldExtractor::MessageNode;
+
+  static constexpr uint64_t NoOccurrence = std::numeric_limits<uint64_t>::max();
+
+  // Scans the fields of a message up to the limit of the reader. `occurrence` identifies the
+  // element of the innermost repeated message field the message is part of: proto semantics merge
+  // all occurrences of a singular message field, and the last value of a singular field wins.
+  absl::Status scanMessage(const MessageNode& node, uint64_t occurrence) {
+    while (!reader_.atLimit()) {
+      uint64_t tag;
+      if (!reader_.readVarint(tag) || tag > std::numeric_limits<uint32_t>::max()) {
+        return malformedMessage();
+      }
+      const uint32_t number = WireFormatLite::GetTagFieldNumber(tag);
+      const WireFormatLite::WireType wire_type = WireFormatLite::GetTagWireType(tag);
+      const FieldNode* field = findField(node, number);
+      if (field == nullptr) {
+        RETURN_IF_NOT_OK(skipField(number, wire_type, 0));
+        continue;
+      }
+      RETURN_IF_NOT_OK(scanField(*field, wire_type, occurrence));
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status scanField(const FieldNode& field, WireFormatLite::WireType wire_type,
+                         uint64_t occurrence) {
+    const WireFormatLite::WireType expected_wire_type =
+        field.map ? WireFormatLite::WIRETYPE_LENGTH_DELIMITED : wireType(field.kind);
+    if (wire_type == expected_wire_type) {
+      if (field.path_index < 0) {
+        // Each element of a repeated message field is a message of its own.
+        const uint64_t element_occurrence = field.repeated ? ++occurrences_ : occurrence;
+        return scanLengthDelimited(
+            [&]() { return scanMessage(field.fields, element_occurrence); });
+      }
+      if (field.map) {
+        return scanLengthDelimited([&]() { return scanMapEntry(field, occurrence); });
+      }
+      return scanValue(field, occurrence);
+    }
+    if (wire_type == WireFormatLite::WIRETYPE_LENGTH_DELIMITED && field.repeated &&
+        field.path_index >= 0 && expected_wire_type != WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      // Packed repeated numeric field.
+      return scanLengthDelimited([&]() {
+        while (!reader_.atLimit()) {
+          RETURN_IF_NOT_OK(scanValue(field, occurrence));
+        }
+        return absl::OkStatus();
+      });
+    }
+    // Protobuf parsers treat a field with an unexpected wire type as an unknown field.
+    return skipField(field.number, wire_type, 0);
+  }
+
+  // Reads the size of a length-delimited field, and calls `scan_content` with the reader limited
+  // to the content of the field.
+  template <class ScanContent> absl::Status scanLengthDelimited(ScanContent scan_content) {
+    uint64_t size;
+    if (!reader_.readVarint(size) || size > reader_.limit() - reader_.position()) {
+      return malformedMessage();
+    }
+    const uint64_t limit = reader_.limit();
+    reader_.setLimit(reader_.position() + size);
+    RETURN_IF_NOT_OK(scan_content());
+    reader_.setLimit(limit);
+    return absl::OkStatus();
+  }
+
+  absl::Status scanValue(const FieldNode& field, uint64_t occurrence) {
+    ProtobufWkt::Value value;
+    bool ok = true;
+    switch (field.kind) {
+    case Field::TYPE_STRING: {
+      uint64_t size;
+      ok = reader_.readVarint(size) && reader_.readString(size, *value.mutable_string_value());
+      break;
+    }
+    case Field::TYPE_FIXED32:
+    case Field::TYPE_SFIXED32:
+    case Field::TYPE_FLOAT: {
+      uint32_t fixed;
+      ok = reader_.readFixed(fixed);
+      value.set_string_value(fixed32ToString(field.kind, fixed));
+      break;
+    }
+    case Field::TYPE_FIXED64:
+    case Field::TYPE_SFIXED64:
+    case Field::TYPE_DOUBLE: {
+      uint64_t fixed;
+      ok = reader_.readFixed(fixed);
+      value.set_string_value(fixed64ToString(field.kind, fixed));
+      break;
+    }
+    default: {
+      uint64_t varint;
+      ok = reader_.readVarint(varint);
+      value.set_string_value(varintToString(field.kind, varint));
+      break;
+    }
+    }
+    if (!ok) {
+      return malformedMessage();
+    }
+
+    ProtobufWkt::ListValue& list = *values_[field.path_index].mutable_list_value();
+    if (!field.repeated && last_occurrences_[field.path_index] == occurrence) {
+      *list.mutable_values(list.values_size() - 1) = std::move(value);
+    } else {
+      *list.add_values() = std::move(value);
+    }
+    last_occurrences_[field.path_index] = occurrence;
+    return absl::OkStatus();
+  }
+
+  // Scans an entry of a map<string, string> field into the struct of the map in the message
+  // identified by `occurrence`.
+  absl::Status scanMapEntry(const FieldNode& field, uint64_t occurrence) {
+    std::string key;
+    std::string value;
+    while (!reader_.atLimit()) {
+      uint64_t tag;
+      if (!reader_.readVarint(tag) || tag > std::numeric_limits<uint32_t>::max()) {
+        return malformedMessage();
+      }
+      const uint32_t number = WireFormatLite::GetTagFieldNumber(tag);
+      const WireFormatLite::WireType wire_type = WireFormatLite::GetTagWireType(tag);
+      if ((number == 1 || number == 2) && wire_type == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+        uint64_t size;
+        if (!reader_.readVarint(size) || !reader_.readString(size, number == 1 ? key : value)) {
+          return malformedMessage();
+        }
+        continue;
+      }
+      RETURN_IF_NOT_OK(skipField(number, wire_type, 0));
+    }
+
+    ProtobufWkt::ListValue& list = *values_[field.path_index].mutable_list_value();
+    if (last_occurrences_[field.path_index] != occurrence) {
+      list.add_values()->mutable_struct_value();
+      last_occurrences_[field.path_index] = occurrence;
+    }
+    ProtobufWkt::Struct& map = *list.mutable_values(list.values_size() - 1)->mutable_struct_value();
+    (*map.mutable_fields())[key].set_string_value(std::move(value));
+    return absl::OkStatus();
+  }
+
+  absl::Status skipField(uint32_t number, WireFormatLite::WireType wire_type, int group_depth) {
+    uint64_t value;
+    switch (wire_type) {
+    case WireFormatLite::WIRETYPE_VARINT:
+      return reader_.readVarint(value) ? absl::OkStatus() : malformedMessage();
+    case WireFormatLite::WIRETYPE_FIXED64:
+      return reader_.skip(8) ? absl::OkStatus() : malformedMessage();
+    case WireFormatLite::WIRETYPE_FIXED32:
+      return reader_.skip(4) ? absl::OkStatus() : malformedMessage();
+    case WireFormatLite::WIRETYPE_LENGTH_DELIMITED:
+      return reader_.readVarint(value) && reader_.skip(value) ? absl::OkStatus()
+                                                               : malformedMessage();
+    case WireFormatLite::WIRETYPE_START_GROUP:
+      if (group_depth >= MaxGroupDepth) {
+        return malformedMessage();
+      }
+      while (true) {
+        uint64_t tag;
+        if (!reader_.readVarint(tag) || tag > std::numeric_limits<uint32_t>::max()) {
+          return malformedMessage();
+        }
+        const uint32_t group_number = WireFormatLite::GetTagFieldNumber(tag);
+        const WireFormatLite::WireType group_wire_type = WireFormatLite::GetTagWireType(tag);
+        if (group_wire_type == WireFormatLite::WIRETYPE_END_GROUP) {
+          return group_number == number ? absl::OkStatus() : malformedMessage();
+        }
+        RETURN_IF_NOT_OK(skipField(group_number, group_wire_type, group_depth + 1));
+      }
+    default:
+      return malformedMessage();
+    }
+  }
+
+  WireReader reader_;
+  std::vector<ProtobufWkt::Value> values_;
+  // For each path, the occurrence of the message the last value was extracted from.
+  std::vector<uint64_t> last_occurrences_;
+  // The number of elements of repeated message fields scanned so far.
+  uint64_t occurrences_{0};
+};
+
+} // namespace
+
+absl::StatusOr<std::unique_ptr<WireFieldExtractor>>
+WireFieldExtractor::create(const TypeFinder& type_finder, absl::string_view type_url,
+                           const std::vector<absl::string_view>& paths) {
+  MessageNode root;
+  for (size_t path_index = 0; path_index < paths.size(); ++path_index) {
+    const std::vector<absl::string_view> names = absl::StrSplit(paths[path_index], '.');
+    const Protobuf::Type* type = type_finder(std::string(type_url));
+    MessageNode* node = &root;
+    for (size_t i = 0; i < names.size(); ++i) {
+      if (type == nullptr) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("couldn't find the type of field path `", paths[path_index], "`"));
+      }
+      const auto field_it =
+          std::find_if(type->fields().begin(), type->fields().end(),
+                       [&names, i](const Field& field) { return field.name() == names[i]; });
+      if (field_it == type->fields().end()) {
+        return absl::InvalidArgumentError(absl::StrCat("couldn't find field `", names[i],
+                                                       "` of field path `", paths[path_index],
+                                                       "` in type `", type->name(), "`"));
+      }
+      const Field& field = *field_it;
+      const Protobuf::Type* field_type = field.kind() == Field::TYPE_MESSAGE
+                                             ? type_finder(field.type_url())
+                                             : nullptr;
+      const bool map = field_type != nullptr &&
+                       google::protobuf::util::converter::IsMap(field, *field_type);
+      const bool last = i == names.size() - 1;
+
+      if (last) {
+        const bool string_map = map && field_type->fields_size() == 2 &&
+                                field_type->fields(0).kind() == Field::TYPE_STRING &&
+                                field_type->fields(1).kind() == Field::TYPE_STRING;
+        if (!isSupportedLeafKind(field.kind()) && !string_map) {
+          return absl::InvalidArgumentError(absl::StrCat(
+              "unsupported type of the last field of field path `", paths[path_index], "`"));
+        }
+      } else if (field_type == nullptr || map) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("field `", names[i], "` of field path `", paths[path_index],
+                         "` must be a message"));
+      }
+
+      const uint32_t number = static_cast<uint32_t>(field.number());
+      FieldNode* field_node = findField(*node, number);
+      if (field_node == nullptr) {
+        const auto it = std::upper_bound(
+            node->begin(), node->end(), number,
+            [](uint32_t lhs, const FieldNode& rhs) { return lhs < rhs.number; });
+        const bool repeated = field.cardinality() == Field::CARDINALITY_REPEATED;
+        field_node = &*node->insert(it, FieldNode{number, field.kind(), repeated, map, -1, {}});
+      }
+      if (last) {
+        field_node->path_index = path_index;
+      }
+      node = &field_node->fields;
+      type = field_type;
+    }
+  }
+  return std::unique_ptr<WireFieldExtractor>(new WireFieldExtractor(std::move(root), paths.size()));
+}
+
+absl::StatusOr<std::vector<ProtobufWkt::Value>>
+WireFieldExtractor::extract(const Buffer::Instance& message) const {
+  return WireScanner(message, path_count_).scan(root_);
+}
+
+} // namespace GrpcFieldExtraction
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/buffer/buffer.h"
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/extensions/filters/http/grpc_field_extraction/extractor.h"
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcFieldExtraction {
+
+// Extracts the values of a set of field paths from a serialized message, by scanning its wire
+// format directly over the slices of the buffer holding it. The message is neither parsed nor
+// coalesced: fields which are not on any of the paths are skipped over, length-delimited ones
+// without reading their content, so that the cost of the extraction is proportional to the fields
+// on the paths rather than to the size of the message.
+//
+// The extracted values have the same form as those of the FieldValueExtractor of
+// proto_field_extraction: for each path, a list of the string representations of the values of the
+// field (or of structs for a map field), in the order in which they appear in the message.
+class WireFieldExtractor {
+public:
+  // Resolves the `paths` against the type of `type_url`. The last field of each path must be a
+  // string, a numeric field or a map<string, string>, and the other fields must be messages.
+  static absl::StatusOr<std::unique_ptr<WireFieldExtractor>>
+  create(const TypeFinder& type_finder, absl::string_view type_url,
+         const std::vector<absl::string_view>& paths);
+
+  // Extracts the values of the paths from the serialized `message`, in the order of the paths
+  // given to create(). Fails if the message is malformed.
+  absl::StatusOr<std::vector<ProtobufWkt::Value>>
+  extract(const Buffer::Instance& message) const;
+
+  // The fields of a message which lead to extracted values, sorted by field number.
+  struct FieldNode;
+  using MessageNode = std::vector<FieldNode>;
+
+  struct FieldNode {
+    uint32_t number;
+    Protobuf::Field::Kind kind;
+    bool repeated;
+    bool map;
+    // The index of the path whose last field this is, or -1 for an intermediate message field.
+    int32_t path_index;
+    // The fields of an intermediate message field.
+    MessageNode fields;
+  };
+
+private:
+  WireFieldExtractor(MessageNode root, size_t path_count)
+      : root_(std::move(root)), path_count_(path_count) {}
+
+  const MessageNode root_;
+  const size_t path_count_;
+};
+
+using WireFieldExtractorPtr = std::unique_ptr<WireFieldExtractor>;
+
+} // namespace GrpcFieldExtraction
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -723,6 +723,10 @@ Http::FilterDataStatus JsonTranscoderFilter::encodeData(Buffer::Instance& data,
     return Http::FilterDataStatus::Continue;
   }
 
+  if (method_->descriptor_->server_streaming()) {
+    return encodeStreamingData(data, end_stream);
+  }
+
   stats_->transcoder_response_buffer_bytes_.add(data.length());
   response_in_.move(data);
   if (encoderBufferLimitReached(response_in_.bytesStored() + response_data_.length())) {
@@ -744,7 +748,7 @@ Http::FilterDataStatus JsonTranscoderFilter::encodeData(Buffer::Instance& data,
     return Http::FilterDataStatus::StopIterationNoBuffer;
   }
 
-  if (!method_->descriptor_->server_streaming() && !end_stream) {
+  if (!end_stream) {
     ENVOY_STREAM_LOG(debug,
                      "internally buffering unary response waiting for end_stream during "
                      "encodeData, transcoded data size={}",
@@ -759,6 +763,42 @@ Http::FilterDataStatus JsonTranscoderFilter::encodeData(Buffer::Instance& data,
   return Http::FilterDataStatus::Continue;
 }
 
+Http::FilterDataStatus JsonTranscoderFilter::encodeStreamingData(Buffer::Instance& data,
+                                                                 bool end_stream) {
+  // Each message is emitted as soon as it is transcoded. The transcoder is fed at most the buffer
+  // limit at a time, so that only the bytes of an incomplete message stay buffered, however much
+  // data comes in at once: the limit applies to a single message rather than to the data.
+  const uint64_t max_size = maxResponseBufferSize();
+  Buffer::OwnedImpl transcoded;
+  do {
+    const uint64_t stored = response_in_.bytesStored();
+    const uint64_t length = std::min(data.length(), max_size - std::min(stored, max_size));
+    stats_->transcoder_response_buffer_bytes_.add(length);
+    response_in_.move(data, length);
+    if (end_stream && data.length() == 0) {
+      response_in_.finish();
+    }
+
+    const uint64_t stream_size_before = response_in_.bytesStored();
+    readToBuffer(*transcoder_->ResponseOutput(), transcoded);
+    stats_->transcoder_response_buffer_bytes_.sub(stream_size_before - response_in_.bytesStored());
+    if (checkAndRejectIfResponseTranscoderFailed()) {
+      return Http::FilterDataStatus::StopIterationNoBuffer;
+    }
+  } while (data.length() > 0 && response_in_.bytesStored() < max_size);
+
+  // The message being transcoded is larger than the limit.
+  if (data.length() > 0 && encoderBufferLimitReached(response_in_.bytesStored() + data.length())) {
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+
+  data.move(transcoded);
+  ENVOY_STREAM_LOG(debug,
+                   "continuing response during encodeData, transcoded data size={}, end_stream={}",
+                   *encoder_callbacks_, data.length(), end_stream);
+  return Http::FilterDataStatus::Continue;
+}
+
 Http::FilterTrailersStatus
 JsonTranscoderFilter::encodeTrailers(Http::ResponseTrailerMap& trailers) {
   doTrailers(trailers);
@@ -1060,11 +1100,15 @@ bool JsonTranscoderFilter::decoderBufferLimitReached(uint64_t buffer_length) {
   return false;
 }
 
-bool JsonTranscoderFilter::encoderBufferLimitReached(uint64_t buffer_length) {
+uint32_t JsonTranscoderFilter::maxResponseBufferSize() {
   // The limit is either the configured maximum response body size, or, if not configured,
   // the default buffer limit.
-  const uint32_t max_size =
-      per_route_config_->max_response_body_size_.value_or(encoder_callbacks_->encoderBufferLimit());
+  return per_route_config_->max_response_body_size_.value_or(
+      encoder_callbacks_->encoderBufferLimit());
+}
+
+bool JsonTranscoderFilter::encoderBufferLimitReached(uint64_t buffer_length) {
+  const uint32_t max_size = maxResponseBufferSize();
   if (buffer_length > max_size) {
     ENVOY_STREAM_LOG(
         debug,
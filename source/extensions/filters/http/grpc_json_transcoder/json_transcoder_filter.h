@@ -172,6 +172,10 @@ private:
   bool checkAndRejectIfRequestTranscoderFailed(const std::string& details);
   bool checkAndRejectIfResponseTranscoderFailed();
   bool readToBuffer(Protobuf::io::ZeroCopyInputStream& stream, Buffer::Instance& data);
+  /**
+   * Transcodes the data of a server streaming response (other than HttpBody) message by message.
+   */
+  Http::FilterDataStatus encodeStreamingData(Buffer::Instance& data, bool end_stream);
   void maybeSendHttpBodyRequestMessage(Buffer::Instance* data);
   /**
    * Builds response from HttpBody protobuf.
@@ -188,6 +192,7 @@ private:
   // Helpers for flow control.
   bool decoderBufferLimitReached(uint64_t buffer_length);
   bool encoderBufferLimitReached(uint64_t buffer_length);
+  uint32_t maxResponseBufferSize();
 
   /**
    * If max_request_body_size or max_response_body_size is configured and larger than
@@ -5,7 +5,6 @@
 #endif
 
 #include "source/common/common/assert.h"
-#include "source/common/common/base64.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/utility.h"
@@ -199,41 +198,29 @@ Http::FilterDataStatus GrpcWebFilter::decodeData(Buffer::Instance& data, bool en
   }
 
   // Parse application/grpc-web-text format.
-  const uint64_t available = data.length() + decoding_buffer_.length();
-  if (end_stream) {
-    if (available == 0) {
-      return Http::FilterDataStatus::Continue;
-    }
-    if (available % 4 != 0) {
-      // Client end stream with invalid base64. Note, base64 padding is mandatory.
-      decoder_callbacks_->sendLocalReply(Http::Code::BadRequest,
-                                         "Bad gRPC-web request, invalid base64 data.", nullptr,
-                                         absl::nullopt, RcDetails::get().GrpcDecodeFailedDueToSize);
-      return Http::FilterDataStatus::StopIterationNoBuffer;
-    }
-  } else if (available < 4) {
-    decoding_buffer_.move(data);
+  if (end_stream && (data.length() + text_decoder_.pendingSize()) % 4 != 0) {
+    // Client end stream with invalid base64. Note, base64 padding is mandatory.
+    decoder_callbacks_->sendLocalReply(Http::Code::BadRequest,
+                                       "Bad gRPC-web request, invalid base64 data.", nullptr,
+                                       absl::nullopt, RcDetails::get().GrpcDecodeFailedDueToSize);
     return Http::FilterDataStatus::StopIterationNoBuffer;
   }
 
-  const uint64_t needed = available / 4 * 4 - decoding_buffer_.length();
-  decoding_buffer_.move(data, needed);
-  const std::string decoded = Base64::decode(
-      std::string(static_cast<const char*>(decoding_buffer_.linearize(decoding_buffer_.length())),
-                  decoding_buffer_.length()));
-  if (decoded.empty()) {
+  // The decoder consumes all the data, and keeps the characters after the last whole block of 4
+  // characters until more data comes in.
+  Buffer::OwnedImpl decoded;
+  if (!text_decoder_.decode(data, decoded)) {
     // Error happened when decoding base64.
     decoder_callbacks_->sendLocalReply(Http::Code::BadRequest,
                                        "Bad gRPC-web request, invalid base64 data.", nullptr,
                                        absl::nullopt, RcDetails::get().GrpcDecodeFailedDueToData);
     return Http::FilterDataStatus::StopIterationNoBuffer;
   }
+  if (decoded.length() == 0 && !end_stream) {
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
 
-  decoding_buffer_.drain(decoding_buffer_.length());
-  decoding_buffer_.move(data);
-  data.add(decoded);
-  // Any block of 4 bytes or more should have been decoded and passed through.
-  ASSERT(decoding_buffer_.length() < 4);
+  data.move(decoded);
   return Http::FilterDataStatus::Continue;
 }
 
@@ -297,28 +284,49 @@ Http::FilterDataStatus GrpcWebFilter::encodeData(Buffer::Instance& data, bool en
     return Http::FilterDataStatus::Continue;
   }
 
-  // The decoder always consumes and drains the given buffer. Incomplete data frame is buffered
-  // inside the decoder.
-  std::vector<Grpc::Frame> frames;
-  std::ignore = decoder_.decode(data, frames);
-  if (frames.empty()) {
-    // We don't have enough data to decode for one single frame, stop iteration until more data
+  Buffer::OwnedImpl encoded;
+  encodeTextFrames(data, encoded);
+  if (end_stream) {
+    // Complete the encoding of a truncated last frame.
+    text_encoder_.finish(encoded);
+  }
+  if (encoded.length() == 0 && !end_stream) {
+    // We don't have enough data to encode one whole base64 block, stop iteration until more data
     // comes in.
     return Http::FilterDataStatus::StopIterationNoBuffer;
   }
 
-  // Encodes the decoded gRPC frames with base64.
-  for (auto& frame : frames) {
-    Buffer::OwnedImpl temp;
-    temp.add(&frame.flags_, 1);
-    const uint32_t length = htonl(frame.length_);
-    temp.add(&length, 4);
-    if (frame.length_ > 0) {
-      temp.add(*frame.data_);
+  data.move(encoded);
+  return Http::FilterDataStatus::Continue;
+}
+
+void GrpcWebFilter::encodeTextFrames(Buffer::Instance& data, Buffer::Instance& output) {
+  // Each gRPC frame is encoded with base64 separately, i.e. it is padded at its end. The frames
+  // are encoded as they stream in, so only the bytes which do not make a whole base64 block are
+  // kept by the encoder; the frame header is only inspected to find where the frame ends.
+  while (data.length() > 0) {
+    if (frame_header_size_ < Grpc::GRPC_FRAME_HEADER_SIZE) {
+      const uint64_t header_bytes =
+          std::min(Grpc::GRPC_FRAME_HEADER_SIZE - frame_header_size_, data.length());
+      data.copyOut(0, header_bytes, frame_header_ + frame_header_size_);
+      frame_header_size_ += header_bytes;
+      text_encoder_.encode(data, header_bytes, output);
+      if (frame_header_size_ < Grpc::GRPC_FRAME_HEADER_SIZE) {
+        return;
+      }
+      uint32_t message_length;
+      memcpy(&message_length, frame_header_ + 1, sizeof(message_length));
+      frame_message_left_ = ntohl(message_length);
+    }
+
+    const uint64_t message_bytes = std::min(frame_message_left_, data.length());
+    text_encoder_.encode(data, message_bytes, output);
+    frame_message_left_ -= message_bytes;
+    if (frame_message_left_ == 0) {
+      text_encoder_.finish(output);
+      frame_header_size_ = 0;
     }
-    data.add(Base64::encode(temp, temp.length()));
   }
-  return Http::FilterDataStatus::Continue;
 }
 
 Http::FilterTrailersStatus GrpcWebFilter::encodeTrailers(Http::ResponseTrailerMap& trailers) {
@@ -356,7 +364,11 @@ Http::FilterTrailersStatus GrpcWebFilter::encodeTrailers(Http::ResponseTrailerMa
   buffer.add(&length, 4);
   buffer.move(temp);
   if (is_text_response_) {
-    Buffer::OwnedImpl encoded(Base64::encode(buffer, buffer.length()));
+    Buffer::OwnedImpl encoded;
+    // Complete the encoding of a truncated last data frame, if any, before the trailers frame.
+    text_encoder_.finish(encoded);
+    text_encoder_.encode(buffer, buffer.length(), encoded);
+    text_encoder_.finish(encoded);
     encoder_callbacks_->addEncodedData(encoded, true);
   } else {
     encoder_callbacks_->addEncodedData(buffer, true);
@@ -4,6 +4,7 @@
 #include "envoy/upstream/cluster_manager.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/base64.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/grpc/codec.h"
 #include "source/common/grpc/context_impl.h"
@@ -63,6 +64,7 @@ private:
   void mergeAndLimitNonProtoEncodedResponseData(Buffer::OwnedImpl& output,
                                                 Buffer::Instance* last_data);
   void setTransformedNonProtoEncodedResponseHeaders(Buffer::Instance* data);
+  void encodeTextFrames(Buffer::Instance& data, Buffer::Instance& output);
 
   static const uint8_t GRPC_WEB_TRAILER;
   const absl::flat_hash_set<std::string>& gRpcWebContentTypes() const;
@@ -73,8 +75,13 @@ private:
   bool is_text_request_{};
   bool is_text_response_{};
   bool needs_transformation_for_non_proto_encoded_response_{};
-  Buffer::OwnedImpl decoding_buffer_;
-  Grpc::Decoder decoder_;
+  Base64StreamDecoder text_decoder_;
+  Base64StreamEncoder text_encoder_;
+  // The header of the gRPC frame of the response being encoded, while it is incomplete.
+  uint8_t frame_header_[Grpc::GRPC_FRAME_HEADER_SIZE];
+  uint64_t frame_header_size_{0};
+  // The bytes of the message of the gRPC frame being encoded which are still to come.
+  uint64_t frame_message_left_{0};
   absl::optional<Grpc::Context::RequestStatNames> request_stat_names_;
   bool is_grpc_web_request_{};
   Grpc::Context& context_;
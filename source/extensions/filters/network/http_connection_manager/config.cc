@@ -793,7 +793,8 @@ Http::ServerConnectionPtr HttpConnectionManagerConfig::createCodec(
 
 bool HttpConnectionManagerConfig::createFilterChain(Http::FilterChainManager& manager, bool,
                                                     const Http::FilterChainOptions& options) const {
-  Http::FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories_);
+  Http::FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories_,
+                                                          &prebuilt_filter_chains_);
   return true;
 }
 
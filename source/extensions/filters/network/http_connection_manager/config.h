@@ -291,6 +291,8 @@ private:
   Http::RequestIDExtensionSharedPtr request_id_extension_;
   Server::Configuration::FactoryContext& context_;
   FilterFactoriesList filter_factories_;
+  // The filter chains of filter_factories_ prebuilt for the routes of the streams.
+  const Http::FilterChainUtility::PrebuiltFilterChains prebuilt_filter_chains_;
   std::map<std::string, FilterConfig> upgrade_filter_factories_;
   std::list<AccessLog::InstanceSharedPtr> access_logs_;
   bool flush_access_log_on_new_request_;
@@ -22,15 +22,13 @@ Api::SysCallIntResult makeInvalidSyscallResult() {
 }
 
 /**
- * Move at most max_length from src to dst. If the dst is close or beyond high watermark, move no
- * more than 16K. It's not an error if src buffer doesn't contain enough data.
+ * Limit max_length by the room left in dst. If the dst is close or beyond high watermark, the limit
+ * is 16K.
  * @param dst supplies the buffer where the data is move to.
- * @param src supplies the buffer where the data is move from.
- * @param max_length supplies the max bytes the call can move.
- * @return number of bytes this call moves.
+ * @param max_length supplies the max bytes the caller wants to move.
+ * @return the max bytes which can be moved to dst.
  */
-uint64_t moveUpTo(Buffer::Instance& dst, Buffer::Instance& src, uint64_t max_length) {
-  ASSERT(src.length() > 0);
+uint64_t maxBytesToMove(const Buffer::Instance& dst, uint64_t max_length) {
   if (dst.highWatermark() != 0) {
     if (dst.length() < dst.highWatermark()) {
       // Move until high watermark so that high watermark is not triggered.
@@ -42,7 +40,45 @@ uint64_t moveUpTo(Buffer::Instance& dst, Buffer::Instance& src, uint64_t max_len
       max_length = std::min<uint64_t>(max_length, FRAGMENT_SIZE);
     }
   }
-  uint64_t res = std::min(max_length, src.length());
+  return max_length;
+}
+
+/**
+ * Move at most max_length from src to dst. If the dst is close or beyond high watermark, move no
+ * more than 16K. It's not an error if src buffer doesn't contain enough data.
+ * @param dst supplies the buffer where the data is move to.
+ * @param src supplies the buffer where the data is move from.
+ * @param max_length supplies the max bytes the call can move.
+ * @return number of bytes this call moves.
+ */
+uint64_t moveUpTo(Buffer::Instance& dst, Buffer::Instance& src, uint64_t max_length) {
+  ASSERT(src.length() > 0);
+  uint64_t res = std::min(maxBytesToMove(dst, max_length), src.length());
+  dst.move(src, res, /*reset_drain_trackers_and_accounting=*/true);
+  return res;
+}
+
+/**
+ * Move whole slices from src to dst, so that the ownership of the slices is transferred instead of
+ * copying their data. As in any buffer move, slices under 512 bytes are copied into the last slice
+ * of dst if they fit. Slices are moved while they fit within the limit of moveUpTo(), but the first
+ * slice is always moved, so dst may exceed its high watermark by up to one slice.
+ * @param dst supplies the buffer where the data is move to.
+ * @param src supplies the buffer where the data is move from.
+ * @param max_length supplies the max bytes the call can move.
+ * @return number of bytes this call moves.
+ */
+uint64_t moveSlicesUpTo(Buffer::Instance& dst, Buffer::Instance& src, uint64_t max_length) {
+  ASSERT(src.length() > 0);
+  max_length = maxBytesToMove(dst, max_length);
+  uint64_t res = 0;
+  // Bound the number of inspected slices so that the slice vector does not allocate.
+  for (const Buffer::RawSlice& slice : src.getRawSlices(MAX_MOVED_SLICES)) {
+    if (res > 0 && res + slice.len_ > max_length) {
+      break;
+    }
+    res += slice.len_;
+  }
   dst.move(src, res, /*reset_drain_trackers_and_accounting=*/true);
   return res;
 }
@@ -138,7 +174,10 @@ Api::IoCallUint64Result IoHandleImpl::read(Buffer::Instance& buffer,
       return {0, Network::IoSocketError::getIoSocketEagainError()};
     }
   }
-  const uint64_t bytes_to_read = moveUpTo(buffer, pending_received_data_, max_length);
+  // An explicit max length is a hard limit, so a slice may have to be split.
+  const uint64_t bytes_to_read = zero_copy_ && !max_length_opt.has_value()
+                                     ? moveSlicesUpTo(buffer, pending_received_data_, max_length)
+                                     : moveUpTo(buffer, pending_received_data_, max_length);
   return {bytes_to_read, Api::IoError::none()};
 }
 
@@ -207,10 +246,11 @@ Api::IoCallUint64Result IoHandleImpl::write(Buffer::Instance& buffer) {
     return {0, Network::IoSocketError::getIoSocketEagainError()};
   }
   const uint64_t max_bytes_to_write = buffer.length();
+  // Below value comes from Buffer::OwnedImpl::default_read_reservation_size_.
+  const uint64_t max_length = MAX_FRAGMENT * FRAGMENT_SIZE;
   const uint64_t total_bytes_to_write =
-      moveUpTo(*peer_handle_->getWriteBuffer(), buffer,
-               // Below value comes from Buffer::OwnedImpl::default_read_reservation_size_.
-               MAX_FRAGMENT * FRAGMENT_SIZE);
+      zero_copy_ ? moveSlicesUpTo(*peer_handle_->getWriteBuffer(), buffer, max_length)
+                 : moveUpTo(*peer_handle_->getWriteBuffer(), buffer, max_length);
   peer_handle_->setNewDataAvailable();
   ENVOY_LOG(trace, "socket {} write {} bytes of {}", static_cast<void*>(this), total_bytes_to_write,
             max_bytes_to_write);
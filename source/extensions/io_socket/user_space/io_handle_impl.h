@@ -24,6 +24,8 @@ namespace UserSpace {
 constexpr uint32_t MAX_FRAGMENT = 8;
 // Align with Buffer::Slice::default_slice_size_
 constexpr uint64_t FRAGMENT_SIZE = 16 * 1024;
+// Align with the inline capacity of Buffer::RawSliceVector.
+constexpr uint64_t MAX_MOVED_SLICES = 16;
 
 /**
  * Network::IoHandle implementation which provides a buffer as data source. It is designed to used
@@ -69,6 +71,7 @@ public:
   Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) override;
   bool supportsMmsg() const override;
   bool supportsUdpGro() const override;
+  bool supportsAdaptiveReadSize() const override { return false; }
   Api::SysCallIntResult bind(Network::Address::InstanceConstSharedPtr address) override;
   Api::SysCallIntResult listen(int backlog) override;
   Network::IoHandlePtr accept(struct sockaddr* addr, socklen_t* addrlen) override;
@@ -96,6 +99,9 @@ public:
   absl::optional<std::string> interfaceName() override { return absl::nullopt; }
 
   void setWatermarks(uint32_t watermark) { pending_received_data_.setWatermarks(watermark); }
+  // If true, write() and the unbounded read() transfer whole slices instead of splitting the last
+  // slice at the size limit, so that no data is copied.
+  void setZeroCopy(bool zero_copy) { zero_copy_ = zero_copy; }
   void onBelowLowWatermark() {
     if (peer_handle_) {
       ENVOY_LOG(debug, "Socket {} switches to low watermark. Notify {}.", static_cast<void*>(this),
@@ -184,6 +190,9 @@ private:
 
   // Shared state between peer handles.
   PassthroughStateSharedPtr passthrough_state_{nullptr};
+
+  // Whether write() and the unbounded read() move whole slices only.
+  bool zero_copy_{false};
 };
 
 class PassthroughStateImpl : public PassthroughState, public Logger::Loggable<Logger::Id::io> {
@@ -212,7 +221,7 @@ public:
     return p;
   }
   static std::pair<IoHandleImplPtr, IoHandleImplPtr>
-  createBufferLimitedIoHandlePair(uint32_t buffer_size) {
+  createBufferLimitedIoHandlePair(uint32_t buffer_size, bool zero_copy = false) {
     auto state = std::make_shared<PassthroughStateImpl>();
     auto p = std::pair<IoHandleImplPtr, IoHandleImplPtr>{new IoHandleImpl(state),
                                                          new IoHandleImpl(state)};
@@ -220,6 +229,8 @@ public:
     // `/proc/sys/net/ipv4/tcp_{r,w}mem`.
     p.first->setWatermarks(buffer_size);
     p.second->setWatermarks(buffer_size);
+    p.first->setZeroCopy(zero_copy);
+    p.second->setZeroCopy(zero_copy);
     p.first->setPeerHandle(p.second.get());
     p.second->setPeerHandle(p.first.get());
     return p;
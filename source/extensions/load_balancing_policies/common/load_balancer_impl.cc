@@ -687,7 +687,7 @@ uint32_t ZoneAwareLoadBalancerBase::tryChooseLocalLocalityHosts(const HostSet& h
 
   // If we cannot route all requests to the same locality, we already calculated how much we can
   // push to the local locality, check if we can push to local locality on current iteration.
-  if (random_.random() % 10000 < state.local_percent_to_route_) {
+  if (random_.fastRandom() % 10000 < state.local_percent_to_route_) {
     stats_.lb_zone_routing_sampled_.inc();
     return 0;
   }
@@ -699,12 +699,12 @@ uint32_t ZoneAwareLoadBalancerBase::tryChooseLocalLocalityHosts(const HostSet& h
   // locality percentages. In this case just select random locality.
   if (state.residual_capacity_[number_of_localities - 1] == 0) {
     stats_.lb_zone_no_capacity_left_.inc();
-    return random_.random() % number_of_localities;
+    return random_.fastRandom() % number_of_localities;
   }
 
   // Random sampling to select specific locality for cross locality traffic based on the
   // additional capacity in localities.
-  uint64_t threshold = random_.random() % state.residual_capacity_[number_of_localities - 1];
+  uint64_t threshold = random_.fastRandom() % state.residual_capacity_[number_of_localities - 1];
 
   // This potentially can be optimized to be O(log(N)) where N is the number of localities.
   // Linear scan should be faster for smaller N, in most of the scenarios N will be small.
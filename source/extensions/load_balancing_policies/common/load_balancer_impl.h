@@ -160,7 +160,7 @@ protected:
   bool isInPanic(uint32_t priority) const { return per_priority_panic_[priority]; }
   uint64_t random(bool peeking) {
     if (peeking) {
-      stashed_random_.push_back(random_.random());
+      stashed_random_.push_back(random_.fastRandom());
       return stashed_random_.back();
     } else {
       if (!stashed_random_.empty()) {
@@ -168,7 +168,7 @@ protected:
         stashed_random_.pop_front();
         return random;
       } else {
-        return random_.random();
+        return random_.fastRandom();
       }
     }
   }
@@ -161,7 +161,7 @@ ThreadAwareLoadBalancerBase::LoadBalancerImpl::chooseHost(LoadBalancerContext* c
   if (context) {
     hash = context->computeHashKey();
   }
-  const uint64_t h = hash ? hash.value() : random_.random();
+  const uint64_t h = hash ? hash.value() : random_.fastRandom();
 
   const uint32_t priority =
       LoadBalancerBase::choosePriority(h, *healthy_per_priority_load_, *degraded_per_priority_load_)
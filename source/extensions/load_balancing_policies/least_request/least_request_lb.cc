@@ -106,7 +106,7 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVec
       // with probability (1 / num_hosts_known_tied_for_least percent).
       // The end result is that each tied host has an equal 1 / N chance of being the
       // candidate_host returned by this function.
-      const size_t random_tied_host_index = random_.random() % num_hosts_known_tied_for_least;
+      const size_t random_tied_host_index = random_.fastRandom() % num_hosts_known_tied_for_least;
       if (random_tied_host_index == 0) {
         candidate_host = sampled_host;
       }
@@ -120,7 +120,7 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVec
   HostSharedPtr candidate_host = nullptr;
 
   for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
-    const int rand_idx = random_.random() % hosts_to_use.size();
+    const int rand_idx = random_.fastRandom() % hosts_to_use.size();
     const HostSharedPtr& sampled_host = hosts_to_use[rand_idx];
 
     if (candidate_host == nullptr) {
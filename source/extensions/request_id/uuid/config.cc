@@ -16,8 +16,10 @@ void UUIDRequestIDExtension::set(Http::RequestHeaderMap& request_headers, bool f
     return;
   }
 
-  // TODO(PiotrSikora) PERF: Write UUID directly to the header map.
-  std::string uuid = random_.uuid();
+  // The UUID is written to a buffer on the stack and copied into the inline storage of the header
+  // value, so that no string is allocated for it.
+  Random::RandomGenerator::UuidBuffer buffer;
+  const absl::string_view uuid = random_.writeUuid(buffer);
   ASSERT(!uuid.empty());
   request_headers.setRequestId(uuid);
 }
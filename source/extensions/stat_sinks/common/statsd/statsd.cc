@@ -3,6 +3,7 @@
 #include <chrono>
 #include <cstdint>
 #include <string>
+#include <type_traits>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/exception.h"
@@ -15,13 +16,14 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/hash.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/utility.h"
 #include "source/common/network/socket_interface.h"
 #include "source/common/network/utility.h"
 #include "source/common/stats/symbol_table.h"
 
-#include "absl/strings/str_join.h"
+#include "absl/strings/str_cat.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -47,10 +49,12 @@ void UdpStatsdSink::WriterImpl::writeBuffer(Buffer::Instance& data) {
 UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
                              Network::Address::InstanceConstSharedPtr address, const bool use_tag,
                              const std::string& prefix, absl::optional<uint64_t> buffer_size,
-                             const Statsd::TagFormat& tag_format)
+                             const Statsd::TagFormat& tag_format,
+                             const bool export_changed_metrics_only)
     : tls_(tls.allocateSlot()), server_address_(std::move(address)), use_tag_(use_tag),
       prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
-      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+      export_changed_metrics_only_(export_changed_metrics_only) {
   tls_->set([this](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
     return std::make_shared<WriterImpl>(*this);
   });
@@ -58,61 +62,84 @@ UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
 
 void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
   Writer& writer = tls_->getTyped<Writer>();
-  Buffer::OwnedImpl buffer;
 
   for (const auto& counter : snapshot.counters()) {
-    if (counter.counter_.get().used()) {
-      const std::string counter_str = buildMessage(counter.counter_.get(), counter.delta_, "|c");
-      writeBuffer(buffer, writer, counter_str);
+    if (counter.counter_.get().used() && (!export_changed_metrics_only_ || counter.delta_ > 0)) {
+      writeMetric(writer, counter.counter_.get(), counter.delta_, "|c");
     }
   }
 
   for (const auto& counter : snapshot.hostCounters()) {
-    const std::string counter_str = buildMessage(counter, counter.delta(), "|c");
-    writeBuffer(buffer, writer, counter_str);
+    if (!export_changed_metrics_only_ || counter.delta() > 0) {
+      writeMetric(writer, counter, counter.delta(), "|c");
+    }
   }
 
   for (const auto& gauge : snapshot.gauges()) {
-    if (gauge.get().used()) {
-      const std::string gauge_str = buildMessage(gauge.get(), gauge.get().value(), "|g");
-      writeBuffer(buffer, writer, gauge_str);
+    if (gauge.get().used() &&
+        (!export_changed_metrics_only_ ||
+         gaugeChanged(gauge.get().statName().hash(), gauge.get().value()))) {
+      writeMetric(writer, gauge.get(), gauge.get().value(), "|g");
     }
   }
 
   for (const auto& gauge : snapshot.hostGauges()) {
-    const std::string gauge_str = buildMessage(gauge, gauge.value(), "|g");
-    writeBuffer(buffer, writer, gauge_str);
+    if (!export_changed_metrics_only_ ||
+        gaugeChanged(HashUtil::xxHash64(gauge.name()), gauge.value())) {
+      writeMetric(writer, gauge, gauge.value(), "|g");
+    }
   }
 
-  flushBuffer(buffer, writer);
+  flushDatagram(writer);
+
+  if (export_changed_metrics_only_) {
+    // Gauges which are not part of this snapshot are forgotten. Both maps keep their capacity, so
+    // tracking the gauge values does not allocate in the steady state.
+    gauge_values_.swap(new_gauge_values_);
+    new_gauge_values_.clear();
+  }
   // TODO(efimki): Add support of text readouts stats.
 }
 
-void UdpStatsdSink::writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer,
-                                const std::string& statsd_metric) const {
-  if (statsd_metric.length() >= buffer_size_) {
-    // Our statsd_metric is too large to fit into the buffer, skip buffering and write directly
-    writer.write(statsd_metric);
+bool UdpStatsdSink::gaugeChanged(uint64_t name_hash, uint64_t value) {
+  new_gauge_values_[name_hash] = value;
+  const auto it = gauge_values_.find(name_hash);
+  return it == gauge_values_.end() || it->second != value;
+}
+
+template <class StatType, typename ValueType>
+void UdpStatsdSink::writeMetric(Writer& writer, const StatType& metric, ValueType value,
+                                absl::string_view type) {
+  message_.clear();
+  appendMessage(message_, metric, value, type);
+
+  if (message_.length() >= buffer_size_) {
+    // Our metric is too large to fit into the buffer, skip buffering and write directly
+    writer.write(message_);
   } else {
-    if ((buffer.length() + statsd_metric.length() + 1) > buffer_size_) {
-      // If we add the new statsd_metric, we'll overflow our buffer. Flush the buffer to make
-      // room for the new statsd_metric.
-      flushBuffer(buffer, writer);
-    } else if (buffer.length() > 0) {
+    if ((datagram_.length() + message_.length() + 1) > buffer_size_) {
+      // If we add the new metric, we'll overflow our buffer. Flush the buffer to make room for the
+      // new metric.
+      flushDatagram(writer);
+    } else if (!datagram_.empty()) {
       // We have room and have metrics already in the buffer, add a newline to separate
       // metric entries.
-      buffer.add("\n");
+      datagram_.push_back('\n');
     }
-    buffer.add(statsd_metric);
+    datagram_.append(message_);
   }
 }
 
-void UdpStatsdSink::flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const {
-  if (buffer.length() == 0) {
+void UdpStatsdSink::flushDatagram(Writer& writer) {
+  if (datagram_.empty()) {
     return;
   }
-  writer.writeBuffer(buffer);
-  buffer.drain(buffer.length());
+  // The buffer references the datagram instead of copying it into slices of its own.
+  Buffer::BufferFragmentImpl fragment(datagram_.data(), datagram_.size(), nullptr);
+  buffer_.addBufferFragment(fragment);
+  writer.writeBuffer(buffer_);
+  buffer_.drain(buffer_.length());
+  datagram_.clear();
 }
 
 void UdpStatsdSink::onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) {
@@ -129,61 +156,79 @@ void UdpStatsdSink::onHistogramComplete(const Stats::Histogram& histogram, uint6
     constexpr float divisor = Stats::Histogram::PercentScale;
     const float float_value = value;
     const float scaled = float_value / divisor;
-    message = buildMessage(histogram, scaled, "|h");
+    appendMessage(message, histogram, scaled, "|h");
   } else {
-    message = buildMessage(histogram, std::chrono::milliseconds(value).count(), "|ms");
+    appendMessage(message, histogram, std::chrono::milliseconds(value).count(), "|ms");
   }
   tls_->getTyped<Writer>().write(message);
 }
 
 template <class StatType, typename ValueType>
-const std::string UdpStatsdSink::buildMessage(const StatType& metric, ValueType value,
-                                              const std::string& type) const {
+void UdpStatsdSink::appendMessage(std::string& message, const StatType& metric, ValueType value,
+                                  absl::string_view type) const {
   switch (tag_format_.tag_position) {
-  case Statsd::TagPosition::TagAfterValue: {
-    const std::string message = absl::StrCat(
-        // metric name
-        prefix_, ".", getName(metric),
-        // value and type
-        ":", value, type,
-        // tags
-        buildTagStr(metric.tags()));
-    return message;
-  }
+  case Statsd::TagPosition::TagAfterValue:
+    // metric name, value and type
+    absl::StrAppend(&message, prefix_, ".");
+    appendName(message, metric);
+    absl::StrAppend(&message, ":", value, type);
+    // tags
+    appendTags(message, metric);
+    return;
 
-  case Statsd::TagPosition::TagAfterName: {
-    const std::string message = absl::StrCat(
-        // metric name
-        prefix_, ".", getName(metric),
-        // tags
-        buildTagStr(metric.tags()),
-        // value and type
-        ":", value, type);
-    return message;
-  }
+  case Statsd::TagPosition::TagAfterName:
+    // metric name
+    absl::StrAppend(&message, prefix_, ".");
+    appendName(message, metric);
+    // tags
+    appendTags(message, metric);
+    // value and type
+    absl::StrAppend(&message, ":", value, type);
+    return;
   }
   PANIC_DUE_TO_CORRUPT_ENUM;
 }
 
-template <class StatType> const std::string UdpStatsdSink::getName(const StatType& metric) const {
-  if (use_tag_) {
-    return metric.tagExtractedName();
+template <class StatType>
+void UdpStatsdSink::appendName(std::string& message, const StatType& metric) const {
+  if constexpr (std::is_base_of_v<Stats::Metric, StatType>) {
+    // Decode the stat name in place rather than building a string per metric.
+    const Stats::StatName stat_name = use_tag_ ? metric.tagExtractedStatName() : metric.statName();
+    metric.constSymbolTable().appendTo(stat_name, message);
   } else {
-    return metric.name();
+    message.append(use_tag_ ? metric.tagExtractedName() : metric.name());
   }
 }
 
-const std::string UdpStatsdSink::buildTagStr(const std::vector<Stats::Tag>& tags) const {
-  if (!use_tag_ || tags.empty()) {
-    return "";
+template <class StatType>
+void UdpStatsdSink::appendTags(std::string& message, const StatType& metric) const {
+  if (!use_tag_) {
+    return;
   }
 
-  std::vector<std::string> tag_strings;
-  tag_strings.reserve(tags.size());
-  for (const Stats::Tag& tag : tags) {
-    tag_strings.emplace_back(tag.name_ + tag_format_.assign + tag.value_);
+  if constexpr (std::is_base_of_v<Stats::Metric, StatType>) {
+    // The state is captured by a single reference, so that the callback fits in the inline storage
+    // of std::function.
+    struct TagsState {
+      std::string& message_;
+      const Stats::SymbolTable& symbol_table_;
+      bool first_;
+    } state{message, metric.constSymbolTable(), true};
+    metric.iterateTagStatNames([this, &state](Stats::StatName name, Stats::StatName value) {
+      state.message_.append(state.first_ ? tag_format_.start : tag_format_.separator);
+      state.first_ = false;
+      state.symbol_table_.appendTo(name, state.message_);
+      state.message_.append(tag_format_.assign);
+      state.symbol_table_.appendTo(value, state.message_);
+      return true;
+    });
+  } else {
+    const Stats::TagVector& tags = metric.tags();
+    for (size_t i = 0; i < tags.size(); i++) {
+      message.append(i == 0 ? tag_format_.start : tag_format_.separator);
+      absl::StrAppend(&message, tags[i].name_, tag_format_.assign, tags[i].value_);
+    }
   }
-  return tag_format_.start + absl::StrJoin(tag_strings, tag_format_.separator);
 }
 
 TcpStatsdSink::TcpStatsdSink(const LocalInfo::LocalInfo& local_info,
@@ -17,6 +17,8 @@
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/extensions/stat_sinks/common/statsd/tag_formats.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -44,15 +46,18 @@ public:
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Network::Address::InstanceConstSharedPtr address,
                 const bool use_tag, const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
-                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat());
+                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat(),
+                const bool export_changed_metrics_only = false);
   // For testing.
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, const std::shared_ptr<Writer>& writer,
                 const bool use_tag, const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
-                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat())
+                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat(),
+                const bool export_changed_metrics_only = false)
       : tls_(tls.allocateSlot()), use_tag_(use_tag),
         prefix_(prefix.empty() ? getDefaultPrefix() : prefix),
-        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+        export_changed_metrics_only_(export_changed_metrics_only) {
     tls_->set(
         [writer](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr { return writer; });
   }
@@ -63,6 +68,7 @@ public:
 
   bool getUseTagForTest() { return use_tag_; }
   uint64_t getBufferSizeForTest() { return buffer_size_; }
+  bool getExportChangedMetricsOnlyForTest() { return export_changed_metrics_only_; }
   const std::string& getPrefix() { return prefix_; }
 
 private:
@@ -82,14 +88,21 @@ private:
     const Network::IoHandlePtr io_handle_;
   };
 
-  void flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const;
-  void writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer, const std::string& data) const;
+  void flushDatagram(Writer& writer);
+  // Formats the metric into the reusable message buffer and packs it into the datagram.
+  template <class StatType, typename ValueType>
+  void writeMetric(Writer& writer, const StatType& metric, ValueType value,
+                   absl::string_view type);
+  // Returns true if the gauge should be flushed, and records its value for the next flush.
+  bool gaugeChanged(uint64_t name_hash, uint64_t value);
 
   template <class StatType, typename ValueType>
-  const std::string buildMessage(const StatType& metric, ValueType value,
-                                 const std::string& type) const;
-  template <class StatType> const std::string getName(const StatType& metric) const;
-  const std::string buildTagStr(const std::vector<Stats::Tag>& tags) const;
+  void appendMessage(std::string& message, const StatType& metric, ValueType value,
+                     absl::string_view type) const;
+  // Stats::Metric names and tags are decoded from their stat names, while the host metrics of the
+  // snapshot keep them as strings.
+  template <class StatType> void appendName(std::string& message, const StatType& metric) const;
+  template <class StatType> void appendTags(std::string& message, const StatType& metric) const;
 
   const ThreadLocal::SlotPtr tls_;
   const Network::Address::InstanceConstSharedPtr server_address_;
@@ -98,6 +111,18 @@ private:
   const std::string prefix_;
   const uint64_t buffer_size_;
   const Statsd::TagFormat tag_format_;
+  const bool export_changed_metrics_only_;
+  // Reused across flushes, which all happen on the main thread, so that formatting and packing
+  // metrics does not allocate once the strings have grown to the size of the longest metric and
+  // datagram.
+  std::string message_;
+  std::string datagram_;
+  // Hands the datagram to the writer without copying it.
+  Buffer::OwnedImpl buffer_;
+  // The gauge values sent by the previous flush, keyed by the hash of the gauge name, and the
+  // values of the current flush. Only used when sending changed metrics only.
+  absl::flat_hash_map<uint64_t, uint64_t> gauge_values_;
+  absl::flat_hash_map<uint64_t, uint64_t> new_gauge_values_;
 };
 
 /**
@@ -20,7 +20,7 @@ OpenTelemetrySinkFactory::createStatsSink(const Protobuf::Message& config,
 
   auto otlp_options = std::make_shared<OtlpOptions>(sink_config);
   std::shared_ptr<OtlpMetricsFlusher> otlp_metrics_flusher =
-      std::make_shared<OtlpMetricsFlusherImpl>(otlp_options);
+      std::make_shared<OtlpMetricsFlusherImpl>(otlp_options, server.scope());
 
   switch (sink_config.protocol_specifier_case()) {
   case SinkConfig::ProtocolSpecifierCase::kGrpcService: {
@@ -34,6 +34,11 @@ OpenTelemetrySinkFactory::createStatsSink(const Protobuf::Message& config,
         std::make_shared<OpenTelemetryGrpcMetricsExporterImpl>(otlp_options,
                                                                client_or_error.value());
 
+    if (otlp_options->maxDataPointsPerRequest() > 0) {
+      return std::make_unique<OpenTelemetryGrpcSink>(otlp_metrics_flusher, grpc_metrics_exporter,
+                                                     server.mainThreadDispatcher(), server.scope(),
+                                                     otlp_options->maxDataPointsPerRequest());
+    }
     return std::make_unique<OpenTelemetryGrpcSink>(otlp_metrics_flusher, grpc_metrics_exporter);
   }
 
@@ -1,5 +1,8 @@
 #include "source/extensions/stat_sinks/open_telemetry/open_telemetry_impl.h"
 
+#include <algorithm>
+
+#include "source/common/common/hash.h"
 #include "source/common/tracing/null_span_impl.h"
 
 namespace Envoy {
@@ -14,7 +17,12 @@ OtlpOptions::OtlpOptions(const SinkConfig& sink_config)
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, emit_tags_as_attributes, true)),
       use_tag_extracted_name_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, use_tag_extracted_name, true)),
-      stat_prefix_(!sink_config.prefix().empty() ? sink_config.prefix() + "." : "") {}
+      stat_prefix_(!sink_config.prefix().empty() ? sink_config.prefix() + "." : ""),
+      export_changed_metrics_only_(sink_config.export_changed_metrics_only()),
+      max_data_points_per_metric_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, max_data_points_per_metric, 0)),
+      max_data_points_per_request_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, max_data_points_per_request, 0)) {}
 
 OpenTelemetryGrpcMetricsExporterImpl::OpenTelemetryGrpcMetricsExporterImpl(
     const OtlpOptionsSharedPtr config, Grpc::RawAsyncClientSharedPtr raw_async_client)
@@ -42,7 +50,13 @@ void OpenTelemetryGrpcMetricsExporterImpl::onFailure(Grpc::Status::GrpcStatus re
   ENVOY_LOG(debug, "export failure; status: {}, message: {}", response_status, response_message);
 }
 
-MetricsExportRequestPtr OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& snapshot) const {
+OtlpMetricsFlusherImpl::OtlpMetricsFlusherImpl(
+    const OtlpOptionsSharedPtr config, Stats::Scope& scope,
+    std::function<bool(const Stats::Metric&)> predicate)
+    : config_(config), predicate_(predicate),
+      stats_{OPEN_TELEMETRY_SINK_STATS(POOL_COUNTER_PREFIX(scope, "open_telemetry_sink"))} {}
+
+MetricsExportRequestPtr OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& snapshot) {
   auto request = std::make_unique<MetricsExportRequest>();
   auto* resource_metrics = request->add_resource_metrics();
   auto* scope_metrics = resource_metrics->add_scope_metrics();
@@ -51,44 +65,111 @@ MetricsExportRequestPtr OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& sna
                                  snapshot.snapshotTime().time_since_epoch())
                                  .count();
 
+  const bool changed_only = config_->exportChangedMetricsOnly();
+  FlushState state;
+
   for (const auto& gauge : snapshot.gauges()) {
-    if (predicate_(gauge)) {
-      flushGauge(*scope_metrics->add_metrics(), gauge.get(), snapshot_time_ns);
+    if (!predicate_(gauge)) {
+      continue;
+    }
+    const uint64_t name_hash = changed_only ? gauge.get().statName().hash() : 0;
+    if (!changed_only || gaugeChanged(state, name_hash, gauge.get().value())) {
+      if (auto* metric = addMetric(*scope_metrics, state, gauge.get()); metric != nullptr) {
+        flushGauge(*metric, gauge.get(), snapshot_time_ns);
+        if (changed_only) {
+          state.gauge_values_[name_hash] = gauge.get().value();
+        }
+      }
     }
   }
 
   for (const auto& gauge : snapshot.hostGauges()) {
-    flushGauge(*scope_metrics->add_metrics(), gauge, snapshot_time_ns);
+    const uint64_t name_hash = changed_only ? HashUtil::xxHash64(gauge.name()) : 0;
+    if (!changed_only || gaugeChanged(state, name_hash, gauge.value())) {
+      if (auto* metric = addMetric(*scope_metrics, state, gauge); metric != nullptr) {
+        flushGauge(*metric, gauge, snapshot_time_ns);
+        if (changed_only) {
+          state.gauge_values_[name_hash] = gauge.value();
+        }
+      }
+    }
   }
 
   for (const auto& counter : snapshot.counters()) {
-    if (predicate_(counter.counter_)) {
-      flushCounter(*scope_metrics->add_metrics(), counter.counter_.get(),
-                   counter.counter_.get().value(), counter.delta_, snapshot_time_ns);
+    if (predicate_(counter.counter_) && (!changed_only || counter.delta_ > 0)) {
+      if (auto* metric = addMetric(*scope_metrics, state, counter.counter_.get());
+          metric != nullptr) {
+        flushCounter(*metric, counter.counter_.get(), counter.counter_.get().value(),
+                     counter.delta_, snapshot_time_ns);
+      }
     }
   }
 
   for (const auto& counter : snapshot.hostCounters()) {
-    flushCounter(*scope_metrics->add_metrics(), counter, counter.value(), counter.delta(),
-                 snapshot_time_ns);
+    if (!changed_only || counter.delta() > 0) {
+      if (auto* metric = addMetric(*scope_metrics, state, counter); metric != nullptr) {
+        flushCounter(*metric, counter, counter.value(), counter.delta(), snapshot_time_ns);
+      }
+    }
   }
 
   for (const auto& histogram : snapshot.histograms()) {
-    if (predicate_(histogram)) {
-      flushHistogram(*scope_metrics->add_metrics(), histogram, snapshot_time_ns);
+    if (predicate_(histogram) &&
+        (!changed_only || histogram.get().intervalStatistics().sampleCount() > 0)) {
+      if (auto* metric = addMetric(*scope_metrics, state, histogram.get()); metric != nullptr) {
+        flushHistogram(*metric, histogram, snapshot_time_ns);
+      }
     }
   }
 
+  if (changed_only) {
+    // Gauges which were not part of this snapshot are forgotten, so that the map does not grow
+    // with deleted stats.
+    gauge_values_.swap(state.gauge_values_);
+  }
+
   return request;
 }
 
+bool OtlpMetricsFlusherImpl::gaugeChanged(FlushState& state, uint64_t name_hash,
+                                          uint64_t value) const {
+  const auto it = gauge_values_.find(name_hash);
+  if (it == gauge_values_.end() || it->second != value) {
+    return true;
+  }
+  state.gauge_values_.emplace(name_hash, value);
+  return false;
+}
+
+template <class StatType>
+opentelemetry::proto::metrics::v1::Metric*
+OtlpMetricsFlusherImpl::addMetric(opentelemetry::proto::metrics::v1::ScopeMetrics& scope_metrics,
+                                  FlushState& state, const StatType& stat) const {
+  std::string name = absl::StrCat(config_->statPrefix(), config_->useTagExtractedName()
+                                                             ? stat.tagExtractedName()
+                                                             : stat.name());
+  const uint32_t max_data_points = config_->maxDataPointsPerMetric();
+  if (max_data_points > 0) {
+    uint32_t& data_points = state.data_points_per_metric_[name];
+    if (data_points >= max_data_points) {
+      stats_.cardinality_limited_.inc();
+      return nullptr;
+    }
+    ++data_points;
+  }
+
+  auto* metric = scope_metrics.add_metrics();
+  metric->set_name(std::move(name));
+  return metric;
+}
+
 template <class GaugeType>
 void OtlpMetricsFlusherImpl::flushGauge(opentelemetry::proto::metrics::v1::Metric& metric,
                                         const GaugeType& gauge_stat,
                                         int64_t snapshot_time_ns) const {
   auto* data_point = metric.mutable_gauge()->add_data_points();
   data_point->set_time_unix_nano(snapshot_time_ns);
-  setMetricCommon(metric, *data_point, snapshot_time_ns, gauge_stat);
+  setMetricCommon(*data_point, snapshot_time_ns, gauge_stat);
 
   data_point->set_as_int(gauge_stat.value());
 }
@@ -100,7 +181,7 @@ void OtlpMetricsFlusherImpl::flushCounter(opentelemetry::proto::metrics::v1::Met
   auto* sum = metric.mutable_sum();
   sum->set_is_monotonic(true);
   auto* data_point = sum->add_data_points();
-  setMetricCommon(metric, *data_point, snapshot_time_ns, counter);
+  setMetricCommon(*data_point, snapshot_time_ns, counter);
 
   if (config_->reportCountersAsDeltas()) {
     sum->set_aggregation_temporality(AggregationTemporality::AGGREGATION_TEMPORALITY_DELTA);
@@ -116,7 +197,7 @@ void OtlpMetricsFlusherImpl::flushHistogram(opentelemetry::proto::metrics::v1::M
                                             int64_t snapshot_time_ns) const {
   auto* histogram = metric.mutable_histogram();
   auto* data_point = histogram->add_data_points();
-  setMetricCommon(metric, *data_point, snapshot_time_ns, parent_histogram);
+  setMetricCommon(*data_point, snapshot_time_ns, parent_histogram);
 
   histogram->set_aggregation_temporality(
       config_->reportHistogramsAsDeltas()
@@ -145,14 +226,10 @@ void OtlpMetricsFlusherImpl::flushHistogram(opentelemetry::proto::metrics::v1::M
 
 template <class StatType>
 void OtlpMetricsFlusherImpl::setMetricCommon(
-    opentelemetry::proto::metrics::v1::Metric& metric,
     opentelemetry::proto::metrics::v1::NumberDataPoint& data_point, int64_t snapshot_time_ns,
     const StatType& stat) const {
   data_point.set_time_unix_nano(snapshot_time_ns);
   // TODO(ohadvano): support ``start_time_unix_nano`` optional field
-  metric.set_name(absl::StrCat(config_->statPrefix(), config_->useTagExtractedName()
-                                                          ? stat.tagExtractedName()
-                                                          : stat.name()));
 
   if (config_->emitTagsAsAttributes()) {
     for (const auto& tag : stat.tags()) {
@@ -164,14 +241,10 @@ void OtlpMetricsFlusherImpl::setMetricCommon(
 }
 
 void OtlpMetricsFlusherImpl::setMetricCommon(
-    opentelemetry::proto::metrics::v1::Metric& metric,
     opentelemetry::proto::metrics::v1::HistogramDataPoint& data_point, int64_t snapshot_time_ns,
     const Stats::Metric& stat) const {
   data_point.set_time_unix_nano(snapshot_time_ns);
   // TODO(ohadvano): support ``start_time_unix_nano optional`` field
-  metric.set_name(absl::StrCat(config_->statPrefix(), config_->useTagExtractedName()
-                                                          ? stat.tagExtractedName()
-                                                          : stat.name()));
 
   if (config_->emitTagsAsAttributes()) {
     for (const auto& tag : stat.tags()) {
@@ -182,6 +255,118 @@ void OtlpMetricsFlusherImpl::setMetricCommon(
   }
 }
 
+namespace {
+
+uint64_t dataPointCount(const opentelemetry::proto::metrics::v1::Metric& metric) {
+  switch (metric.data_case()) {
+  case opentelemetry::proto::metrics::v1::Metric::kGauge:
+    return metric.gauge().data_points_size();
+  case opentelemetry::proto::metrics::v1::Metric::kSum:
+    return metric.sum().data_points_size();
+  case opentelemetry::proto::metrics::v1::Metric::kHistogram:
+    return metric.histogram().data_points_size();
+  case opentelemetry::proto::metrics::v1::Metric::kExponentialHistogram:
+    return metric.exponential_histogram().data_points_size();
+  case opentelemetry::proto::metrics::v1::Metric::kSummary:
+    return metric.summary().data_points_size();
+  default:
+    return 0;
+  }
+}
+
+// Moves the metrics of the request into requests of at most max_data_points data points. A single
+// metric is never split, so a request may exceed the limit if one metric has more data points.
+std::list<MetricsExportRequestPtr> splitRequest(MetricsExportRequest& request,
+                                                uint32_t max_data_points) {
+  std::list<MetricsExportRequestPtr> requests;
+  opentelemetry::proto::metrics::v1::ScopeMetrics* current_scope_metrics = nullptr;
+  uint64_t current_data_points = 0;
+
+  for (auto& resource_metrics : *request.mutable_resource_metrics()) {
+    for (auto& scope_metrics : *resource_metrics.mutable_scope_metrics()) {
+      current_scope_metrics = nullptr;
+      for (auto& metric : *scope_metrics.mutable_metrics()) {
+        const uint64_t data_points = dataPointCount(metric);
+        if (requests.empty() ||
+            (current_data_points > 0 && current_data_points + data_points > max_data_points)) {
+          requests.push_back(std::make_unique<MetricsExportRequest>());
+          current_scope_metrics = nullptr;
+          current_data_points = 0;
+        }
+        if (current_scope_metrics == nullptr) {
+          auto* new_resource_metrics = requests.back()->add_resource_metrics();
+          *new_resource_metrics->mutable_resource() = resource_metrics.resource();
+          new_resource_metrics->set_schema_url(resource_metrics.schema_url());
+          current_scope_metrics = new_resource_metrics->add_scope_metrics();
+          *current_scope_metrics->mutable_scope() = scope_metrics.scope();
+          current_scope_metrics->set_schema_url(scope_metrics.schema_url());
+        }
+        current_scope_metrics->add_metrics()->Swap(&metric);
+        current_data_points += data_points;
+      }
+    }
+  }
+
+  return requests;
+}
+
+} // namespace
+
+OpenTelemetryGrpcSink::OpenTelemetryGrpcSink(
+    const OtlpMetricsFlusherSharedPtr& otlp_metrics_flusher,
+    const OpenTelemetryGrpcMetricsExporterSharedPtr& grpc_metrics_exporter,
+    Event::Dispatcher& dispatcher, Stats::Scope& scope, uint32_t max_data_points_per_request,
+    uint32_t max_pending_requests)
+    : metrics_flusher_(otlp_metrics_flusher), metrics_exporter_(grpc_metrics_exporter),
+      max_data_points_per_request_(max_data_points_per_request),
+      max_pending_requests_(max_pending_requests),
+      stats_(OpenTelemetrySinkStats{
+          OPEN_TELEMETRY_SINK_STATS(POOL_COUNTER_PREFIX(scope, "open_telemetry_sink"))}),
+      send_pending_cb_(dispatcher.createSchedulableCallback([this]() { sendPendingRequest(); })) {}
+
+void OpenTelemetryGrpcSink::flush(Stats::MetricSnapshot& snapshot) {
+  MetricsExportRequestPtr request = metrics_flusher_->flush(snapshot);
+  if (max_data_points_per_request_ == 0) {
+    metrics_exporter_->send(std::move(request));
+    return;
+  }
+
+  std::list<MetricsExportRequestPtr> requests =
+      splitRequest(*request, max_data_points_per_request_);
+  if (requests.empty()) {
+    // Nothing to export; send the empty request as is done without a limit.
+    metrics_exporter_->send(std::move(request));
+    return;
+  }
+
+  // Send the first request right away, and spread the rest over the next event loop iterations
+  // so that a large flush does not block the main thread.
+  metrics_exporter_->send(std::move(requests.front()));
+  requests.pop_front();
+  // Bound the memory of the requests waiting to be sent, e.g. if the main thread falls behind.
+  const size_t room = max_pending_requests_ - std::min<size_t>(pending_requests_.size(),
+                                                               max_pending_requests_);
+  while (requests.size() > room) {
+    requests.pop_back();
+    stats_->requests_dropped_.inc();
+  }
+  pending_requests_.splice(pending_requests_.end(), requests);
+  if (!pending_requests_.empty()) {
+    send_pending_cb_->scheduleCallbackNextIteration();
+  }
+}
+
+void OpenTelemetryGrpcSink::sendPendingRequest() {
+  if (pending_requests_.empty()) {
+    return;
+  }
+  metrics_exporter_->send(std::move(pending_requests_.front()));
+  pending_requests_.pop_front();
+  if (!pending_requests_.empty()) {
+    send_pending_cb_->scheduleCallbackNextIteration();
+  }
+}
+
 } // namespace OpenTelemetry
 } // namespace StatSinks
 } // namespace Extensions
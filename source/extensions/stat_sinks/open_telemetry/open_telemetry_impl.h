@@ -1,7 +1,9 @@
 #pragma once
 
+#include <list>
 #include <memory>
 
+#include "envoy/event/dispatcher.h"
 #include "envoy/extensions/stat_sinks/open_telemetry/v3/open_telemetry.pb.h"
 #include "envoy/extensions/stat_sinks/open_telemetry/v3/open_telemetry.pb.validate.h"
 #include "envoy/grpc/async_client.h"
@@ -10,9 +12,12 @@
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/grpc/typed_async_client.h"
 
+#include "absl/container/flat_hash_map.h"
+
 #include "opentelemetry/proto/collector/metrics/v1/metrics_service.pb.h"
 #include "opentelemetry/proto/common/v1/common.pb.h"
 #include "opentelemetry/proto/metrics/v1/metrics.pb.h"
@@ -42,6 +47,11 @@ public:
   bool emitTagsAsAttributes() { return emit_tags_as_attributes_; }
   bool useTagExtractedName() { return use_tag_extracted_name_; }
   const std::string& statPrefix() { return stat_prefix_; }
+  bool exportChangedMetricsOnly() { return export_changed_metrics_only_; }
+  // 0 means that there is no limit.
+  uint32_t maxDataPointsPerMetric() { return max_data_points_per_metric_; }
+  // 0 means that there is no limit.
+  uint32_t maxDataPointsPerRequest() { return max_data_points_per_request_; }
 
 private:
   const bool report_counters_as_deltas_;
@@ -49,6 +59,9 @@ private:
   const bool emit_tags_as_attributes_;
   const bool use_tag_extracted_name_;
   const std::string stat_prefix_;
+  const bool export_changed_metrics_only_;
+  const uint32_t max_data_points_per_metric_;
+  const uint32_t max_data_points_per_request_;
 };
 
 using OtlpOptionsSharedPtr = std::shared_ptr<OtlpOptions>;
@@ -61,24 +74,58 @@ public:
    * Creates an OTLP export request from metric snapshot.
    * @param snapshot supplies the metrics snapshot to send.
    */
-  virtual MetricsExportRequestPtr flush(Stats::MetricSnapshot& snapshot) const PURE;
+  virtual MetricsExportRequestPtr flush(Stats::MetricSnapshot& snapshot) PURE;
 };
 
 using OtlpMetricsFlusherSharedPtr = std::shared_ptr<OtlpMetricsFlusher>;
 
+/**
+ * All OpenTelemetry stats sink stats. @see stats_macros.h
+ */
+#define OPEN_TELEMETRY_SINK_STATS(COUNTER)                                                         \
+  COUNTER(cardinality_limited)                                                                     \
+  COUNTER(requests_dropped)
+
+/**
+ * Struct definition for all OpenTelemetry stats sink stats. @see stats_macros.h
+ */
+struct OpenTelemetrySinkStats {
+  OPEN_TELEMETRY_SINK_STATS(GENERATE_COUNTER_STRUCT)
+};
+
 /**
  * Production implementation of OtlpMetricsFlusher
  */
 class OtlpMetricsFlusherImpl : public OtlpMetricsFlusher {
 public:
   OtlpMetricsFlusherImpl(
-      const OtlpOptionsSharedPtr config, std::function<bool(const Stats::Metric&)> predicate =
-                                             [](const auto& metric) { return metric.used(); })
-      : config_(config), predicate_(predicate) {}
+      const OtlpOptionsSharedPtr config, Stats::Scope& scope,
+      std::function<bool(const Stats::Metric&)> predicate =
+          [](const auto& metric) { return metric.used(); });
 
-  MetricsExportRequestPtr flush(Stats::MetricSnapshot& snapshot) const override;
+  MetricsExportRequestPtr flush(Stats::MetricSnapshot& snapshot) override;
 
 private:
+  // Per flush state used to skip unchanged metrics and enforce cardinality limits.
+  struct FlushState {
+    // Number of data points added for each metric name.
+    absl::flat_hash_map<std::string, uint32_t> data_points_per_metric_;
+    // The values of the gauges exported by this flush, keyed by the hash of the gauge name.
+    absl::flat_hash_map<uint64_t, uint64_t> gauge_values_;
+  };
+
+  // Returns true if the gauge changed since its last exported value. An unchanged gauge is kept
+  // for the next flush, while a changed one is only recorded once its data point is added, so
+  // that a gauge dropped by the cardinality limit is exported by a later flush.
+  bool gaugeChanged(FlushState& state, uint64_t name_hash, uint64_t value) const;
+
+  // Adds a metric named after the stat, or returns nullptr if the cardinality limit of the
+  // metric name is reached.
+  template <class StatType>
+  opentelemetry::proto::metrics::v1::Metric*
+  addMetric(opentelemetry::proto::metrics::v1::ScopeMetrics& scope_metrics, FlushState& state,
+            const StatType& stat) const;
+
   template <class GaugeType>
   void flushGauge(opentelemetry::proto::metrics::v1::Metric& metric, const GaugeType& gauge,
                   int64_t snapshot_time_ns) const;
@@ -92,16 +139,18 @@ private:
                       int64_t snapshot_time_ns) const;
 
   template <class StatType>
-  void setMetricCommon(opentelemetry::proto::metrics::v1::Metric& metric,
-                       opentelemetry::proto::metrics::v1::NumberDataPoint& data_point,
+  void setMetricCommon(opentelemetry::proto::metrics::v1::NumberDataPoint& data_point,
                        int64_t snapshot_time_ns, const StatType& stat) const;
 
-  void setMetricCommon(opentelemetry::proto::metrics::v1::Metric& metric,
-                       opentelemetry::proto::metrics::v1::HistogramDataPoint& data_point,
+  void setMetricCommon(opentelemetry::proto::metrics::v1::HistogramDataPoint& data_point,
                        int64_t snapshot_time_ns, const Stats::Metric& stat) const;
 
   const OtlpOptionsSharedPtr config_;
   const std::function<bool(const Stats::Metric&)> predicate_;
+  OpenTelemetrySinkStats stats_;
+  // The values of the gauges exported by the previous flush. Only populated when exporting
+  // changed metrics only.
+  absl::flat_hash_map<uint64_t, uint64_t> gauge_values_;
 };
 
 class OpenTelemetryGrpcMetricsExporter : public Grpc::AsyncRequestCallbacks<MetricsExportResponse> {
@@ -152,16 +201,36 @@ public:
                         const OpenTelemetryGrpcMetricsExporterSharedPtr& grpc_metrics_exporter)
       : metrics_flusher_(otlp_metrics_flusher), metrics_exporter_(grpc_metrics_exporter) {}
 
+  /**
+   * Creates a sink which splits the export of a flush into requests of at most
+   * max_data_points_per_request data points, sent one per dispatcher loop iteration. At most
+   * max_pending_requests requests wait to be sent; the requests over this limit are dropped and
+   * counted in the requests_dropped counter.
+   */
+  OpenTelemetryGrpcSink(const OtlpMetricsFlusherSharedPtr& otlp_metrics_flusher,
+                        const OpenTelemetryGrpcMetricsExporterSharedPtr& grpc_metrics_exporter,
+                        Event::Dispatcher& dispatcher, Stats::Scope& scope,
+                        uint32_t max_data_points_per_request,
+                        uint32_t max_pending_requests = DefaultMaxPendingRequests);
+
+  // The default bound of the requests waiting to be sent.
+  static constexpr uint32_t DefaultMaxPendingRequests = 1024;
+
   // Stats::Sink
-  void flush(Stats::MetricSnapshot& snapshot) override {
-    metrics_exporter_->send(metrics_flusher_->flush(snapshot));
-  }
+  void flush(Stats::MetricSnapshot& snapshot) override;
 
   void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
 
 private:
+  void sendPendingRequest();
+
   const OtlpMetricsFlusherSharedPtr metrics_flusher_;
   const OpenTelemetryGrpcMetricsExporterSharedPtr metrics_exporter_;
+  const uint32_t max_data_points_per_request_{0};
+  const uint32_t max_pending_requests_{0};
+  absl::optional<OpenTelemetrySinkStats> stats_;
+  Event::SchedulableCallbackPtr send_pending_cb_;
+  std::list<MetricsExportRequestPtr> pending_requests_;
 };
 
 } // namespace OpenTelemetry
@@ -0,0 +1,160 @@
+#include "source/extensions/tracers/opentelemetry/samplers/adaptive/adaptive_sampler.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "source/common/protobuf/utility.h"
+#include "source/common/tracing/common_values.h"
+#include "source/extensions/tracers/opentelemetry/span_context.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+
+namespace {
+
+constexpr std::chrono::seconds SAMPLING_WINDOW{1};
+constexpr uint64_t DEFAULT_MAX_BUFFERED_SPANS = 10000;
+
+absl::optional<std::chrono::nanoseconds> latencyThreshold(
+    const envoy::extensions::tracers::opentelemetry::samplers::v3::AdaptiveSamplerConfig& config) {
+  if (!config.tail_sampling().has_latency_threshold()) {
+    return absl::nullopt;
+  }
+  return std::chrono::milliseconds(
+      DurationUtil::durationToMilliseconds(config.tail_sampling().latency_threshold()));
+}
+
+bool hasErrorTag(const ::opentelemetry::proto::trace::v1::Span& span) {
+  for (const auto& attribute : span.attributes()) {
+    if (attribute.key() == Tracing::Tags::get().Error) {
+      return attribute.value().string_value() == Tracing::Tags::get().True;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+AdaptiveSampler::AdaptiveSampler(
+    const envoy::extensions::tracers::opentelemetry::samplers::v3::AdaptiveSamplerConfig& config,
+    Server::Configuration::TracerFactoryContext& context)
+    : spans_per_second_(config.spans_per_second()), tail_sampling_(config.has_tail_sampling()),
+      latency_threshold_(latencyThreshold(config)),
+      sample_errors_(config.tail_sampling().sample_errors()),
+      max_deferred_spans_(tail_sampling_
+                              ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.tail_sampling(),
+                                                                max_buffered_spans,
+                                                                DEFAULT_MAX_BUFFERED_SPANS)
+                              : 0),
+      time_source_(context.serverFactoryContext().timeSource()),
+      random_(context.serverFactoryContext().api().randomGenerator()),
+      stats_{ADAPTIVE_SAMPLER_STATS(POOL_COUNTER_PREFIX(
+          context.serverFactoryContext().scope(), "tracing.opentelemetry.adaptive_sampler"))},
+      tls_slot_(ThreadLocal::TypedSlot<ThreadLocalState>::makeUnique(
+          context.serverFactoryContext().threadLocal())) {
+  tls_slot_->set([&time_source = time_source_](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalState>(time_source.monotonicTime());
+  });
+}
+
+void AdaptiveSampler::maybeStartWindow(ThreadLocalState& state, MonotonicTime now) {
+  const auto elapsed = now - state.window_start_;
+  if (elapsed < SAMPLING_WINDOW) {
+    return;
+  }
+
+  // Derive the root span rate from the finished window. If the worker was idle for several
+  // windows, the rate is averaged over the whole idle period.
+  const double elapsed_seconds = std::chrono::duration<double>(elapsed).count();
+  const double root_spans_per_second = state.root_spans_ / elapsed_seconds;
+  // Each sampled root span is followed by the child spans which respect its decision.
+  const double spans_per_root_span =
+      state.sampled_root_spans_ > 0
+          ? std::max(1.0, static_cast<double>(state.sampled_spans_) / state.sampled_root_spans_)
+          : 1.0;
+  const double expected_spans_per_second = root_spans_per_second * spans_per_root_span;
+  state.probability_ =
+      expected_spans_per_second > spans_per_second_
+          ? static_cast<double>(spans_per_second_) / expected_spans_per_second
+          : 1.0;
+
+  state.window_start_ = now;
+  state.root_spans_ = 0;
+  state.sampled_root_spans_ = 0;
+  state.sampled_spans_ = 0;
+}
+
+SamplingResult AdaptiveSampler::notSampled() {
+  SamplingResult result;
+  if (tail_sampling_) {
+    stats_.deferred_.inc();
+    result.decision = Decision::RecordOnly;
+  } else {
+    stats_.not_sampled_.inc();
+    result.decision = Decision::Drop;
+  }
+  return result;
+}
+
+SamplingResult AdaptiveSampler::shouldSample(const absl::optional<SpanContext> parent_context,
+                                             const std::string& /*trace_id*/,
+                                             const std::string& /*name*/, OTelSpanKind /*kind*/,
+                                             OptRef<const Tracing::TraceContext> /*trace_context*/,
+                                             const std::vector<SpanContext>& /*links*/) {
+  ThreadLocalState& state = *tls_slot_;
+  maybeStartWindow(state, time_source_.monotonicTime());
+
+  SamplingResult result;
+  if (parent_context.has_value()) {
+    // Respect the decision of the parent span.
+    if (parent_context->sampled()) {
+      stats_.sampled_.inc();
+      ++state.sampled_spans_;
+      result.decision = Decision::RecordAndSample;
+    } else {
+      result = notSampled();
+    }
+    result.tracestate = parent_context->tracestate();
+    return result;
+  }
+
+  ++state.root_spans_;
+  if (state.sampled_spans_ >= spans_per_second_) {
+    stats_.budget_exhausted_.inc();
+    return notSampled();
+  }
+  if (state.probability_ < 1.0 &&
+      random_.random() >= state.probability_ * static_cast<double>(UINT64_MAX)) {
+    return notSampled();
+  }
+
+  stats_.sampled_.inc();
+  ++state.sampled_root_spans_;
+  ++state.sampled_spans_;
+  result.decision = Decision::RecordAndSample;
+  return result;
+}
+
+bool AdaptiveSampler::shouldSampleOnEnd(const ::opentelemetry::proto::trace::v1::Span& span) {
+  if (sample_errors_ &&
+      (span.status().code() == ::opentelemetry::proto::trace::v1::Status::STATUS_CODE_ERROR ||
+       hasErrorTag(span))) {
+    return true;
+  }
+  if (latency_threshold_.has_value() && span.end_time_unix_nano() >= span.start_time_unix_nano()) {
+    const std::chrono::nanoseconds duration(span.end_time_unix_nano() -
+                                            span.start_time_unix_nano());
+    return duration >= latency_threshold_.value();
+  }
+  return false;
+}
+
+std::string AdaptiveSampler::getDescription() const { return "AdaptiveSampler"; }
+
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
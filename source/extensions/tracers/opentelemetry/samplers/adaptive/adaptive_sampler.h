@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/common/random_generator.h"
+#include "envoy/common/time.h"
+#include "envoy/extensions/tracers/opentelemetry/samplers/v3/adaptive_sampler.pb.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+#include "source/extensions/tracers/opentelemetry/samplers/sampler.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+
+/**
+ * All adaptive sampler stats. @see stats_macros.h
+ */
+#define ADAPTIVE_SAMPLER_STATS(COUNTER)                                                            \
+  COUNTER(budget_exhausted)                                                                        \
+  COUNTER(deferred)                                                                                \
+  COUNTER(not_sampled)                                                                             \
+  COUNTER(sampled)
+
+/**
+ * Struct definition for all adaptive sampler stats. @see stats_macros.h
+ */
+struct AdaptiveSamplerStats {
+  ADAPTIVE_SAMPLER_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * @brief A sampler which keeps the number of sampled spans of each worker close to a budget.
+ *
+ * Every worker tracks how many root spans it sees and how many spans it samples. At the end of
+ * each one second window the sampling probability of root spans is recalculated from the observed
+ * rate so that the expected number of sampled spans matches the budget. Within a window, root
+ * spans are never sampled once the budget is used up. Spans with a parent follow the decision of
+ * the parent.
+ *
+ * If tail sampling is configured, spans which are not sampled are recorded instead and the sampling
+ * decision is made again when the local root span ends, based on its duration and status.
+ */
+class AdaptiveSampler : public Sampler, Logger::Loggable<Logger::Id::tracing> {
+public:
+  AdaptiveSampler(
+      const envoy::extensions::tracers::opentelemetry::samplers::v3::AdaptiveSamplerConfig& config,
+      Server::Configuration::TracerFactoryContext& context);
+
+  /** @see Sampler#shouldSample */
+  SamplingResult shouldSample(const absl::optional<SpanContext> parent_context,
+                              const std::string& trace_id, const std::string& name,
+                              OTelSpanKind spankind,
+                              OptRef<const Tracing::TraceContext> trace_context,
+                              const std::vector<SpanContext>& links) override;
+
+  std::string getDescription() const override;
+
+  uint64_t maxDeferredSpans() const override { return max_deferred_spans_; }
+
+  bool shouldSampleOnEnd(const ::opentelemetry::proto::trace::v1::Span& span) override;
+
+  /**
+   * @return the current sampling probability of root spans on this worker. Used for testing.
+   */
+  double rootSamplingProbability() const { return (*tls_slot_)->probability_; }
+
+private:
+  /**
+   * Sampling state of a single worker.
+   */
+  struct ThreadLocalState : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalState(MonotonicTime now) : window_start_(now) {}
+
+    MonotonicTime window_start_;
+    // Root spans offered to the sampler in the current window.
+    uint64_t root_spans_{0};
+    // Root spans sampled in the current window.
+    uint64_t sampled_root_spans_{0};
+    // All spans (root and child spans) sampled in the current window.
+    uint64_t sampled_spans_{0};
+    double probability_{1.0};
+  };
+
+  void maybeStartWindow(ThreadLocalState& state, MonotonicTime now);
+  SamplingResult notSampled();
+
+  const uint64_t spans_per_second_;
+  const bool tail_sampling_;
+  const absl::optional<std::chrono::nanoseconds> latency_threshold_;
+  const bool sample_errors_;
+  const uint64_t max_deferred_spans_;
+  TimeSource& time_source_;
+  Random::RandomGenerator& random_;
+  AdaptiveSamplerStats stats_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalState> tls_slot_;
+};
+
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
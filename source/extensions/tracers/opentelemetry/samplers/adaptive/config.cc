@@ -0,0 +1,37 @@
+#include "source/extensions/tracers/opentelemetry/samplers/adaptive/config.h"
+
+#include <memory>
+
+#include "envoy/extensions/tracers/opentelemetry/samplers/v3/adaptive_sampler.pb.validate.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/tracers/opentelemetry/samplers/adaptive/adaptive_sampler.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+
+SamplerSharedPtr
+AdaptiveSamplerFactory::createSampler(const Protobuf::Message& config,
+                                      Server::Configuration::TracerFactoryContext& context) {
+  auto mptr = Envoy::Config::Utility::translateAnyToFactoryConfig(
+      dynamic_cast<const ProtobufWkt::Any&>(config), context.messageValidationVisitor(), *this);
+
+  const auto& proto_config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::tracers::opentelemetry::samplers::v3::AdaptiveSamplerConfig&>(
+      *mptr, context.messageValidationVisitor());
+
+  return std::make_shared<AdaptiveSampler>(proto_config, context);
+}
+
+/**
+ * Static registration for the adaptive sampler factory. @see RegisterFactory.
+ */
+REGISTER_FACTORY(AdaptiveSamplerFactory, SamplerFactory);
+
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
@@ -82,6 +82,26 @@ public:
    * @return The sampler name or short description with the configuration.
    */
   virtual std::string getDescription() const PURE;
+
+  /**
+   * @brief Returns the maximum number of spans per worker which may be kept in memory while
+   * waiting for a deferred sampling decision. Samplers returning 0 (the default) do not defer
+   * decisions and spans for which they returned Decision::RecordOnly are never exported.
+   *
+   * @return The maximum number of buffered spans per worker.
+   */
+  virtual uint64_t maxDeferredSpans() const { return 0; }
+
+  /**
+   * @brief Makes the deferred sampling decision for a local root span which was recorded but not
+   * sampled when it started. Only called if maxDeferredSpans() returns a non-zero value.
+   *
+   * @param span The finished span, including its end time, status and attributes.
+   * @return true if the span and the recorded spans of the same local trace should be exported.
+   */
+  virtual bool shouldSampleOnEnd(const ::opentelemetry::proto::trace::v1::Span& /*span*/) {
+    return false;
+  }
 };
 
 using SamplerSharedPtr = std::shared_ptr<Sampler>;
@@ -42,6 +42,7 @@ void callSampler(SamplerSharedPtr sampler, const absl::optional<SpanContext> spa
   const auto sampling_result = sampler->shouldSample(
       span_context, new_span.getTraceId(), operation_name, new_span.spankind(), trace_context, {});
   new_span.setSampled(sampling_result.isSampled());
+  new_span.setRecordOnly(sampling_result.decision == Decision::RecordOnly);
 
   if (sampling_result.attributes) {
     for (auto const& attribute : *sampling_result.attributes) {
@@ -71,7 +72,8 @@ Tracing::SpanPtr Span::spawnChild(const Tracing::Config&, const std::string& nam
   // Build span_context from the current span, then generate the child span from that context.
   SpanContext span_context(kDefaultVersion, getTraceId(), spanId(), sampled(), tracestate());
   return parent_tracer_.startSpan(name, start_time, span_context, {},
-                                  ::opentelemetry::proto::trace::v1::Span::SPAN_KIND_CLIENT);
+                                  ::opentelemetry::proto::trace::v1::Span::SPAN_KIND_CLIENT,
+                                  deferred_spans_);
 }
 
 void Span::finishSpan() {
@@ -80,6 +82,8 @@ void Span::finishSpan() {
       std::chrono::nanoseconds(time_source_.systemTime().time_since_epoch()).count());
   if (sampled()) {
     parent_tracer_.sendSpan(span_);
+  } else if (record_only_ && deferred_spans_ != nullptr) {
+    parent_tracer_.sendDeferredSpan(span_, *deferred_spans_, local_root_);
   }
 }
 
@@ -182,7 +186,8 @@ Tracer::Tracer(OpenTelemetryTraceExporterPtr exporter, Envoy::TimeSource& time_s
                Event::Dispatcher& dispatcher, OpenTelemetryTracerStats tracing_stats,
                const ResourceConstSharedPtr resource, SamplerSharedPtr sampler)
     : exporter_(std::move(exporter)), time_source_(time_source), random_(random), runtime_(runtime),
-      tracing_stats_(tracing_stats), resource_(resource), sampler_(sampler) {
+      tracing_stats_(tracing_stats), resource_(resource), sampler_(sampler),
+      max_deferred_spans_(sampler_ ? sampler_->maxDeferredSpans() : 0) {
   flush_timer_ = dispatcher.createTimer([this]() -> void {
     tracing_stats_.timer_flushed_.inc();
     flushSpans();
@@ -244,6 +249,44 @@ void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span& span) {
   }
 }
 
+void Tracer::sendDeferredSpan(::opentelemetry::proto::trace::v1::Span& span,
+                              DeferredSpans& deferred, bool local_root) {
+  if (local_root) {
+    deferred.sampled_ = sampler_->shouldSampleOnEnd(span);
+    const uint64_t local_trace_spans = deferred.spans_.size() + 1;
+    if (deferred.sampled_.value()) {
+      tracing_stats_.deferred_spans_sent_.add(local_trace_spans);
+      for (auto& buffered_span : deferred.spans_) {
+        sendSpan(buffered_span);
+      }
+      sendSpan(span);
+    } else {
+      tracing_stats_.deferred_spans_dropped_.add(local_trace_spans);
+    }
+    deferred_spans_buffered_ -= deferred.spans_.size();
+    deferred.spans_.clear();
+    return;
+  }
+
+  if (deferred.sampled_.has_value()) {
+    // The local root span has already ended; follow its decision.
+    if (deferred.sampled_.value()) {
+      tracing_stats_.deferred_spans_sent_.inc();
+      sendSpan(span);
+    } else {
+      tracing_stats_.deferred_spans_dropped_.inc();
+    }
+    return;
+  }
+
+  if (deferred_spans_buffered_ >= max_deferred_spans_) {
+    tracing_stats_.deferred_spans_overflow_.inc();
+    return;
+  }
+  deferred.spans_.push_back(span);
+  ++deferred_spans_buffered_;
+}
+
 Tracing::SpanPtr Tracer::startSpan(const std::string& operation_name, SystemTime start_time,
                                    Tracing::Decision tracing_decision,
                                    OptRef<const Tracing::TraceContext> trace_context,
@@ -257,6 +300,9 @@ Tracing::SpanPtr Tracer::startSpan(const std::string& operation_name, SystemTime
   new_span.setId(Hex::uint64ToHex(span_id));
   if (sampler_) {
     callSampler(sampler_, absl::nullopt, new_span, operation_name, trace_context);
+    if (new_span.recordOnly() && max_deferred_spans_ > 0) {
+      new_span.setDeferredSpans(std::make_shared<DeferredSpans>(deferred_spans_buffered_), true);
+    }
   } else {
     new_span.setSampled(tracing_decision.traced);
   }
@@ -266,7 +312,8 @@ Tracing::SpanPtr Tracer::startSpan(const std::string& operation_name, SystemTime
 Tracing::SpanPtr Tracer::startSpan(const std::string& operation_name, SystemTime start_time,
                                    const SpanContext& previous_span_context,
                                    OptRef<const Tracing::TraceContext> trace_context,
-                                   OTelSpanKind span_kind) {
+                                   OTelSpanKind span_kind,
+                                   DeferredSpansSharedPtr parent_deferred_spans) {
   // Create a new span and populate details from the span context.
   Span new_span(operation_name, start_time, time_source_, *this, span_kind);
   new_span.setTraceId(previous_span_context.traceId());
@@ -279,6 +326,15 @@ Tracing::SpanPtr Tracer::startSpan(const std::string& operation_name, SystemTime
   if (sampler_) {
     // Sampler should make a sampling decision and set tracestate
     callSampler(sampler_, previous_span_context, new_span, operation_name, trace_context);
+    if (new_span.recordOnly() && max_deferred_spans_ > 0) {
+      // Spans started from a local parent share the buffer of the local root span. Otherwise this
+      // span is the local root and makes the deferred decision.
+      const bool local_root = parent_deferred_spans == nullptr;
+      new_span.setDeferredSpans(
+          local_root ? std::make_shared<DeferredSpans>(deferred_spans_buffered_)
+                     : std::move(parent_deferred_spans),
+          local_root);
+    }
   } else {
     // Respect the previous span's sampled flag.
     new_span.setSampled(previous_span_context.sampled());
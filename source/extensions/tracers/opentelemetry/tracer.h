@@ -24,6 +24,9 @@ namespace Tracers {
 namespace OpenTelemetry {
 
 #define OPENTELEMETRY_TRACER_STATS(COUNTER)                                                        \
+  COUNTER(deferred_spans_dropped)                                                                  \
+  COUNTER(deferred_spans_overflow)                                                                 \
+  COUNTER(deferred_spans_sent)                                                                     \
   COUNTER(spans_sent)                                                                              \
   COUNTER(timer_flushed)
 
@@ -31,6 +34,23 @@ struct OpenTelemetryTracerStats {
   OPENTELEMETRY_TRACER_STATS(GENERATE_COUNTER_STRUCT)
 };
 
+/**
+ * Spans of a local trace which were recorded but not sampled when they started. They are kept in
+ * memory until the local root span ends and the sampler makes the deferred sampling decision.
+ */
+struct DeferredSpans {
+  explicit DeferredSpans(uint64_t& buffered_spans) : buffered_spans_(buffered_spans) {}
+  ~DeferredSpans() { buffered_spans_ -= spans_.size(); }
+
+  // Number of spans buffered by all the local traces of the owning tracer.
+  uint64_t& buffered_spans_;
+  std::vector<::opentelemetry::proto::trace::v1::Span> spans_;
+  // Set when the local root span ends.
+  absl::optional<bool> sampled_;
+};
+
+using DeferredSpansSharedPtr = std::shared_ptr<DeferredSpans>;
+
 /**
  * OpenTelemetry Tracer. It is stored in TLS and contains the exporter.
  */
@@ -43,6 +63,13 @@ public:
 
   void sendSpan(::opentelemetry::proto::trace::v1::Span& span);
 
+  /**
+   * Handles a finished span which was recorded but not sampled. Spans are buffered until the local
+   * root span of the trace ends, which makes the deferred sampling decision for all of them.
+   */
+  void sendDeferredSpan(::opentelemetry::proto::trace::v1::Span& span, DeferredSpans& deferred,
+                        bool local_root);
+
   Tracing::SpanPtr startSpan(const std::string& operation_name, SystemTime start_time,
 
                              Tracing::Decision tracing_decision,
@@ -52,7 +79,13 @@ public:
   Tracing::SpanPtr startSpan(const std::string& operation_name, SystemTime start_time,
                              const SpanContext& previous_span_context,
                              OptRef<const Tracing::TraceContext> trace_context,
-                             OTelSpanKind span_kind);
+                             OTelSpanKind span_kind,
+                             DeferredSpansSharedPtr parent_deferred_spans = nullptr);
+
+  /**
+   * @return the number of spans currently waiting for a deferred sampling decision.
+   */
+  uint64_t deferredSpansBuffered() const { return deferred_spans_buffered_; }
 
 private:
   /**
@@ -73,6 +106,8 @@ private:
   OpenTelemetryTracerStats tracing_stats_;
   const ResourceConstSharedPtr resource_;
   SamplerSharedPtr sampler_;
+  const uint64_t max_deferred_spans_;
+  uint64_t deferred_spans_buffered_{0};
 };
 
 /**
@@ -97,7 +132,10 @@ public:
   /**
    * Set the span's sampled flag.
    */
-  void setSampled(bool sampled) override { sampled_ = sampled; };
+  void setSampled(bool sampled) override {
+    sampled_ = sampled;
+    record_only_ = false;
+  };
 
   /**
    * @return whether or not the sampled attribute is set
@@ -105,6 +143,25 @@ public:
 
   bool sampled() const { return sampled_; }
 
+  /**
+   * Marks the span as recorded but not sampled (Decision::RecordOnly).
+   */
+  void setRecordOnly(bool record_only) { record_only_ = record_only; }
+
+  /**
+   * @return whether the span is recorded but not sampled.
+   */
+  bool recordOnly() const { return record_only_; }
+
+  /**
+   * Sets the buffer holding the spans of the local trace while the sampling decision is deferred.
+   * @param local_root whether this span makes the deferred decision when it ends.
+   */
+  void setDeferredSpans(DeferredSpansSharedPtr deferred_spans, bool local_root) {
+    deferred_spans_ = std::move(deferred_spans);
+    local_root_ = local_root;
+  }
+
   std::string getBaggage(absl::string_view /*key*/) override { return EMPTY_STRING; };
   void setBaggage(absl::string_view /*key*/, absl::string_view /*value*/) override{};
 
@@ -167,7 +224,10 @@ private:
   ::opentelemetry::proto::trace::v1::Span span_;
   Tracer& parent_tracer_;
   Envoy::TimeSource& time_source_;
+  DeferredSpansSharedPtr deferred_spans_;
   bool sampled_;
+  bool record_only_{false};
+  bool local_root_{false};
 };
 
 using TracerPtr = std::unique_ptr<Tracer>;
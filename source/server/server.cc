@@ -22,6 +22,7 @@
 #include "envoy/server/options.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stream_info/filter_state.h"
 #include "envoy/upstream/cluster_manager.h"
 
 #include "source/common/api/api_impl.h"
@@ -493,6 +494,9 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
               absl::StrJoin(info.registered_headers_, ","));
   }
 
+  // Finalize the well-known filter state data names before any worker creates a filter state.
+  StreamInfo::FilterState::finalizeInlineKeys();
+
   // Initialize the regex engine and inject to singleton.
   // Needs to happen before stats store initialization because the stats
   // matcher config can include regexes.
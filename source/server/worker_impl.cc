@@ -9,6 +9,7 @@
 #include "envoy/server/configuration.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/common/recycling_allocator.h"
 #include "source/common/config/utility.h"
 #include "source/server/listener_manager_factory.h"
 
@@ -59,6 +60,9 @@ WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
   overload_manager.registerForAction(
       OverloadActionNames::get().ResetStreams, *dispatcher_,
       [this](OverloadActionState state) { resetStreamsUsingExcessiveMemory(state); });
+  overload_manager.registerForAction(
+      OverloadActionNames::get().ShrinkHeap, *dispatcher_,
+      [](OverloadActionState state) { shrinkHeapCb(state); });
 }
 
 void WorkerImpl::addListener(absl::optional<uint64_t> overridden_listener,
@@ -180,6 +184,12 @@ void WorkerImpl::rejectIncomingConnectionsCb(OverloadActionState state) {
   handler_->setListenerRejectFraction(state.value());
 }
 
+void WorkerImpl::shrinkHeapCb(OverloadActionState state) {
+  // The memory kept for the next streams of the worker is returned to the heap, which the main
+  // thread shrinks, while the action is saturated.
+  RecyclingAllocator::setThreadEnabled(!state.isSaturated());
+}
+
 void WorkerImpl::resetStreamsUsingExcessiveMemory(OverloadActionState state) {
   uint64_t streams_reset_count =
       dispatcher_->getWatermarkFactory().resetAccountsGivenPressure(state.value().value());
@@ -73,6 +73,7 @@ private:
   void threadRoutine(OptRef<GuardDog> guard_dog, const std::function<void()>& cb);
   void stopAcceptingConnectionsCb(OverloadActionState state);
   void rejectIncomingConnectionsCb(OverloadActionState state);
+  static void shrinkHeapCb(OverloadActionState state);
   void resetStreamsUsingExcessiveMemory(OverloadActionState state);
 
   ThreadLocal::Instance& tls_;
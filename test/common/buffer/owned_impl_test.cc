@@ -864,6 +864,34 @@ TEST_F(OwnedImplTest, ReserveCommitReuse) {
   expectSlices({{8001, 4287, 12288}}, buffer);
 }
 
+TEST_F(OwnedImplTest, ReserveForReadWithMaxLength) {
+  Buffer::OwnedImpl buffer;
+  uint64_t default_reservation_length;
+  uint64_t default_slice_length;
+  {
+    auto reservation = buffer.reserveForRead();
+    default_reservation_length = reservation.length();
+    default_slice_length = reservation.slices()[0].len_;
+  }
+
+  // A reservation smaller than a slice still gets a full slice.
+  {
+    auto reservation = buffer.reserveForReadWithMaxLength(100);
+    EXPECT_EQ(1, reservation.numSlices());
+    EXPECT_EQ(default_slice_length, reservation.length());
+  }
+  {
+    auto reservation = buffer.reserveForReadWithMaxLength(default_slice_length * 2);
+    EXPECT_EQ(2, reservation.numSlices());
+    EXPECT_EQ(default_slice_length * 2, reservation.length());
+  }
+  // The reservation is never larger than the default one.
+  {
+    auto reservation = buffer.reserveForReadWithMaxLength(UINT64_MAX);
+    EXPECT_EQ(default_reservation_length, reservation.length());
+  }
+}
+
 // Test behavior when the size to commit() is larger than the reservation.
 TEST_F(OwnedImplTest, ReserveOverCommit) {
   Buffer::OwnedImpl buffer;
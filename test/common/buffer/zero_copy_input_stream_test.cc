@@ -31,6 +31,19 @@ TEST_F(ZeroCopyInputStreamTest, Move) {
   EXPECT_EQ(0, buffer.length());
 }
 
+TEST_F(ZeroCopyInputStreamTest, MoveLength) {
+  Buffer::OwnedImpl buffer{"efgh"};
+  stream_.move(buffer, 3);
+
+  EXPECT_EQ("h", buffer.toString());
+  stream_.finish();
+  std::string read;
+  while (stream_.Next(&data_, &size_)) {
+    read.append(static_cast<const char*>(data_), size_);
+  }
+  EXPECT_EQ("abcdefg", read);
+}
+
 TEST_F(ZeroCopyInputStreamTest, Next) {
   EXPECT_TRUE(stream_.Next(&data_, &size_));
   EXPECT_EQ(4, size_);
@@ -0,0 +1,164 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <array>
+#include <random>
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/base64.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace {
+
+// The byte at a time implementation which preceded the block implementation, kept as a baseline.
+namespace Reference {
+
+constexpr char CHAR_TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+const std::array<unsigned char, 256>& reverseLookupTable() {
+  static const std::array<unsigned char, 256> table = [] {
+    std::array<unsigned char, 256> table;
+    table.fill(64);
+    for (unsigned char i = 0; i < 64; ++i) {
+      table[static_cast<uint8_t>(CHAR_TABLE[i])] = i;
+    }
+    return table;
+  }();
+  return table;
+}
+
+std::string encode(const char* input, uint64_t length) {
+  std::string ret;
+  ret.reserve((length + 2) / 3 * 4);
+  uint8_t next_c = 0;
+  for (uint64_t i = 0; i < length; ++i) {
+    const uint8_t cur_char = input[i];
+    switch (i % 3) {
+    case 0:
+      ret.push_back(CHAR_TABLE[cur_char >> 2]);
+      next_c = (cur_char & 0x03) << 4;
+      break;
+    case 1:
+      ret.push_back(CHAR_TABLE[next_c | (cur_char >> 4)]);
+      next_c = (cur_char & 0x0f) << 2;
+      break;
+    case 2:
+      ret.push_back(CHAR_TABLE[next_c | (cur_char >> 6)]);
+      ret.push_back(CHAR_TABLE[cur_char & 0x3f]);
+      next_c = 0;
+      break;
+    }
+  }
+  if (length % 3 != 0) {
+    ret.push_back(CHAR_TABLE[next_c]);
+    ret.append(3 - length % 3, '=');
+  }
+  return ret;
+}
+
+// Only supports unpadded input whose length is a multiple of 4, as used below.
+std::string decode(absl::string_view input) {
+  const std::array<unsigned char, 256>& reverse_lookup_table = reverseLookupTable();
+  std::string ret;
+  ret.reserve(input.size() / 4 * 3);
+  for (uint64_t i = 0; i < input.size(); ++i) {
+    const unsigned char c = reverse_lookup_table[static_cast<uint8_t>(input[i])];
+    if (c == 64) {
+      return "";
+    }
+    switch (i % 4) {
+    case 0:
+      ret.push_back(c << 2);
+      break;
+    case 1:
+      ret.back() |= c >> 4;
+      ret.push_back(c << 4);
+      break;
+    case 2:
+      ret.back() |= c >> 2;
+      ret.push_back(c << 6);
+      break;
+    case 3:
+      ret.back() |= c;
+      break;
+    }
+  }
+  return ret;
+}
+
+} // namespace Reference
+
+std::string randomBytes(uint64_t size) {
+  std::mt19937 prng(1); // PRNG with a fixed seed, for repeatability.
+  std::string bytes(size, '\0');
+  for (char& c : bytes) {
+    c = prng();
+  }
+  return bytes;
+}
+
+// The payloads are multiples of 3 bytes, so that their encoding is not padded.
+constexpr int64_t MinPayload = 48;
+constexpr int64_t MaxPayload = 3 << 20;
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_EncodeReference(benchmark::State& state) {
+  const std::string input = randomBytes(state.range(0));
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Reference::encode(input.data(), input.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_EncodeReference)->RangeMultiplier(16)->Range(MinPayload, MaxPayload);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_Encode(benchmark::State& state) {
+  const std::string input = randomBytes(state.range(0));
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Base64::encode(input.data(), input.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Encode)->RangeMultiplier(16)->Range(MinPayload, MaxPayload);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_EncodeBuffer(benchmark::State& state) {
+  // Slices of an odd size, so that blocks straddle the slices.
+  const std::string input = randomBytes(state.range(0));
+  Buffer::OwnedImpl buffer;
+  for (uint64_t i = 0; i < input.size(); i += 1001) {
+    buffer.appendSliceForTest(absl::string_view(input).substr(i, 1001));
+  }
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Base64::encode(buffer, buffer.length()));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_EncodeBuffer)->RangeMultiplier(16)->Range(MinPayload, MaxPayload);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_DecodeReference(benchmark::State& state) {
+  const std::string input = Base64::encode(randomBytes(state.range(0)).data(), state.range(0));
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Reference::decode(input));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_DecodeReference)->RangeMultiplier(16)->Range(MinPayload, MaxPayload);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_Decode(benchmark::State& state) {
+  const std::string input = Base64::encode(randomBytes(state.range(0)).data(), state.range(0));
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Base64::decode(input));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_Decode)->RangeMultiplier(16)->Range(MinPayload, MaxPayload);
+
+} // namespace Envoy
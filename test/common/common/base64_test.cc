@@ -132,6 +132,36 @@ TEST(Base64Test, BinaryBufferEncode) {
   EXPECT_EQ("AAECAwgKCQCqvN4=", Base64::encode(buffer, 30));
 }
 
+TEST(Base64Test, StraddlingSlicesBufferEncode) {
+  Buffer::OwnedImpl buffer;
+  buffer.appendSliceForTest("f");
+  buffer.appendSliceForTest("oob");
+  buffer.appendSliceForTest("a");
+  buffer.appendSliceForTest("r");
+  EXPECT_EQ("Zg==", Base64::encode(buffer, 1));
+  EXPECT_EQ("Zm9v", Base64::encode(buffer, 3));
+  EXPECT_EQ("Zm9vYmE=", Base64::encode(buffer, 5));
+  EXPECT_EQ("Zm9vYmFy", Base64::encode(buffer, 6));
+}
+
+TEST(Base64Test, LongInput) {
+  std::string input;
+  for (int i = 0; i < 1000; ++i) {
+    input.push_back(static_cast<char>(i * 7));
+  }
+  const std::string encoded = Base64::encode(input.data(), input.size());
+  EXPECT_EQ(1336U, encoded.size());
+  EXPECT_EQ(input, Base64::decode(encoded));
+
+  // An invalid character anywhere fails the whole input.
+  for (size_t i : {0, 1, 2, 3, 500, 1000, 1331}) {
+    std::string corrupted = encoded;
+    corrupted[i] = '.';
+    EXPECT_EQ("", Base64::decode(corrupted));
+    EXPECT_EQ("", Base64::decodeWithoutPadding(corrupted));
+  }
+}
+
 TEST(Base64Test, CompletePadding) {
   struct CompletePaddingBase64UrlTestCases {
     std::string base64, base64_with_padding;
@@ -173,6 +203,79 @@ TEST(Base64Test, CompletePadding) {
   }
 }
 
+TEST(Base64StreamEncoderTest, Encode) {
+  Base64StreamEncoder encoder;
+  Buffer::OwnedImpl output;
+  Buffer::OwnedImpl input("fo");
+  encoder.encode(input, 2, output);
+  EXPECT_EQ(0U, input.length());
+  EXPECT_EQ("", output.toString());
+
+  input.appendSliceForTest("ob");
+  input.appendSliceForTest("ar");
+  encoder.encode(input, 3, output);
+  EXPECT_EQ("r", input.toString());
+  EXPECT_EQ("Zm9v", output.toString());
+
+  encoder.encode(input, 1, output);
+  EXPECT_EQ("Zm9vYmFy", output.toString());
+  encoder.finish(output);
+  EXPECT_EQ("Zm9vYmFy", output.toString());
+
+  // The encoder can be reused after finish().
+  input.add("f");
+  encoder.encode(input, 1, output);
+  encoder.finish(output);
+  EXPECT_EQ("Zm9vYmFyZg==", output.toString());
+}
+
+TEST(Base64StreamDecoderTest, Decode) {
+  Base64StreamDecoder decoder;
+  Buffer::OwnedImpl output;
+  Buffer::OwnedImpl input("Zm9");
+  EXPECT_TRUE(decoder.decode(input, output));
+  EXPECT_EQ(0U, input.length());
+  EXPECT_EQ(3U, decoder.pendingSize());
+  EXPECT_EQ("", output.toString());
+
+  input.appendSliceForTest("vY");
+  input.appendSliceForTest("mE=Zg");
+  EXPECT_TRUE(decoder.decode(input, output));
+  EXPECT_EQ(2U, decoder.pendingSize());
+  EXPECT_EQ("fooba", output.toString());
+
+  // Padding may terminate any block.
+  input.add("==");
+  EXPECT_TRUE(decoder.decode(input, output));
+  EXPECT_EQ(0U, decoder.pendingSize());
+  EXPECT_EQ("foobaf", output.toString());
+}
+
+TEST(Base64StreamDecoderTest, DecodeFailure) {
+  {
+    Base64StreamDecoder decoder;
+    Buffer::OwnedImpl output;
+    Buffer::OwnedImpl input("Zm9vY");
+    EXPECT_TRUE(decoder.decode(input, output));
+    input.add("h==");
+    EXPECT_FALSE(decoder.decode(input, output));
+  }
+
+  {
+    Base64StreamDecoder decoder;
+    Buffer::OwnedImpl output;
+    Buffer::OwnedImpl input("Zm9vYmFy.m9v");
+    EXPECT_FALSE(decoder.decode(input, output));
+  }
+
+  {
+    Base64StreamDecoder decoder;
+    Buffer::OwnedImpl output;
+    Buffer::OwnedImpl input("Zg==A===");
+    EXPECT_FALSE(decoder.decode(input, output));
+  }
+}
+
 TEST(Base64UrlTest, EncodeString) {
   EXPECT_EQ("", Base64Url::encode("", 0));
   EXPECT_EQ("AAA", Base64Url::encode("\0\0", 2));
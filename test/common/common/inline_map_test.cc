@@ -287,7 +287,7 @@ TEST(InlineMapWith20InlineKey, InlineMapWith20InlineKeyTestWithUniquePtrAsValue)
   map.reset();
 }
 
-TEST(InlineMapWith20InlineKey, MapCreationWillFinalizeTheDescriptor) {
+TEST(InlineMapWith20InlineKey, MapCreationRequiresFinalizedDescriptor) {
   InlineMapDescriptor<std::string> descriptor;
 
   std::vector<InlineMapDescriptor<std::string>::Handle> handles;
@@ -302,9 +302,9 @@ TEST(InlineMapWith20InlineKey, MapCreationWillFinalizeTheDescriptor) {
     EXPECT_EQ(handles[i], descriptor.addInlineKey("key_" + std::to_string(i)));
   }
 
-  auto map = InlineMap<std::string, std::unique_ptr<std::string>>::create(descriptor);
-
-  EXPECT_TRUE(descriptor.finalized());
+  EXPECT_DEBUG_DEATH(InlineMap<std::string, std::unique_ptr<std::string>>::create(descriptor),
+                     "Cannot create inline map before finalize()");
+  EXPECT_FALSE(descriptor.finalized());
 }
 
 TEST(InlineMapWith3InlineKey, TestInlineKeysAsString) {
@@ -118,6 +118,30 @@ TEST(JsonEscapeTest, Escape) {
   expect_json_escape("\x1f", "\\u001f");
 }
 
+// The special characters are escaped wherever they are in a string scanned by blocks.
+TEST(JsonEscapeTest, EscapeInLongString) {
+  const std::string unescaped(80, 'a');
+  EXPECT_EQ(0U, JsonEscaper::extraSpace(unescaped));
+  EXPECT_EQ(unescaped.size(), JsonEscaper::escapeFreePrefixLength(unescaped, false));
+  for (size_t i = 0; i < unescaped.size(); ++i) {
+    for (const char c : {'"', '\n', '\x01', '\x1f'}) {
+      std::string str = unescaped;
+      str[i] = c;
+      EXPECT_LE(JsonEscaper::escapeFreePrefixLength(str, false), i);
+      const std::string escaped = JsonEscaper::escapeString(str, JsonEscaper::extraSpace(str));
+      EXPECT_EQ(unescaped.substr(0, i), escaped.substr(0, i));
+      EXPECT_EQ(unescaped.substr(i + 1), escaped.substr(escaped.size() - (str.size() - i - 1)));
+    }
+    // Characters which are not ASCII are only special for the sanitizer.
+    std::string str = unescaped;
+    str[i] = '\x80';
+    EXPECT_EQ(str.size(), JsonEscaper::escapeFreePrefixLength(str, false));
+    EXPECT_LE(JsonEscaper::escapeFreePrefixLength(str, true), i);
+    str[i] = '\x7f';
+    EXPECT_LE(JsonEscaper::escapeFreePrefixLength(str, true), i);
+  }
+}
+
 class LoggerCustomFlagsTest : public testing::TestWithParam<spdlog::logger*> {
 public:
   LoggerCustomFlagsTest() : logger_(GetParam()) {}
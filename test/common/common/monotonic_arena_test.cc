@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "source/common/common/monotonic_arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(MonotonicArenaTest, AllocatesAlignedMemoryFromGrowingBlocks) {
+  MonotonicArena arena(64);
+  EXPECT_EQ(0, arena.blocks());
+
+  char* first = static_cast<char*>(arena.allocate(1, 1));
+  uint64_t* second = static_cast<uint64_t*>(arena.allocate(sizeof(uint64_t), alignof(uint64_t)));
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(second) % alignof(uint64_t));
+  EXPECT_NE(static_cast<void*>(first), static_cast<void*>(second));
+  *first = 'a';
+  *second = 42;
+  EXPECT_EQ(1, arena.blocks());
+
+  // Allocations which do not fit in the current block are served by a new, larger, block.
+  arena.allocate(64, 16);
+  EXPECT_EQ(2, arena.blocks());
+  arena.allocate(32, 16);
+  EXPECT_EQ(2, arena.blocks());
+
+  // Allocations larger than the next block get a block of their own.
+  void* large = arena.allocate(MonotonicArena::MaxBlockSize * 2, 16);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(large) % 16);
+  EXPECT_EQ(3, arena.blocks());
+  EXPECT_EQ(5, arena.allocations());
+
+  EXPECT_NE(arena.allocate(0, 1), arena.allocate(0, 1));
+}
+
+TEST(MonotonicArenaTest, Allocator) {
+  MonotonicArena arena;
+  std::list<std::string, ArenaAllocator<std::string>> list{ArenaAllocator<std::string>(arena)};
+  for (int i = 0; i < 10; ++i) {
+    list.push_back(std::to_string(i));
+  }
+  EXPECT_EQ(10, list.size());
+  EXPECT_EQ("9", list.back());
+  EXPECT_EQ(10, arena.allocations());
+  EXPECT_EQ(1, arena.blocks());
+}
+
+class Counted : public ArenaAllocated {
+public:
+  Counted(int& live) : live_(live) { ++live_; }
+  ~Counted() { --live_; }
+
+private:
+  int& live_;
+};
+
+TEST(MonotonicArenaTest, ArenaAllocated) {
+  MonotonicArena arena;
+  int live = 0;
+  {
+    std::unique_ptr<Counted> counted{new (arena) Counted(live)};
+    EXPECT_EQ(1, live);
+    EXPECT_EQ(1, arena.allocations());
+  }
+  EXPECT_EQ(0, live);
+}
+
+TEST(MonotonicArenaTest, MakeSharedInArena) {
+  MonotonicArena arena;
+  std::shared_ptr<std::string> in_arena = makeSharedInArena<std::string>(arena, "arena");
+  EXPECT_EQ("arena", *in_arena);
+  EXPECT_EQ(1, arena.allocations());
+
+  std::shared_ptr<std::string> on_heap = makeSharedInArena<std::string>({}, "heap");
+  EXPECT_EQ("heap", *on_heap);
+  EXPECT_EQ(1, arena.allocations());
+}
+
+} // namespace
+} // namespace Envoy
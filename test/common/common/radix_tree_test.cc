@@ -0,0 +1,146 @@
+#include "source/common/common/radix_tree.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+
+TEST(RadixTree, AddItems) {
+  RadixTree<const char*> tree;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+  const char* cstr_c = "c";
+
+  EXPECT_TRUE(tree.add("foo", cstr_a));
+  EXPECT_TRUE(tree.add("bar", cstr_b));
+  EXPECT_EQ(cstr_a, tree.find("foo"));
+  EXPECT_EQ(cstr_b, tree.find("bar"));
+
+  // overwrite_existing = false
+  EXPECT_FALSE(tree.add("foo", cstr_c, false));
+  EXPECT_EQ(cstr_a, tree.find("foo"));
+
+  // overwrite_existing = true
+  EXPECT_TRUE(tree.add("foo", cstr_c));
+  EXPECT_EQ(cstr_c, tree.find("foo"));
+}
+
+TEST(RadixTree, EmptyKey) {
+  RadixTree<const char*> tree;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+
+  EXPECT_EQ(nullptr, tree.find(""));
+  EXPECT_EQ(nullptr, tree.findLongestPrefix("foo"));
+  EXPECT_TRUE(tree.add("", cstr_a));
+  EXPECT_TRUE(tree.add("foo", cstr_b));
+  EXPECT_EQ(cstr_a, tree.find(""));
+  EXPECT_EQ(nullptr, tree.find("fo"));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix(""));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("fo"));
+  EXPECT_EQ(cstr_b, tree.findLongestPrefix("foo"));
+}
+
+TEST(RadixTree, LongestPrefix) {
+  RadixTree<const char*> tree;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+  const char* cstr_c = "c";
+  const char* cstr_d = "d";
+  const char* cstr_e = "e";
+  const char* cstr_f = "f";
+
+  EXPECT_TRUE(tree.add("foo", cstr_a));
+  EXPECT_TRUE(tree.add("bar", cstr_b));
+  EXPECT_TRUE(tree.add("baro", cstr_c));
+  EXPECT_TRUE(tree.add("foo/bar", cstr_d));
+  // Verify that prepending and appending branches to a node both work.
+  EXPECT_TRUE(tree.add("barn", cstr_e));
+  EXPECT_TRUE(tree.add("barp", cstr_f));
+
+  EXPECT_EQ(cstr_a, tree.find("foo"));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("foo"));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("foosball"));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("foo/"));
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("foo/ba"));
+  EXPECT_EQ(cstr_d, tree.findLongestPrefix("foo/bar"));
+  EXPECT_EQ(cstr_d, tree.findLongestPrefix("foo/bar/zzz"));
+
+  EXPECT_EQ(cstr_b, tree.find("bar"));
+  EXPECT_EQ(cstr_b, tree.findLongestPrefix("bar"));
+  EXPECT_EQ(cstr_b, tree.findLongestPrefix("baritone"));
+  EXPECT_EQ(cstr_c, tree.findLongestPrefix("barometer"));
+
+  EXPECT_EQ(cstr_e, tree.find("barn"));
+  EXPECT_EQ(cstr_e, tree.findLongestPrefix("barnacle"));
+
+  EXPECT_EQ(cstr_f, tree.find("barp"));
+  EXPECT_EQ(cstr_f, tree.findLongestPrefix("barpomus"));
+
+  EXPECT_EQ(nullptr, tree.find("toto"));
+  EXPECT_EQ(nullptr, tree.findLongestPrefix("toto"));
+  EXPECT_EQ(nullptr, tree.find(" "));
+  EXPECT_EQ(nullptr, tree.findLongestPrefix(" "));
+  EXPECT_EQ(nullptr, tree.find("fo"));
+  EXPECT_EQ(nullptr, tree.findLongestPrefix("fo"));
+  EXPECT_EQ(nullptr, tree.find("foo/ba"));
+}
+
+// Keys are only split into several nodes where they diverge or end.
+TEST(RadixTree, SplitLabels) {
+  RadixTree<const char*> tree;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+  const char* cstr_c = "c";
+  const char* cstr_d = "d";
+
+  EXPECT_TRUE(tree.add("/api/v1/users", cstr_a));
+  EXPECT_EQ(2U, tree.nodeCount());
+
+  // Diverges within the label of "/api/v1/users": split at "/api/v1/".
+  EXPECT_TRUE(tree.add("/api/v1/groups", cstr_b));
+  EXPECT_EQ(4U, tree.nodeCount());
+
+  // Ends within the label of "/api/v1/": split at "/api/".
+  EXPECT_TRUE(tree.add("/api/", cstr_c));
+  EXPECT_EQ(5U, tree.nodeCount());
+
+  // Ends on an existing node.
+  EXPECT_TRUE(tree.add("/api/v1/", cstr_d));
+  EXPECT_EQ(5U, tree.nodeCount());
+
+  EXPECT_EQ(cstr_a, tree.find("/api/v1/users"));
+  EXPECT_EQ(cstr_b, tree.find("/api/v1/groups"));
+  EXPECT_EQ(cstr_c, tree.find("/api/"));
+  EXPECT_EQ(cstr_d, tree.find("/api/v1/"));
+  EXPECT_EQ(nullptr, tree.find("/api/v1"));
+  EXPECT_EQ(nullptr, tree.find("/api/v1/user"));
+  EXPECT_EQ(nullptr, tree.find("/api/v1/usersx"));
+
+  EXPECT_EQ(cstr_a, tree.findLongestPrefix("/api/v1/users/1"));
+  EXPECT_EQ(cstr_d, tree.findLongestPrefix("/api/v1/user"));
+  EXPECT_EQ(cstr_c, tree.findLongestPrefix("/api/v2/users"));
+  EXPECT_EQ(nullptr, tree.findLongestPrefix("/ap"));
+}
+
+TEST(RadixTree, NonAsciiKeys) {
+  RadixTree<const char*> tree;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+
+  EXPECT_TRUE(tree.add("\xff\x80", cstr_a));
+  EXPECT_TRUE(tree.add("\xff\x01", cstr_b));
+  EXPECT_EQ(cstr_a, tree.find("\xff\x80"));
+  EXPECT_EQ(cstr_b, tree.findLongestPrefix("\xff\x01\x02"));
+  EXPECT_EQ(nullptr, tree.find("\xff"));
+}
+
+TEST(RadixTree, VeryDeepTreeDoesNotStackOverflowOnDestructor) {
+  RadixTree<const char*> tree;
+  const char* cstr_a = "a";
+
+  std::string key_a(20960, 'a');
+  EXPECT_TRUE(tree.add(key_a, cstr_a));
+  EXPECT_EQ(cstr_a, tree.find(key_a));
+}
+
+} // namespace Envoy
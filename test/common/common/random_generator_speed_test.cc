@@ -0,0 +1,86 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "source/common/common/random_generator.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Random {
+namespace {
+
+// The number of random numbers drawn at once, e.g. by a load balancer picking among N hosts.
+constexpr int64_t MinBatch = 1;
+constexpr int64_t MaxBatch = 64;
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_Random(benchmark::State& state) {
+  RandomGeneratorImpl random;
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(random.random());
+  }
+}
+BENCHMARK(BM_Random);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FastRandom(benchmark::State& state) {
+  RandomGeneratorImpl random;
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(random.fastRandom());
+  }
+}
+BENCHMARK(BM_FastRandom);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RandomBatch(benchmark::State& state) {
+  RandomGeneratorImpl random;
+  std::array<uint64_t, MaxBatch> values;
+  for (auto _ : state) { // NOLINT
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      values[i] = random.random();
+    }
+    benchmark::DoNotOptimize(values);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RandomBatch)->RangeMultiplier(8)->Range(MinBatch, MaxBatch);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FastRandomFill(benchmark::State& state) {
+  RandomGeneratorImpl random;
+  std::array<uint64_t, MaxBatch> values;
+  for (auto _ : state) { // NOLINT
+    random.fastRandomFill(absl::MakeSpan(values.data(), state.range(0)));
+    benchmark::DoNotOptimize(values);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FastRandomFill)->RangeMultiplier(8)->Range(MinBatch, MaxBatch);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_Uuid(benchmark::State& state) {
+  RandomGeneratorImpl random;
+  for (auto _ : state) { // NOLINT
+    std::string uuid = random.uuid();
+    benchmark::DoNotOptimize(uuid);
+  }
+}
+BENCHMARK(BM_Uuid);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_WriteUuid(benchmark::State& state) {
+  RandomGeneratorImpl random;
+  RandomGenerator::UuidBuffer buffer;
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(random.writeUuid(buffer));
+  }
+}
+BENCHMARK(BM_WriteUuid);
+
+} // namespace
+} // namespace Random
+} // namespace Envoy
@@ -3,6 +3,7 @@
 #include "source/common/common/interval_value.h"
 #include "source/common/common/random_generator.h"
 
+#include "absl/strings/ascii.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -56,6 +57,27 @@ TEST(UUID, CheckLengthOfUUID) {
   EXPECT_EQ(expected_length, result.length());
 }
 
+TEST(UUID, WriteUuid) {
+  Random::RandomGeneratorImpl random;
+
+  for (size_t i = 0; i < 1000; ++i) {
+    RandomGenerator::UuidBuffer buffer;
+    const absl::string_view uuid = random.writeUuid(buffer);
+    ASSERT_EQ(36, uuid.size());
+    EXPECT_EQ(buffer.data(), uuid.data());
+    for (size_t j = 0; j < uuid.size(); ++j) {
+      if (j == 8 || j == 13 || j == 18 || j == 23) {
+        EXPECT_EQ('-', uuid[j]);
+      } else {
+        EXPECT_TRUE(absl::ascii_isxdigit(uuid[j]) && !absl::ascii_isupper(uuid[j])) << uuid;
+      }
+    }
+    // Version 4, variant 1.
+    EXPECT_EQ('4', uuid[14]);
+    EXPECT_TRUE(uuid[19] == '8' || uuid[19] == '9' || uuid[19] == 'a' || uuid[19] == 'b');
+  }
+}
+
 TEST(UUID, SanityCheckOfUniqueness) {
   std::set<std::string> uuids;
   const size_t num_of_uuids = 100000;
@@ -68,6 +90,52 @@ TEST(UUID, SanityCheckOfUniqueness) {
   EXPECT_EQ(num_of_uuids, uuids.size());
 }
 
+TEST(Random, SanityCheckOfUniquenessFastRandom) {
+  Random::RandomGeneratorImpl random;
+  std::set<uint64_t> results;
+  const size_t num_of_results = 1000000;
+
+  for (size_t i = 0; i < num_of_results; ++i) {
+    results.insert(random.fastRandom());
+  }
+
+  EXPECT_EQ(num_of_results, results.size());
+}
+
+TEST(Random, FastRandomFill) {
+  Random::RandomGeneratorImpl random;
+  std::vector<uint64_t> values(1000);
+
+  random.fastRandomFill(absl::MakeSpan(values));
+  EXPECT_EQ(values.size(), std::set<uint64_t>(values.begin(), values.end()).size());
+
+  // The numbers are spread over the whole range.
+  int high_bit_count = 0;
+  for (const uint64_t value : values) {
+    high_bit_count += value >> 63;
+  }
+  EXPECT_NEAR(static_cast<double>(high_bit_count) / values.size(), 0.5, 0.1);
+}
+
+TEST(Random, FastRandomDefaultsToRandom) {
+  class CountingRandomGenerator : public RandomGenerator {
+  public:
+    uint64_t random() override { return ++count_; }
+    std::string uuid() override { return "a121e9e1-feae-4136-9e0e-6fac343d56c9"; }
+
+    uint64_t count_{};
+  };
+
+  CountingRandomGenerator random;
+  EXPECT_EQ(1, random.fastRandom());
+  std::vector<uint64_t> values(3);
+  random.fastRandomFill(absl::MakeSpan(values));
+  EXPECT_EQ(std::vector<uint64_t>({2, 3, 4}), values);
+
+  RandomGenerator::UuidBuffer buffer;
+  EXPECT_EQ("a121e9e1-feae-4136-9e0e-6fac343d56c9", random.writeUuid(buffer));
+}
+
 TEST(Random, Bernoilli) {
   Random::RandomGeneratorImpl random;
 
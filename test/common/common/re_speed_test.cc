@@ -4,7 +4,9 @@
 #include <regex>
 
 #include "source/common/common/assert.h"
+#include "source/common/common/regex.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
 #include "re2/re2.h"
@@ -126,3 +128,71 @@ static void BM_RE2_AltPattern(benchmark::State& state) {
   RELEASE_ASSERT(passes > 0, "");
 }
 BENCHMARK(BM_RE2_AltPattern);
+
+// Route-like patterns for the set matching benchmarks. Only the last one matches the input.
+static std::vector<std::string> routePatterns(int64_t count) {
+  std::vector<std::string> patterns;
+  for (int64_t i = 0; i < count; ++i) {
+    patterns.push_back(absl::StrCat("/api/v", i, "/users/[0-9]+/items(/[a-z]+)?"));
+  }
+  return patterns;
+}
+
+static std::string routeInput(int64_t count) {
+  return absl::StrCat("/api/v", count - 1, "/users/12345/items/details");
+}
+
+// Matches the patterns one by one, as when each route has its own regex.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_FirstMatchIndividually(benchmark::State& state) {
+  std::vector<std::unique_ptr<re2::RE2>> regexes;
+  for (const std::string& pattern : routePatterns(state.range(0))) {
+    regexes.push_back(std::make_unique<re2::RE2>(pattern));
+  }
+  const std::string input = routeInput(state.range(0));
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    for (const auto& regex : regexes) {
+      if (re2::RE2::FullMatch(input, *regex)) {
+        ++passes;
+        break;
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_FirstMatchIndividually)->RangeMultiplier(4)->Range(4, 1024);
+
+// Matches the patterns together with the set matcher of the RE2 regex engine.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_FirstMatchSet(benchmark::State& state) {
+  Envoy::Regex::GoogleReEngine engine;
+  auto matcher = engine.setMatcher(routePatterns(state.range(0)));
+  RELEASE_ASSERT(matcher.ok(), "");
+  const std::string input = routeInput(state.range(0));
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    if ((*matcher)->firstMatch(input).has_value()) {
+      ++passes;
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_FirstMatchSet)->RangeMultiplier(4)->Range(4, 1024);
+
+// Checks whether any pattern matches, as stats matchers do, for an input matching none.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_MatchAnySetNoMatch(benchmark::State& state) {
+  Envoy::Regex::GoogleReEngine engine;
+  auto matcher = engine.setMatcher(routePatterns(state.range(0)));
+  RELEASE_ASSERT(matcher.ok(), "");
+  const std::string input = "/api/v1/groups/12345/items";
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    if (!(*matcher)->matchAny(input)) {
+      ++passes;
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_MatchAnySetNoMatch)->RangeMultiplier(4)->Range(4, 1024);
@@ -0,0 +1,127 @@
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "source/common/common/recycling_allocator.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(RecyclingAllocatorTest, RecyclesFreedMemoryOfTheSameSize) {
+  if (!RecyclingAllocator::enabled()) {
+    GTEST_SKIP() << "recycling is disabled";
+  }
+  const uint64_t heap_allocations = RecyclingAllocator::heapAllocations();
+  const uint64_t recycled_allocations = RecyclingAllocator::recycledAllocations();
+
+  void* first = RecyclingAllocator::allocate(1000);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(first) % alignof(std::max_align_t));
+  RecyclingAllocator::free(first);
+  EXPECT_EQ(first, RecyclingAllocator::allocate(1000));
+
+  // Memory of another size is not reused.
+  void* other = RecyclingAllocator::allocate(1001);
+  EXPECT_NE(first, other);
+  RecyclingAllocator::free(other);
+  RecyclingAllocator::free(first);
+
+  EXPECT_EQ(heap_allocations + 2, RecyclingAllocator::heapAllocations());
+  EXPECT_EQ(recycled_allocations + 1, RecyclingAllocator::recycledAllocations());
+  RecyclingAllocator::free(nullptr);
+}
+
+TEST(RecyclingAllocatorTest, BoundsTheFreeLists) {
+  if (!RecyclingAllocator::enabled()) {
+    GTEST_SKIP() << "recycling is disabled";
+  }
+  const size_t size = 2000;
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < RecyclingAllocator::MaxFreeBlocks + 8; ++i) {
+    blocks.push_back(RecyclingAllocator::allocate(size));
+  }
+  for (void* block : blocks) {
+    RecyclingAllocator::free(block);
+  }
+
+  // Only MaxFreeBlocks blocks were kept, the others went back to the heap.
+  const uint64_t heap_allocations = RecyclingAllocator::heapAllocations();
+  blocks.clear();
+  for (size_t i = 0; i < RecyclingAllocator::MaxFreeBlocks + 8; ++i) {
+    blocks.push_back(RecyclingAllocator::allocate(size));
+  }
+  EXPECT_EQ(heap_allocations + 8, RecyclingAllocator::heapAllocations());
+  for (void* block : blocks) {
+    RecyclingAllocator::free(block);
+  }
+
+  // Large blocks are never kept.
+  void* large = RecyclingAllocator::allocate(RecyclingAllocator::MaxBlockSize);
+  RecyclingAllocator::free(large);
+  const uint64_t large_heap_allocations = RecyclingAllocator::heapAllocations();
+  RecyclingAllocator::free(RecyclingAllocator::allocate(RecyclingAllocator::MaxBlockSize));
+  EXPECT_EQ(large_heap_allocations + 1, RecyclingAllocator::heapAllocations());
+}
+
+TEST(RecyclingAllocatorTest, SetThreadEnabled) {
+  if (!RecyclingAllocator::enabled()) {
+    GTEST_SKIP() << "recycling is disabled";
+  }
+  std::thread thread([]() {
+    void* first = RecyclingAllocator::allocate(3000);
+    void* second = RecyclingAllocator::allocate(3000);
+    RecyclingAllocator::free(first);
+
+    // Disabling releases the kept memory and stops keeping freed memory.
+    RecyclingAllocator::setThreadEnabled(false);
+    RecyclingAllocator::free(second);
+    const uint64_t heap_allocations = RecyclingAllocator::heapAllocations();
+    RecyclingAllocator::free(RecyclingAllocator::allocate(3000));
+    RecyclingAllocator::free(RecyclingAllocator::allocate(3000));
+    EXPECT_EQ(heap_allocations + 2, RecyclingAllocator::heapAllocations());
+
+    RecyclingAllocator::setThreadEnabled(true);
+    void* third = RecyclingAllocator::allocate(3000);
+    RecyclingAllocator::free(third);
+    EXPECT_EQ(third, RecyclingAllocator::allocate(3000));
+    RecyclingAllocator::free(third);
+  });
+  thread.join();
+}
+
+TEST(RecyclingAllocatorTest, FreesOnAnotherThread) {
+  void* memory = RecyclingAllocator::allocate(100);
+  std::thread thread([memory]() {
+    RecyclingAllocator::free(memory);
+    // The memory is recycled by the freeing thread.
+    void* recycled = RecyclingAllocator::allocate(100);
+    if (RecyclingAllocator::enabled()) {
+      EXPECT_EQ(memory, recycled);
+    }
+    RecyclingAllocator::free(recycled);
+  });
+  thread.join();
+}
+
+struct RecyclableObject : public Recyclable {
+  explicit RecyclableObject(uint64_t value) : value_(value) {}
+  uint64_t value_;
+};
+
+TEST(RecyclingAllocatorTest, Recyclable) {
+  auto object = std::make_unique<RecyclableObject>(42);
+  RecyclableObject* address = object.get();
+  object.reset();
+
+  // The memory is reused, but the object is constructed again.
+  object = std::make_unique<RecyclableObject>(43);
+  if (RecyclingAllocator::enabled()) {
+    EXPECT_EQ(address, object.get());
+  }
+  EXPECT_EQ(43, object->value_);
+}
+
+} // namespace
+} // namespace Envoy
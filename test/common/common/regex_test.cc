@@ -138,6 +138,31 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+TEST(GoogleReEngine, SetMatcher) {
+  GoogleReEngine engine;
+  auto matcher = engine.setMatcher({"/asdf/.*", "/qwer/.*", "/asdf/a.*"});
+  ASSERT_TRUE(matcher.ok());
+  // The expressions are fully matched, and the lowest matching index is reported.
+  EXPECT_EQ(0, (*matcher)->firstMatch("/asdf/abc"));
+  EXPECT_EQ(1, (*matcher)->firstMatch("/qwer/abc"));
+  EXPECT_EQ(absl::nullopt, (*matcher)->firstMatch("/zxcv/asdf/abc"));
+  EXPECT_TRUE((*matcher)->matchAny("/asdf/"));
+  EXPECT_FALSE((*matcher)->matchAny("/asdf"));
+
+  matcher = engine.setMatcher({"/qwer/.*", "/asdf/a.*", "/asdf/.*"});
+  ASSERT_TRUE(matcher.ok());
+  EXPECT_EQ(1, (*matcher)->firstMatch("/asdf/abc"));
+  EXPECT_EQ(2, (*matcher)->firstMatch("/asdf/bcd"));
+
+  matcher = engine.setMatcher({});
+  ASSERT_TRUE(matcher.ok());
+  EXPECT_EQ(absl::nullopt, (*matcher)->firstMatch("/asdf/abc"));
+  EXPECT_FALSE((*matcher)->matchAny("/asdf/abc"));
+
+  EXPECT_EQ(engine.setMatcher({"/asdf/.*", "(+invalid)"}).status().message(),
+            "no argument for repetition operator: +");
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
@@ -1,13 +1,17 @@
 // Note: this should be run with --compilation_mode=opt, and would benefit from a
 // quiescent system with disabled cstate power management.
 
+#include <algorithm>
 #include <random>
 
 #include "envoy/http/header_map.h"
 
+#include "source/common/common/radix_tree.h"
 #include "source/common/common/trie_lookup_table.h"
 #include "source/common/http/headers.h"
+#include "source/common/memory/stats.h"
 
+#include "absl/strings/str_cat.h"
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -69,6 +73,9 @@ template <class TableType> static void typedBmTrieLookups(benchmark::State& stat
 static void bmTrieLookups(benchmark::State& s) {
   typedBmTrieLookups<TrieLookupTable<const void*>>(s);
 }
+static void bmRadixTreeLookups(benchmark::State& s) {
+  typedBmTrieLookups<RadixTree<const void*>>(s);
+}
 
 #define ADD_HEADER_TO_KEYS(name) keys.emplace_back(Http::Headers::get().name);
 static void bmTrieLookupsRequestHeaders(benchmark::State& s) {
@@ -81,9 +88,98 @@ static void bmTrieLookupsResponseHeaders(benchmark::State& s) {
   INLINE_RESP_HEADERS(ADD_HEADER_TO_KEYS);
   typedBmTrieLookups<TrieLookupTable<const void*>>(s, keys);
 }
+static void bmRadixTreeLookupsRequestHeaders(benchmark::State& s) {
+  std::vector<std::string> keys;
+  INLINE_REQ_HEADERS(ADD_HEADER_TO_KEYS);
+  typedBmTrieLookups<RadixTree<const void*>>(s, keys);
+}
+static void bmRadixTreeLookupsResponseHeaders(benchmark::State& s) {
+  std::vector<std::string> keys;
+  INLINE_RESP_HEADERS(ADD_HEADER_TO_KEYS);
+  typedBmTrieLookups<RadixTree<const void*>>(s, keys);
+}
+
+// Generates `num_keys` URL path prefixes like "/api/v2/service17/resource3/", which share long
+// prefixes as the route prefixes of a large configuration typically do.
+static std::vector<std::string> makePathPrefixes(int num_keys) {
+  std::mt19937 prng(1); // PRNG with a fixed seed, for repeatability
+  std::uniform_int_distribution<int> version_distribution(1, 3);
+  std::uniform_int_distribution<int> service_distribution(0, std::max(1, num_keys / 10));
+  std::vector<std::string> keys;
+  for (int i = 0; i < num_keys; i++) {
+    keys.push_back(absl::StrCat("/api/v", version_distribution(prng), "/service",
+                                service_distribution(prng), "/resource", i, "/"));
+  }
+  return keys;
+}
+
+// Range args are:
+// 0 - num_keys
+// Reports the memory allocated for the table per key, when built with tcmalloc.
+template <class TableType> static void typedBmTrieMemory(benchmark::State& state) {
+  const std::vector<std::string> keys = makePathPrefixes(state.range(0));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    const uint64_t allocated_before = Memory::Stats::totalCurrentlyAllocated();
+    TableType trie;
+    for (const std::string& key : keys) {
+      trie.add(key, &key);
+    }
+    state.counters["bytes_per_key"] =
+        static_cast<double>(Memory::Stats::totalCurrentlyAllocated() - allocated_before) /
+        keys.size();
+    benchmark::DoNotOptimize(trie);
+  }
+}
+
+// Range args are:
+// 0 - num_keys
+// Looks up the longest matching prefix of paths which extend the keys.
+template <class TableType> static void typedBmTrieLongestPrefix(benchmark::State& state) {
+  const std::vector<std::string> keys = makePathPrefixes(state.range(0));
+  TableType trie;
+  for (const std::string& key : keys) {
+    trie.add(key, &key);
+  }
+  std::mt19937 prng(1); // PRNG with a fixed seed, for repeatability
+  std::uniform_int_distribution<size_t> keyindex_distribution(0, keys.size() - 1);
+  std::vector<std::string> paths;
+  for (size_t i = 0; i < 1024; i++) {
+    paths.push_back(absl::StrCat(keys[keyindex_distribution(prng)], "items/12345?page=2"));
+  }
+
+  size_t path_index = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    auto v = trie.findLongestPrefix(paths[path_index++]);
+    // Reset path_index to 0 whenever it reaches 1024.
+    path_index &= 1023;
+    benchmark::DoNotOptimize(v);
+  }
+}
+
+static void bmTrieMemory(benchmark::State& s) {
+  typedBmTrieMemory<TrieLookupTable<const std::string*>>(s);
+}
+static void bmRadixTreeMemory(benchmark::State& s) {
+  typedBmTrieMemory<RadixTree<const std::string*>>(s);
+}
+static void bmTrieLongestPrefix(benchmark::State& s) {
+  typedBmTrieLongestPrefix<TrieLookupTable<const std::string*>>(s);
+}
+static void bmRadixTreeLongestPrefix(benchmark::State& s) {
+  typedBmTrieLongestPrefix<RadixTree<const std::string*>>(s);
+}
 
 BENCHMARK(bmTrieLookupsRequestHeaders);
 BENCHMARK(bmTrieLookupsResponseHeaders);
 BENCHMARK(bmTrieLookups)->ArgsProduct({{10, 100, 1000, 10000}, {0, 8, 128}});
+BENCHMARK(bmRadixTreeLookupsRequestHeaders);
+BENCHMARK(bmRadixTreeLookupsResponseHeaders);
+BENCHMARK(bmRadixTreeLookups)->ArgsProduct({{10, 100, 1000, 10000}, {0, 8, 128}});
+BENCHMARK(bmTrieMemory)->Arg(100)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK(bmRadixTreeMemory)->Arg(100)->Arg(10000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK(bmTrieLongestPrefix)->Arg(100)->Arg(10000)->Arg(50000);
+BENCHMARK(bmRadixTreeLongestPrefix)->Arg(100)->Arg(10000)->Arg(50000);
 
 } // namespace Envoy
@@ -324,5 +324,72 @@ TEST(UnionStringTest, All) {
   }
 }
 
+TEST(UnionStringTest, Interned) {
+  const InternedStringSharedPtr interned = std::make_shared<const std::string>("hello");
+
+  // Set interned, shared rather than copied.
+  {
+    UnionString string;
+    string.setInterned(interned);
+    EXPECT_TRUE(string.isInterned());
+    EXPECT_FALSE(string.isReference());
+    EXPECT_EQ(string.getStringView().data(), interned->data());
+    EXPECT_EQ(5U, string.size());
+    EXPECT_EQ(2, interned.use_count());
+  }
+  EXPECT_EQ(1, interned.use_count());
+
+  // Move constructor
+  {
+    UnionString string1;
+    string1.setInterned(interned);
+    UnionString string2(std::move(string1));
+    EXPECT_TRUE(string2.isInterned());
+    EXPECT_EQ("hello", string2.getStringView());
+    EXPECT_FALSE(string1.isInterned()); // NOLINT
+    EXPECT_TRUE(string1.empty());       // NOLINT
+    EXPECT_EQ(2, interned.use_count());
+  }
+
+  // Clear
+  {
+    UnionString string;
+    string.setInterned(interned);
+    string.clear();
+    EXPECT_FALSE(string.isInterned());
+    EXPECT_TRUE(string.empty());
+    EXPECT_EQ(1, interned.use_count());
+  }
+
+  // Append switches to inline, leaving the interned string untouched.
+  {
+    UnionString string;
+    string.setInterned(interned);
+    string.append(" world", 6);
+    EXPECT_FALSE(string.isInterned());
+    EXPECT_EQ("hello world", string.getStringView());
+    EXPECT_EQ("hello", *interned);
+    EXPECT_EQ(1, interned.use_count());
+  }
+
+  // Set copy, including of the interned string itself.
+  {
+    UnionString string;
+    string.setInterned(std::make_shared<const std::string>(129, 'a'));
+    string.setCopy(string.getStringView());
+    EXPECT_FALSE(string.isInterned());
+    EXPECT_EQ(std::string(129, 'a'), string.getStringView());
+  }
+
+  // Set integer
+  {
+    UnionString string;
+    string.setInterned(interned);
+    string.setInteger(123);
+    EXPECT_FALSE(string.isInterned());
+    EXPECT_EQ("123", string.getStringView());
+  }
+}
+
 } // namespace
 } // namespace Envoy
@@ -0,0 +1,79 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <memory>
+#include <string>
+
+#include "source/common/http/filter_chain_helper.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+// The number of filters of a typical filter chain.
+constexpr int FilterCount = 10;
+
+// Options which look up the decisions of a filter in the configurations of a route, its virtual
+// host and its route configuration, like those of a stream with a route.
+class RouteFilterChainOptions : public FilterChainOptions {
+public:
+  RouteFilterChainOptions() {
+    route_configs_["filter_3"] = true;
+    virtual_host_configs_["filter_5"] = true;
+  }
+
+  absl::optional<bool> filterDisabled(absl::string_view config_name) const override {
+    for (const auto* configs : {&route_configs_, &virtual_host_configs_, &route_config_configs_}) {
+      auto it = configs->find(config_name);
+      if (it != configs->end()) {
+        return it->second;
+      }
+    }
+    return absl::nullopt;
+  }
+  uint64_t filterDisabledCacheId() const override { return 1; }
+
+private:
+  absl::flat_hash_map<std::string, bool> route_configs_;
+  absl::flat_hash_map<std::string, bool> virtual_host_configs_;
+  absl::flat_hash_map<std::string, bool> route_config_configs_;
+};
+
+class CountingFilterChainManager : public FilterChainManager {
+public:
+  void applyFilterFactoryCb(FilterContext, FilterFactoryCb&) override { ++filters_; }
+
+  uint64_t filters_{};
+};
+
+/**
+ * Measure the creation of the filter chain of a stream from the filter factories, without creating
+ * the filters. With an argument of 1 the filter chains prebuilt for the route are used.
+ */
+static void filterChainCreate(benchmark::State& state) {
+  const bool prebuilt = state.range(0) == 1;
+  FilterChainUtility::FilterFactoriesList filter_factories;
+  for (int i = 0; i < FilterCount; ++i) {
+    filter_factories.push_back(
+        {std::make_unique<Filter::StaticFilterConfigProviderImpl<Filter::HttpFilterFactoryCb>>(
+             [](FilterChainFactoryCallbacks&) {}, "filter_" + std::to_string(i)),
+         false});
+  }
+  FilterChainUtility::PrebuiltFilterChains prebuilt_chains;
+  RouteFilterChainOptions options;
+  CountingFilterChainManager manager;
+
+  for (auto _ : state) { // NOLINT
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories,
+                                                      prebuilt ? &prebuilt_chains : nullptr);
+  }
+  benchmark::DoNotOptimize(manager.filters_);
+}
+BENCHMARK(filterChainCreate)->Arg(0)->Arg(1);
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -7,6 +7,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
 
@@ -19,6 +20,7 @@ public:
   MockFilterChainOptions() = default;
 
   MOCK_METHOD(absl::optional<bool>, filterDisabled, (absl::string_view), (const));
+  MOCK_METHOD(uint64_t, filterDisabledCacheId, (), (const));
 };
 
 TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithRouteDisabled) {
@@ -84,6 +86,67 @@ TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithRouteDisabledAndDe
   }
 }
 
+TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithPrebuiltChains) {
+  NiceMock<MockFilterChainManager> manager;
+  NiceMock<MockFilterChainOptions> options;
+  FilterChainUtility::FilterFactoriesList filter_factories;
+  FilterChainUtility::PrebuiltFilterChains prebuilt_chains;
+
+  for (const auto& name : {"filter_0", "filter_1", "filter_2"}) {
+    auto provider =
+        std::make_unique<Filter::StaticFilterConfigProviderImpl<Filter::HttpFilterFactoryCb>>(
+            [](FilterChainFactoryCallbacks&) {}, name);
+    filter_factories.push_back({std::move(provider), false});
+  }
+
+  ON_CALL(options, filterDisabledCacheId()).WillByDefault(Return(1));
+  ON_CALL(options, filterDisabled("filter_1")).WillByDefault(Return(absl::make_optional(true)));
+
+  {
+    // The chain of the route is built once, and then reused.
+    EXPECT_CALL(options, filterDisabled(_)).Times(3);
+    std::vector<std::string> names;
+    EXPECT_CALL(manager, applyFilterFactoryCb(_, _))
+        .Times(6)
+        .WillRepeatedly(Invoke([&](FilterContext context, FilterFactoryCb&) {
+          names.push_back(context.config_name);
+        }));
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories,
+                                                      &prebuilt_chains);
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories,
+                                                      &prebuilt_chains);
+    EXPECT_EQ(std::vector<std::string>({"filter_0", "filter_2", "filter_0", "filter_2"}), names);
+  }
+
+  {
+    // Other prebuilt chains, and the chains of other routes, are built separately.
+    FilterChainUtility::PrebuiltFilterChains other_prebuilt_chains;
+    EXPECT_CALL(options, filterDisabled(_)).Times(3);
+    EXPECT_CALL(manager, applyFilterFactoryCb(_, _)).Times(2);
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories,
+                                                      &other_prebuilt_chains);
+
+    EXPECT_CALL(options, filterDisabledCacheId()).WillOnce(Return(2));
+    EXPECT_CALL(options, filterDisabled(_)).Times(3);
+    EXPECT_CALL(manager, applyFilterFactoryCb(_, _)).Times(2);
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories,
+                                                      &prebuilt_chains);
+  }
+
+  {
+    // Without prebuilt chains, or without a cache id of the decisions, the route is always asked.
+    EXPECT_CALL(options, filterDisabled(_)).Times(3);
+    EXPECT_CALL(manager, applyFilterFactoryCb(_, _)).Times(2);
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories);
+
+    EXPECT_CALL(options, filterDisabledCacheId()).WillOnce(Return(0));
+    EXPECT_CALL(options, filterDisabled(_)).Times(3);
+    EXPECT_CALL(manager, applyFilterFactoryCb(_, _)).Times(2);
+    FilterChainUtility::createFilterChainForFactories(manager, options, filter_factories,
+                                                      &prebuilt_chains);
+  }
+}
+
 } // namespace
 } // namespace Http
 } // namespace Envoy
@@ -1,4 +1,6 @@
+#include "source/common/common/recycling_allocator.h"
 #include "source/common/http/header_map_impl.h"
+#include "source/common/http/header_value_interner.h"
 #include "source/common/http/headers.h"
 
 #include "test/test_common/utility.h"
@@ -30,6 +32,29 @@ static void headerMapImplCreate(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplCreate);
 
+/**
+ * Measure the header maps of the streams of a multiplexed connection, which are created and
+ * destroyed in turn. The heap allocations of the header maps themselves are reported per stream:
+ * their memory is recycled once the first stream is done.
+ */
+static void headerMapImplStreamHeaders(benchmark::State& state) {
+  const uint64_t heap_allocations = RecyclingAllocator::heapAllocations();
+  uint64_t streams = 0;
+  for (auto _ : state) { // NOLINT
+    auto request_headers = Http::RequestHeaderMapImpl::create();
+    request_headers->setReferenceMethod(Headers::get().MethodValues.Post);
+    auto response_headers = Http::ResponseHeaderMapImpl::create();
+    response_headers->setStatus(200);
+    auto response_trailers = Http::ResponseTrailerMapImpl::create();
+    benchmark::DoNotOptimize(request_headers->size() + response_headers->size() +
+                             response_trailers->size());
+    ++streams;
+  }
+  state.counters["heap_allocations_per_stream"] =
+      static_cast<double>(RecyclingAllocator::heapAllocations() - heap_allocations) / streams;
+}
+BENCHMARK(headerMapImplStreamHeaders);
+
 /**
  * Measure the speed of setting/overwriting a header value. The numeric Arg passed
  * by the BENCHMARK(...) macro call below indicates how many dummy headers this test
@@ -210,6 +235,49 @@ static void headerMapImplPopulate(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplPopulate);
 
+/**
+ * Measure the speed of populating a HeaderMapImpl with the values of received response headers,
+ * as done by the codecs, with a set of long values repeated in every response. The numeric Arg
+ * passed by the BENCHMARK(...) macro call below indicates whether the values are interned by the
+ * HeaderValueInterner rather than copied.
+ */
+static void headerMapImplPopulateReceived(benchmark::State& state) {
+  const std::pair<LowerCaseString, std::string> headers_to_add[] = {
+      {LowerCaseString("cache-control"), "max-age=0, private, must-revalidate"},
+      {LowerCaseString("content-type"), "text/html; charset=utf-8"},
+      {LowerCaseString("server"), "envoy"},
+      {LowerCaseString("content-security-policy"),
+       "default-src 'self'; script-src 'self' https://cdn.example.com "
+       "https://analytics.example.com; style-src 'self' https://cdn.example.com; img-src 'self' "
+       "data: https:; frame-ancestors 'none'"},
+      {LowerCaseString("strict-transport-security"),
+       "max-age=63072000; includeSubDomains; preload; report-uri="
+       "https://reports.example.com/strict-transport-security/v1/report?source=envoy"},
+      {LowerCaseString("vary"),
+       "Accept-Encoding, Accept-Language, Origin, Access-Control-Request-Method, "
+       "Access-Control-Request-Headers, Sec-Fetch-Dest, Sec-Fetch-Mode"},
+  };
+  const bool intern = state.range(0);
+  HeaderValueInterner interner;
+  for (auto _ : state) { // NOLINT
+    auto headers = Http::ResponseHeaderMapImpl::create();
+    for (const auto& key_value : headers_to_add) {
+      HeaderString key;
+      key.setCopy(key_value.first.get());
+      HeaderString value;
+      InternedStringSharedPtr interned_value = intern ? interner.intern(key_value.second) : nullptr;
+      if (interned_value != nullptr) {
+        value.setInterned(std::move(interned_value));
+      } else {
+        value.setCopy(key_value.second);
+      }
+      headers->addViaMove(std::move(key), std::move(value));
+    }
+    benchmark::DoNotOptimize(headers->size());
+  }
+}
+BENCHMARK(headerMapImplPopulateReceived)->Arg(0)->Arg(1);
+
 /**
  * Measure the speed of encoding headers as part of upgraded requests (HTTP/1 to HTTP/2)
  * @note The measured time for each iteration includes the time needed to add
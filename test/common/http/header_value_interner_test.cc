@@ -0,0 +1,64 @@
+#include <string>
+
+#include "source/common/http/header_value_interner.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+class HeaderValueInternerTest : public testing::Test {
+protected:
+  HeaderValueInterner interner_;
+};
+
+TEST_F(HeaderValueInternerTest, InternsRepeatedValues) {
+  const std::string value(200, 'a');
+  EXPECT_EQ(nullptr, interner_.intern(value));
+
+  InternedStringSharedPtr interned = interner_.intern(value);
+  ASSERT_NE(nullptr, interned);
+  EXPECT_EQ(value, *interned);
+  EXPECT_EQ(interned, interner_.intern(value));
+  EXPECT_EQ(interned, interner_.intern(std::string(value)));
+
+  // The interned value outlives the interner's reference.
+  interner_.clear();
+  EXPECT_EQ(1, interned.use_count());
+  EXPECT_EQ(value, *interned);
+  EXPECT_EQ(nullptr, interner_.intern(value));
+}
+
+TEST_F(HeaderValueInternerTest, OnlyInternsValuesWhichWouldAllocate) {
+  for (const size_t size :
+       {size_t(0), InlinedStringCapacity, HeaderValueInterner::MaxValueSize + 1}) {
+    const std::string value(size, 'a');
+    interner_.intern(value);
+    EXPECT_EQ(nullptr, interner_.intern(value)) << size;
+  }
+  const std::string value(HeaderValueInterner::MaxValueSize, 'a');
+  interner_.intern(value);
+  EXPECT_NE(nullptr, interner_.intern(value));
+}
+
+TEST_F(HeaderValueInternerTest, ValuesSeenOnceDoNotEvict) {
+  const std::string value(200, 'a');
+  interner_.intern(value);
+  InternedStringSharedPtr interned = interner_.intern(value);
+  ASSERT_NE(nullptr, interned);
+
+  // Unique values, some of which share the slot of the interned value.
+  for (size_t i = 0; i < 4 * HeaderValueInterner::Slots; ++i) {
+    EXPECT_EQ(nullptr, interner_.intern(std::string(200, 'b') + std::to_string(i)));
+  }
+  EXPECT_EQ(interned, interner_.intern(value));
+}
+
+TEST_F(HeaderValueInternerTest, ThreadLocal) {
+  EXPECT_EQ(&HeaderValueInterner::get(), &HeaderValueInterner::get());
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
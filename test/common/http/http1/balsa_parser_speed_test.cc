@@ -0,0 +1,64 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/http/http1/balsa_parser.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+class NullParserCallbacks : public ParserCallbacks {
+public:
+  CallbackResult onMessageBegin() override { return CallbackResult::Success; }
+  CallbackResult onUrl(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onStatus(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeaderField(const char* data, size_t length) override {
+    benchmark::DoNotOptimize(data + length);
+    return CallbackResult::Success;
+  }
+  CallbackResult onHeaderValue(const char* data, size_t length) override {
+    benchmark::DoNotOptimize(data + length);
+    return CallbackResult::Success;
+  }
+  CallbackResult onHeadersComplete() override { return CallbackResult::Success; }
+  void bufferBody(const char*, size_t) override {}
+  CallbackResult onMessageComplete() override { return CallbackResult::Success; }
+  void onChunkHeader(bool) override {}
+};
+
+std::string requestWithHeaders(int num_headers) {
+  std::string request = "GET /some/path/to/a/resource?with=query&parameters=1 HTTP/1.1\r\n"
+                        "host: www.example.com\r\n";
+  for (int i = 0; i < num_headers; ++i) {
+    absl::StrAppend(&request, "x-custom-header-", i, ": some-typical-header-value-", i, "\r\n");
+  }
+  absl::StrAppend(&request, "\r\n");
+  return request;
+}
+
+// Range args are:
+// 0 - the number of headers of the request, besides the host.
+// Parses a request on a keep-alive connection.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_BalsaParserRequest(benchmark::State& state) {
+  const std::string request = requestWithHeaders(state.range(0));
+  NullParserCallbacks callbacks;
+  BalsaParser parser(MessageType::Request, &callbacks, 64 * 1024, /*enable_trailers=*/false,
+                     /*allow_custom_methods=*/false);
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(parser.execute(request.data(), request.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+BENCHMARK(BM_BalsaParserRequest)->Arg(10)->Arg(30)->Arg(100);
+
+} // namespace
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
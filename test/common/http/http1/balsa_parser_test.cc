@@ -0,0 +1,140 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "source/common/http/http1/balsa_parser.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+// Records the URL and the headers of the parsed message.
+class RecordingParserCallbacks : public ParserCallbacks {
+public:
+  CallbackResult onMessageBegin() override { return CallbackResult::Success; }
+  CallbackResult onUrl(const char* data, size_t length) override {
+    url_.assign(data, length);
+    return CallbackResult::Success;
+  }
+  CallbackResult onStatus(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeaderField(const char* data, size_t length) override {
+    headers_.emplace_back(std::string(data, length), "");
+    return CallbackResult::Success;
+  }
+  CallbackResult onHeaderValue(const char* data, size_t length) override {
+    headers_.back().second.assign(data, length);
+    return CallbackResult::Success;
+  }
+  CallbackResult onHeadersComplete() override { return CallbackResult::Success; }
+  void bufferBody(const char*, size_t) override {}
+  CallbackResult onMessageComplete() override {
+    message_complete_ = true;
+    return CallbackResult::Success;
+  }
+  void onChunkHeader(bool) override {}
+
+  std::string url_;
+  std::vector<std::pair<std::string, std::string>> headers_;
+  bool message_complete_{};
+};
+
+class BalsaParserTest : public testing::Test {
+protected:
+  ParserStatus parse(absl::string_view request) {
+    BalsaParser parser(MessageType::Request, &callbacks_, 64 * 1024, /*enable_trailers=*/false,
+                       /*allow_custom_methods=*/false);
+    parser.execute(request.data(), request.size());
+    return parser.getStatus();
+  }
+
+  RecordingParserCallbacks callbacks_;
+};
+
+TEST_F(BalsaParserTest, Request) {
+  EXPECT_EQ(ParserStatus::Ok, parse("GET /path?query HTTP/1.1\r\n"
+                                    "host: example.com\r\n"
+                                    "x-empty:\r\n"
+                                    "x-spaces:   value with spaces  \r\n"
+                                    "\r\n"));
+  EXPECT_TRUE(callbacks_.message_complete_);
+  EXPECT_EQ("/path?query", callbacks_.url_);
+  const std::vector<std::pair<std::string, std::string>> expected_headers{
+      {"host", "example.com"}, {"x-empty", ""}, {"x-spaces", "value with spaces"}};
+  EXPECT_EQ(expected_headers, callbacks_.headers_);
+}
+
+// Empty header values, including those made only of whitespace, are passed on as empty strings.
+TEST_F(BalsaParserTest, EmptyHeaderValues) {
+  EXPECT_EQ(ParserStatus::Ok, parse("GET / HTTP/1.1\r\n"
+                                    "x-empty:\r\n"
+                                    "x-blank:   \r\n"
+                                    "\r\n"));
+  const std::vector<std::pair<std::string, std::string>> expected_headers{{"x-empty", ""},
+                                                                          {"x-blank", ""}};
+  EXPECT_EQ(expected_headers, callbacks_.headers_);
+}
+
+// The characters of header names are checked against the tokens of RFC 9110, Section 5.6.2.
+TEST_F(BalsaParserTest, HeaderNameCharacters) {
+  constexpr absl::string_view token_characters =
+      "!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`abcdefghijklmnopqrstuvwxyz|~";
+  for (int i = 0; i < 256; ++i) {
+    const char c = static_cast<char>(i);
+    // These end the name or the line.
+    if (c == ':' || c == '\r' || c == '\n') {
+      continue;
+    }
+    SCOPED_TRACE(i);
+    callbacks_ = RecordingParserCallbacks();
+    const std::string name = absl::StrCat("a", std::string(1, c), "b");
+    const ParserStatus status = parse(absl::StrCat("GET / HTTP/1.1\r\n", name, ": value\r\n\r\n"));
+    if (absl::StrContains(token_characters, std::string(1, c))) {
+      ASSERT_EQ(ParserStatus::Ok, status);
+      ASSERT_EQ(1, callbacks_.headers_.size());
+      EXPECT_EQ(name, callbacks_.headers_[0].first);
+    } else {
+      EXPECT_EQ(ParserStatus::Error, status);
+    }
+  }
+}
+
+// The printable characters of the path are accepted, unlike the control and non-ASCII ones.
+TEST_F(BalsaParserTest, PathCharacters) {
+  for (int i = '!'; i < 256; ++i) {
+    SCOPED_TRACE(i);
+    callbacks_ = RecordingParserCallbacks();
+    const std::string path = absl::StrCat("/a", std::string(1, static_cast<char>(i)));
+    const ParserStatus status = parse(absl::StrCat("GET ", path, " HTTP/1.1\r\n\r\n"));
+    if (i <= '~') {
+      ASSERT_EQ(ParserStatus::Ok, status);
+      EXPECT_EQ(path, callbacks_.url_);
+    } else {
+      EXPECT_EQ(ParserStatus::Error, status);
+    }
+  }
+}
+
+// Header values folded over several lines are the only ones which are copied, to remove the line
+// breaks.
+TEST_F(BalsaParserTest, FoldedHeaderValue) {
+  EXPECT_EQ(ParserStatus::Ok, parse("GET / HTTP/1.1\r\n"
+                                    "x-folded: first\r\n"
+                                    " second\r\n"
+                                    "\r\n"));
+  ASSERT_EQ(1, callbacks_.headers_.size());
+  const std::string& value = callbacks_.headers_[0].second;
+  EXPECT_TRUE(absl::StartsWith(value, "first"));
+  EXPECT_TRUE(absl::EndsWith(value, "second"));
+  EXPECT_FALSE(absl::StrContains(value, "\r"));
+  EXPECT_FALSE(absl::StrContains(value, "\n"));
+}
+
+} // namespace
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,72 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/http1/codec_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/overload_manager.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+// Range args are:
+// 0 - the number of headers of the response, besides the date and the content type.
+// Encodes the headers of responses to requests on a keep-alive connection.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ServerResponseHeadersEncode(benchmark::State& state) {
+  NiceMock<Network::MockConnection> connection;
+  NiceMock<MockServerConnectionCallbacks> callbacks;
+  NiceMock<MockRequestDecoder> decoder;
+  NiceMock<Server::MockOverloadManager> overload_manager;
+  Stats::IsolatedStoreImpl store;
+  CodecStats::AtomicPtr codec_stats;
+  const Http1Settings settings;
+  ServerConnectionImpl codec(connection, CodecStats::atomicGet(codec_stats, *store.rootScope()),
+                             callbacks, settings, DEFAULT_MAX_REQUEST_HEADERS_KB,
+                             DEFAULT_MAX_HEADERS_COUNT,
+                             envoy::config::core::v3::HttpProtocolOptions::ALLOW,
+                             overload_manager);
+
+  ResponseEncoder* response_encoder = nullptr;
+  ON_CALL(callbacks, newStream(_, _))
+      .WillByDefault(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  TestResponseHeaderMapImpl headers{{":status", "200"},
+                                    {"date", "Mon, 01 Jan 2024 00:00:00 GMT"},
+                                    {"content-type", "text/html; charset=utf-8"}};
+  for (int i = 0; i < state.range(0); ++i) {
+    headers.addCopy(absl::StrCat("x-custom-header-", i), absl::StrCat("some-header-value-", i));
+  }
+
+  for (auto _ : state) { // NOLINT
+    Buffer::OwnedImpl request("GET / HTTP/1.1\r\nhost: example.com\r\n\r\n");
+    benchmark::DoNotOptimize(codec.dispatch(request).ok());
+    response_encoder->encodeHeaders(headers, true);
+    // Run the deletion of the completed request as the dispatcher would.
+    connection.dispatcher_.to_delete_.clear();
+  }
+}
+BENCHMARK(BM_ServerResponseHeadersEncode)->Arg(0)->Arg(10)->Arg(30);
+
+} // namespace
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
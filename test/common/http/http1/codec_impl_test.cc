@@ -13,6 +13,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/http/exception.h"
 #include "source/common/http/header_map_impl.h"
+#include "source/common/http/header_value_interner.h"
 #include "source/common/http/http1/codec_impl.h"
 #include "source/common/runtime/runtime_impl.h"
 #include "source/extensions/http/header_validators/envoy_default/http1_header_validator.h"
@@ -1693,6 +1694,61 @@ TEST_P(Http1ServerConnectionImplTest, HeaderOnlyResponse) {
   EXPECT_EQ(Protocol::Http11, codec_->protocol());
 }
 
+// The status lines of codes without a preformatted status line are formatted on each response.
+TEST_P(Http1ServerConnectionImplTest, StatusLines) {
+  initialize();
+
+  for (const auto& [code, expected_status_line] :
+       std::vector<std::pair<std::string, std::string>>{{"200", "HTTP/1.1 200 OK"},
+                                                        {"599", "HTTP/1.1 599 Unknown"},
+                                                        {"600", "HTTP/1.1 600 Unknown"}}) {
+    SCOPED_TRACE(code);
+    NiceMock<MockRequestDecoder> decoder;
+    Http::ResponseEncoder* response_encoder = nullptr;
+    EXPECT_CALL(callbacks_, newStream(_, _))
+        .WillOnce(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+          response_encoder = &encoder;
+          return decoder;
+        }));
+
+    Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\n\r\n");
+    auto status = codec_->dispatch(buffer);
+    EXPECT_TRUE(status.ok());
+
+    std::string output;
+    ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+    TestResponseHeaderMapImpl headers{{":status", code}, {"foo", "bar"}};
+    response_encoder->encodeHeaders(headers, true);
+    EXPECT_EQ(absl::StrCat(expected_status_line, "\r\nfoo: bar\r\ncontent-length: 0\r\n\r\n"),
+              output);
+  }
+}
+
+TEST_P(Http1ServerConnectionImplTest, Http10StatusLine) {
+  codec_settings_.accept_http_10_ = true;
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .WillOnce(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.0\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestResponseHeaderMapImpl headers{{":status", "404"}};
+  response_encoder->encodeHeaders(headers, true);
+  EXPECT_EQ("HTTP/1.0 404 Not Found\r\ncontent-length: 0\r\n\r\n", output);
+}
+
 // As with Http1ClientConnectionImplTest.LargeHeaderRequestEncode but validate
 // the response encoder instead of request encoder.
 TEST_P(Http1ServerConnectionImplTest, LargeHeaderResponseEncode) {
@@ -2793,6 +2849,46 @@ TEST_P(Http1ClientConnectionImplTest, HeadRequest) {
   EXPECT_TRUE(status.ok());
 }
 
+// Long header values which are repeated across responses are interned, and shared by the header
+// maps of the responses rather than copied into each of them.
+TEST_P(Http1ClientConnectionImplTest, InternsRepeatedResponseHeaderValues) {
+  initialize();
+  HeaderValueInterner::get().clear();
+
+  const std::string policy(200, 'a');
+  std::vector<ResponseHeaderMapPtr> response_headers;
+  for (int i = 0; i < 3; ++i) {
+    NiceMock<MockResponseDecoder> response_decoder;
+    Http::RequestEncoder& request_encoder = codec_->newStream(response_decoder);
+    TestRequestHeaderMapImpl headers{{":method", "GET"}, {":path", "/"}, {":authority", "host"}};
+    EXPECT_TRUE(request_encoder.encodeHeaders(headers, true).ok());
+
+    EXPECT_CALL(response_decoder, decodeHeaders_(_, true))
+        .WillOnce(Invoke([&](ResponseHeaderMapPtr& decoded_headers, bool) {
+          response_headers.push_back(std::move(decoded_headers));
+        }));
+    Buffer::OwnedImpl response(absl::StrCat("HTTP/1.1 200 OK\r\nContent-Security-Policy: ", policy,
+                                            "\r\nContent-Length: 0\r\n\r\n"));
+    EXPECT_TRUE(codec_->dispatch(response).ok());
+  }
+
+  ASSERT_EQ(3U, response_headers.size());
+  std::vector<const HeaderString*> values;
+  for (const ResponseHeaderMapPtr& headers : response_headers) {
+    const auto policy_headers = headers->get(LowerCaseString("content-security-policy"));
+    ASSERT_EQ(1U, policy_headers.size());
+    EXPECT_EQ(policy, policy_headers[0]->value().getStringView());
+    values.push_back(&policy_headers[0]->value());
+  }
+  // The value is interned once seen in the second response.
+  EXPECT_FALSE(values[0]->isInterned());
+  EXPECT_TRUE(values[1]->isInterned());
+  EXPECT_TRUE(values[2]->isInterned());
+  EXPECT_EQ(values[1]->getStringView().data(), values[2]->getStringView().data());
+  // Short values are not interned, as copying them allocates nothing.
+  EXPECT_FALSE(response_headers[2]->ContentLength()->value().isInterned());
+}
+
 TEST_P(Http1ClientConnectionImplTest, 204Response) {
   initialize();
 
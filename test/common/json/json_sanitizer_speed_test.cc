@@ -1,3 +1,6 @@
+#include <string>
+
+#include "source/common/common/json_escape_string.h"
 #include "source/common/json/json_internal.h"
 #include "source/common/json/json_sanitizer.h"
 #include "source/common/protobuf/utility.h"
@@ -50,3 +53,47 @@ static void BM_NlohmannWithEscape(benchmark::State& state) {
   }
 }
 BENCHMARK(BM_NlohmannWithEscape);
+
+// Range args are:
+// 0 - the length of the string.
+// Sanitizes strings as long as typical access log fields, such as paths and user agents.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_SanitizeLongNoEscape(benchmark::State& state) {
+  const std::string str(state.range(0), 'a');
+  std::string buffer;
+
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Envoy::Json::sanitize(buffer, str));
+  }
+  state.SetBytesProcessed(state.iterations() * str.size());
+}
+BENCHMARK(BM_SanitizeLongNoEscape)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+
+// Range args are:
+// 0 - the length of the string, whose last character needs to be escaped.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_SanitizeLongWithEscape(benchmark::State& state) {
+  std::string str(state.range(0), 'a');
+  str.back() = '"';
+  std::string buffer;
+
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Envoy::Json::sanitize(buffer, str));
+  }
+  state.SetBytesProcessed(state.iterations() * str.size());
+}
+BENCHMARK(BM_SanitizeLongWithEscape)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+
+// Range args are:
+// 0 - the length of the string.
+// Computes the space needed to escape log messages without special characters.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_JsonEscaperExtraSpaceNoEscape(benchmark::State& state) {
+  const std::string str(state.range(0), 'a');
+
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(Envoy::JsonEscaper::extraSpace(str));
+  }
+  state.SetBytesProcessed(state.iterations() * str.size());
+}
+BENCHMARK(BM_JsonEscaperExtraSpaceNoEscape)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
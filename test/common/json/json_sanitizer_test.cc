@@ -7,6 +7,7 @@
 #include "test/common/json/json_sanitizer_test_util.h"
 #include "test/common/json/utf8.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -133,6 +134,20 @@ TEST_F(JsonSanitizerTest, Interspersed) {
   EXPECT_EQ("\\ra\\f", sanitizeAndCheckAgainstProtobufJson("\ra\f"));
 }
 
+// Strings longer than the blocks scanned at once are escaped wherever the special character is.
+TEST_F(JsonSanitizerTest, InterspersedInLongString) {
+  const std::string unescaped(80, 'a');
+  expectUnchanged(unescaped);
+  for (size_t i = 0; i < unescaped.size(); ++i) {
+    std::string str = unescaped;
+    str[i] = '\b';
+    EXPECT_EQ(absl::StrCat(unescaped.substr(0, i), "\\b", unescaped.substr(i + 1)),
+              sanitizeAndCheckAgainstProtobufJson(str));
+    str[i] = '\177';
+    sanitizeAndCheckAgainstProtobufJson(str);
+  }
+}
+
 TEST_F(JsonSanitizerTest, AllTwoByteUtf8) {
   char buf[2];
   absl::string_view utf8(buf, 2);
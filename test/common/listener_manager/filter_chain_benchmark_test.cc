@@ -190,6 +190,11 @@ const char YamlSingleDstPortBottom[] = R"EOF(
           session_ticket_keys:
             keys:
             - filename: "{{ test_rundir }}/test/common/tls/test_data/ticket_key_a")EOF";
+const char YamlSingleServerNameTop[] = R"EOF(
+    - filter_chain_match:
+        server_names: ")EOF";
+const char YamlSingleServerNameBottom[] = R"EOF("
+        transport_protocol: "tls")EOF";
 } // namespace
 
 class FilterChainBenchmarkFixture : public ::benchmark::Fixture {
@@ -208,6 +213,26 @@ public:
     filter_chains_ = listener_config_.filter_chains();
   }
 
+  // Configures one filter chain per server name, half of them with exact server names and the
+  // other half with wildcard ones.
+  void initializeServerNames(::benchmark::State& state) {
+    int64_t input_size = state.range(0);
+    std::vector<std::string> server_name_chains;
+    server_name_chains.reserve(input_size);
+    for (int i = 0; i < input_size; i++) {
+      const std::string server_name =
+          i % 2 == 0 ? absl::StrCat("server", i, ".example.com")
+                     : absl::StrCat("*.tenant", i, ".example.com");
+      server_name_chains.push_back(
+          absl::StrCat(YamlSingleServerNameTop, server_name, YamlSingleServerNameBottom));
+    }
+    listener_yaml_config_ = TestEnvironment::substitute(
+        absl::StrCat(YamlHeader, absl::StrJoin(server_name_chains, "")),
+        Network::Address::IpVersion::v4);
+    TestUtility::loadFromYaml(listener_yaml_config_, listener_config_);
+    filter_chains_ = listener_config_.filter_chains();
+  }
+
   Envoy::Thread::MutexBasicLockable lock_;
   Logger::Context logging_state_{spdlog::level::warn, Logger::Logger::DEFAULT_LOG_FORMAT, lock_,
                                  false};
@@ -267,6 +292,50 @@ BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindTest)
     }
   }
 }
+// Measures the selection of filter chains by server name, for the exact server names, the server
+// names matching a wildcard one with a few more labels, and the server names matching none.
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindByServerNameTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeServerNames(state);
+  std::vector<MockConnectionSocket> sockets;
+  sockets.reserve(state.range(0));
+  for (int i = 0; i < state.range(0); i++) {
+    std::string server_name;
+    switch (i % 4) {
+    case 0:
+      server_name = absl::StrCat("server", i, ".example.com");
+      break;
+    case 1:
+    case 3:
+      server_name = absl::StrCat("www.api.eu.tenant", i, ".example.com");
+      break;
+    default:
+      server_name = absl::StrCat("www.unknown", i, ".example.org");
+      break;
+    }
+    sockets.push_back(std::move(*MockConnectionSocket::createMockConnectionSocket(
+        1234, "127.0.0.1", server_name, "", "tls", {}, "8.8.8.8", 111)));
+  }
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234));
+  FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_};
+
+  THROW_IF_NOT_OK(filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr,
+                                                       dummy_builder_, filter_chain_manager));
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (int i = 0; i < state.range(0); i++) {
+      filter_chain_manager.findFilterChain(sockets[i], stream_info);
+    }
+  }
+}
 BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerBuildTest)
     ->Ranges({
         // scale of the chains
@@ -279,6 +348,12 @@ BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindTest)
         {1, 4096},
     })
     ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindByServerNameTest)
+    ->Ranges({
+        // scale of the chains
+        {1, 4096},
+    })
+    ->Unit(::benchmark::kMillisecond);
 
 /*
 clang-format off
@@ -184,6 +184,26 @@ TEST_P(FilterChainManagerImplTest, FilterChainMatchCaseInSensitive) {
   EXPECT_NE(filter_chain, nullptr);
 }
 
+TEST_P(FilterChainManagerImplTest, FilterChainMatchWildcardServerName) {
+  envoy::config::listener::v3::FilterChain new_filter_chain = filter_chain_template_;
+  new_filter_chain.mutable_filter_chain_match()->add_server_names("*.example.com");
+  addSingleFilterChainHelper(new_filter_chain);
+  EXPECT_NE(findFilterChainHelper(10000, "127.0.0.1", "foo.example.com", "tls", {}, "8.8.8.8", 111),
+            nullptr);
+  // Server names with more labels than the wildcard server name match it as well.
+  EXPECT_NE(
+      findFilterChainHelper(10000, "127.0.0.1", "a.b.foo.example.com", "tls", {}, "8.8.8.8", 111),
+      nullptr);
+  if (!GetParam()) {
+    // The filter chain matcher does not match on the server names of the filter chains.
+    EXPECT_EQ(findFilterChainHelper(10000, "127.0.0.1", "example.com", "tls", {}, "8.8.8.8", 111),
+              nullptr);
+    EXPECT_EQ(
+        findFilterChainHelper(10000, "127.0.0.1", "foo.example.org", "tls", {}, "8.8.8.8", 111),
+        nullptr);
+  }
+}
+
 TEST_P(FilterChainManagerImplTest, AddSingleFilterChain) {
   addSingleFilterChainHelper(filter_chain_template_);
   {
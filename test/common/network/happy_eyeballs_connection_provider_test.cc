@@ -5,8 +5,22 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/happy_eyeballs_connection_impl.h"
 
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/connection.h"
+#include "test/mocks/network/transport_socket.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/host.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
+using testing::DoAll;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+
 namespace Envoy {
 namespace Network {
 
@@ -114,5 +128,130 @@ TEST_F(HappyEyeballsConnectionProviderTest, SortAddressesWithHappyEyeballsConfig
             HappyEyeballsConnectionProvider::sortAddressesWithConfig(v6_then_v4, config_no_count));
 }
 
+class HappyEyeballsCachedFamilyTest : public testing::Test {
+protected:
+  using MockAddressSelector = NiceMock<Upstream::MockUpstreamLocalAddressSelector>;
+
+  HappyEyeballsCachedFamilyTest()
+      : host_(std::make_shared<NiceMock<Upstream::MockHostDescription>>()),
+        address_selector_(std::make_shared<MockAddressSelector>(local_address_)) {
+    config_.set_prefer_cached_address_family(true);
+  }
+
+  void setOutcome(Address::IpVersion family, std::chrono::milliseconds connect_time) {
+    host_->setHappyEyeballsOutcome(Upstream::HappyEyeballsOutcome{family, connect_time});
+  }
+
+  std::unique_ptr<HappyEyeballsConnectionProvider> createProvider() {
+    return std::make_unique<HappyEyeballsConnectionProvider>(
+        dispatcher_, addresses_, address_selector_, socket_factory_, nullptr, host_, nullptr,
+        config_);
+  }
+
+  // Returns the address of the next connection attempt of the provider.
+  Address::InstanceConstSharedPtr nextAddress(HappyEyeballsConnectionProvider& provider) {
+    Address::InstanceConstSharedPtr address;
+    EXPECT_CALL(dispatcher_, createClientConnection_(_, _, _, _))
+        .WillOnce(DoAll(SaveArg<0>(&address), Return(nullptr)));
+    provider.createNextConnection(0);
+    return address;
+  }
+
+  // Reports a connection attempt to the given address which took the given time.
+  void completeAttempt(HappyEyeballsConnectionProvider& provider,
+                       const Address::InstanceConstSharedPtr& address,
+                       std::chrono::milliseconds connect_time, bool success) {
+    NiceMock<MockClientConnection> connection;
+    connection.stream_info_.downstream_connection_info_provider_->setRemoteAddress(address);
+    connection.stream_info_.start_time_monotonic_ =
+        time_system_.monotonicTime() - connect_time;
+    provider.onConnectionAttemptComplete(connection, success);
+  }
+
+  Upstream::ClusterTrafficStats& stats() { return *host_->cluster_.traffic_stats_; }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  Address::InstanceConstSharedPtr local_address_;
+  std::shared_ptr<NiceMock<Upstream::MockHostDescription>> host_;
+  std::shared_ptr<MockAddressSelector> address_selector_;
+  NiceMock<MockTransportSocketFactory> socket_factory_;
+  envoy::config::cluster::v3::UpstreamConnectionOptions::HappyEyeballsConfig config_;
+  Address::InstanceConstSharedPtr ip_v4_{std::make_shared<Address::Ipv4Instance>("127.0.0.1")};
+  Address::InstanceConstSharedPtr ip_v6_{std::make_shared<Address::Ipv6Instance>("ff02::1", 0)};
+  std::vector<Address::InstanceConstSharedPtr> addresses_{ip_v6_, ip_v4_};
+};
+
+// Without a cached outcome, the addresses are attempted in the configured order with the default
+// delay, and the outcome of the attempts is cached.
+TEST_F(HappyEyeballsCachedFamilyTest, NoCachedEntry) {
+  auto provider = createProvider();
+  EXPECT_EQ(ConnectionProvider::DefaultNextAttemptDelay, provider->nextAttemptDelay());
+  EXPECT_EQ(ip_v6_, nextAddress(*provider));
+
+  completeAttempt(*provider, ip_v6_, std::chrono::milliseconds(300), false);
+  EXPECT_FALSE(host_->happyEyeballsOutcome().has_value());
+  completeAttempt(*provider, ip_v4_, std::chrono::milliseconds(20), true);
+  auto outcome = host_->happyEyeballsOutcome();
+  ASSERT_TRUE(outcome.has_value());
+  EXPECT_EQ(Address::IpVersion::v4, outcome->family_);
+  EXPECT_EQ(std::chrono::milliseconds(20), outcome->connect_time_);
+
+  EXPECT_EQ(0, stats().upstream_cx_happy_eyeballs_cached_family_.value());
+  EXPECT_EQ(0, stats().upstream_cx_happy_eyeballs_cached_delay_.value());
+}
+
+// The cached family is attempted first and the delay is derived from the cached connect time.
+TEST_F(HappyEyeballsCachedFamilyTest, CachedFamilyFirst) {
+  setOutcome(Address::IpVersion::v4, std::chrono::milliseconds(70));
+  auto provider = createProvider();
+  EXPECT_EQ(std::chrono::milliseconds(140), provider->nextAttemptDelay());
+  EXPECT_EQ(ip_v4_, nextAddress(*provider));
+  EXPECT_EQ(ip_v6_, nextAddress(*provider));
+  EXPECT_EQ(1, stats().upstream_cx_happy_eyeballs_cached_family_.value());
+  EXPECT_EQ(1, stats().upstream_cx_happy_eyeballs_cached_delay_.value());
+
+  // A failure of the other family keeps the cached outcome.
+  completeAttempt(*provider, ip_v6_, std::chrono::milliseconds(10), false);
+  EXPECT_TRUE(host_->happyEyeballsOutcome().has_value());
+
+  // A failure of the cached family clears it.
+  completeAttempt(*provider, ip_v4_, std::chrono::milliseconds(10), false);
+  EXPECT_FALSE(host_->happyEyeballsOutcome().has_value());
+}
+
+// The delay is bounded, and the order is unchanged if the cached family is already first.
+TEST_F(HappyEyeballsCachedFamilyTest, CachedDelayBounds) {
+  setOutcome(Address::IpVersion::v6, std::chrono::milliseconds(1));
+  EXPECT_EQ(std::chrono::milliseconds(100), createProvider()->nextAttemptDelay());
+
+  setOutcome(Address::IpVersion::v6, std::chrono::milliseconds(1000));
+  auto provider = createProvider();
+  EXPECT_EQ(ConnectionProvider::DefaultNextAttemptDelay, provider->nextAttemptDelay());
+  EXPECT_EQ(ip_v6_, nextAddress(*provider));
+  EXPECT_EQ(0, stats().upstream_cx_happy_eyeballs_cached_family_.value());
+  EXPECT_EQ(2, stats().upstream_cx_happy_eyeballs_cached_delay_.value());
+}
+
+// The cache is ignored if the host no longer has addresses of the cached family, or if it is not
+// enabled.
+TEST_F(HappyEyeballsCachedFamilyTest, CacheIgnored) {
+  setOutcome(Address::IpVersion::v4, std::chrono::milliseconds(10));
+  addresses_ = {ip_v6_, std::make_shared<Address::Ipv6Instance>("ff02::2", 0)};
+  EXPECT_EQ(ConnectionProvider::DefaultNextAttemptDelay, createProvider()->nextAttemptDelay());
+
+  addresses_ = {ip_v6_, ip_v4_};
+  config_.set_prefer_cached_address_family(false);
+  auto provider = createProvider();
+  EXPECT_EQ(ConnectionProvider::DefaultNextAttemptDelay, provider->nextAttemptDelay());
+  EXPECT_EQ(ip_v6_, nextAddress(*provider));
+  // Outcomes are not cached either.
+  completeAttempt(*provider, ip_v4_, std::chrono::milliseconds(10), false);
+  EXPECT_TRUE(host_->happyEyeballsOutcome().has_value());
+
+  EXPECT_EQ(0, stats().upstream_cx_happy_eyeballs_cached_family_.value());
+  EXPECT_EQ(0, stats().upstream_cx_happy_eyeballs_cached_delay_.value());
+}
+
 } // namespace Network
 } // namespace Envoy
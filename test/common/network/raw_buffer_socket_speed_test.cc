@@ -0,0 +1,61 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/network/raw_buffer_socket.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Network {
+
+// Receives messages of state.range(0) bytes over a socket pair, reading each of them as
+// RawBufferSocket::doRead() does, until the read would block. With state.range(1) set, the reads
+// are capped by an AdaptiveReadSize, otherwise each read reserves a full read reservation.
+static void readMessages(benchmark::State& state) {
+  const uint64_t message_size = state.range(0);
+  const bool adaptive = state.range(1) != 0;
+  int fds[2];
+  RELEASE_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, "");
+  RELEASE_ASSERT(::fcntl(fds[1], F_SETFL, O_NONBLOCK) == 0, "");
+  const int buffer_size = 1024 * 1024;
+  ::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+  ::setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+  IoSocketHandleImpl io_handle(fds[1]);
+  const std::string message(message_size, 'a');
+  AdaptiveReadSize read_size;
+  Buffer::OwnedImpl buffer;
+  uint64_t reads = 0;
+  for (auto _ : state) { // NOLINT
+    RELEASE_ASSERT(::write(fds[0], message.data(), message.size()) ==
+                       static_cast<ssize_t>(message.size()),
+                   "");
+    while (true) {
+      Api::IoCallUint64Result result =
+          io_handle.read(buffer, adaptive ? absl::make_optional(read_size.readSize())
+                                          : absl::nullopt);
+      if (!result.ok()) {
+        break;
+      }
+      ++reads;
+      read_size.onRead(result.return_value_);
+    }
+    buffer.drain(buffer.length());
+  }
+  state.counters["reads_per_message"] = static_cast<double>(reads) / state.iterations();
+  ::close(fds[0]);
+}
+BENCHMARK(readMessages)
+    ->ArgsProduct({{128, 1024, 16 * 1024, 64 * 1024}, {0, 1}})
+    ->ArgNames({"message_size", "adaptive"});
+
+} // namespace Network
+} // namespace Envoy
@@ -19,5 +19,46 @@ TEST(RawBufferSocketFactory, RawBufferSocketFactory) {
   EXPECT_GT(keys.size(), 0);
 }
 
+TEST(AdaptiveReadSize, GrowsWhenReadsFillTheReadSize) {
+  AdaptiveReadSize read_size;
+  EXPECT_EQ(AdaptiveReadSize::MinReadSize, read_size.readSize());
+
+  read_size.onRead(AdaptiveReadSize::MinReadSize);
+  EXPECT_EQ(AdaptiveReadSize::MinReadSize * 2, read_size.readSize());
+  read_size.onRead(AdaptiveReadSize::MinReadSize);
+  EXPECT_EQ(AdaptiveReadSize::MinReadSize * 2, read_size.readSize());
+
+  for (int i = 0; i < 10; ++i) {
+    read_size.onRead(read_size.readSize());
+  }
+  EXPECT_EQ(AdaptiveReadSize::MaxReadSize, read_size.readSize());
+}
+
+TEST(AdaptiveReadSize, ShrinksAfterShortReads) {
+  AdaptiveReadSize read_size;
+  read_size.onRead(AdaptiveReadSize::MinReadSize);
+  read_size.onRead(AdaptiveReadSize::MinReadSize * 2);
+  EXPECT_EQ(AdaptiveReadSize::MinReadSize * 4, read_size.readSize());
+
+  // A read of more than a quarter of the read size resets the count of short reads.
+  for (uint32_t i = 0; i < AdaptiveReadSize::ShrinkAfterShortReads - 1; ++i) {
+    read_size.onRead(100);
+  }
+  read_size.onRead(AdaptiveReadSize::MinReadSize * 2);
+  read_size.onRead(100);
+  EXPECT_EQ(AdaptiveReadSize::MinReadSize * 4, read_size.readSize());
+
+  for (uint32_t i = 0; i < AdaptiveReadSize::ShrinkAfterShortReads - 1; ++i) {
+    read_size.onRead(100);
+  }
+  EXPECT_EQ(AdaptiveReadSize::MinReadSize * 2, read_size.readSize());
+
+  // The read size never shrinks below a slice.
+  for (uint32_t i = 0; i < AdaptiveReadSize::ShrinkAfterShortReads * 4; ++i) {
+    read_size.onRead(100);
+  }
+  EXPECT_EQ(AdaptiveReadSize::MinReadSize, read_size.readSize());
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -1221,6 +1221,114 @@ virtual_hosts:
                           EnvoyException, "no argument for repetition operator");
 }
 
+// Consecutive regex routes are matched with a regex set, which must select the same routes as
+// matching the regexes one by one.
+TEST_F(RouteMatcherTest, TestRegexRouteSet) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: regex
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/prefix" }
+        route: { cluster: "prefix" }
+      - match:
+          safe_regex:
+            regex: "/a/.*"
+          headers:
+          - name: x-a
+            present_match: true
+        route: { cluster: "a_header" }
+      - match:
+          safe_regex:
+            regex: "/a/.*"
+        route: { cluster: "a" }
+      - match:
+          safe_regex:
+            regex: "/b/[0-9]+"
+        route: { cluster: "b" }
+      - match:
+          safe_regex:
+            regex: "/(a|b|c)/.*"
+        route: { cluster: "abc" }
+      - match: { path: "/d/1" }
+        route: { cluster: "d" }
+      - match: { prefix: "/" }
+        route: { cluster: "default" }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"prefix", "a_header", "a", "b", "abc", "d", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+  auto cluster_name = [&config](Http::TestRequestHeaderMapImpl headers) {
+    return config.route(headers, 0)->routeEntry()->clusterName();
+  };
+
+  EXPECT_EQ("prefix", cluster_name(genHeaders("www.lyft.com", "/prefix/a/1", "GET")));
+  EXPECT_EQ("a", cluster_name(genHeaders("www.lyft.com", "/a/1", "GET")));
+  EXPECT_EQ("a", cluster_name(genHeaders("www.lyft.com", "/a/1?b=2#c", "GET")));
+  Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/a/1", "GET");
+  headers.addCopy("x-a", "true");
+  EXPECT_EQ("a_header", cluster_name(headers));
+  EXPECT_EQ("b", cluster_name(genHeaders("www.lyft.com", "/b/12", "GET")));
+  EXPECT_EQ("abc", cluster_name(genHeaders("www.lyft.com", "/b/x", "GET")));
+  EXPECT_EQ("abc", cluster_name(genHeaders("www.lyft.com", "/c/1", "GET")));
+  EXPECT_EQ("d", cluster_name(genHeaders("www.lyft.com", "/d/1", "GET")));
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/e/1", "GET")));
+}
+
+// Consecutive prefix routes are matched with a radix tree, which must select the same routes as
+// matching the prefixes one by one.
+TEST_F(RouteMatcherTest, TestPrefixRouteSet) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: prefix
+    domains: ["*"]
+    routes:
+      - match: { path: "/x" }
+        route: { cluster: "x" }
+      - match:
+          prefix: "/api/v1/users"
+          headers:
+          - name: x-a
+            present_match: true
+        route: { cluster: "users_header" }
+      - match: { prefix: "/api/v1/users" }
+        route: { cluster: "users" }
+      - match: { prefix: "/api/v1/" }
+        route: { cluster: "v1" }
+      - match: { prefix: "/api/v1/users/admin" }
+        route: { cluster: "admin" }
+      - match: { prefix: "/static" }
+        route: { cluster: "static" }
+      - match: { prefix: "/IGNORE", case_sensitive: false }
+        route: { cluster: "ignore" }
+      - match: { prefix: "/" }
+        route: { cluster: "default" }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"x", "users_header", "users", "v1", "admin", "static", "ignore", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+  auto cluster_name = [&config](Http::TestRequestHeaderMapImpl headers) {
+    return config.route(headers, 0)->routeEntry()->clusterName();
+  };
+
+  EXPECT_EQ("x", cluster_name(genHeaders("www.lyft.com", "/x", "GET")));
+  EXPECT_EQ("users", cluster_name(genHeaders("www.lyft.com", "/api/v1/users/1", "GET")));
+  Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/api/v1/users", "GET");
+  headers.addCopy("x-a", "true");
+  EXPECT_EQ("users_header", cluster_name(headers));
+  EXPECT_EQ("users", cluster_name(genHeaders("www.lyft.com", "/api/v1/users/admin", "GET")));
+  EXPECT_EQ("v1", cluster_name(genHeaders("www.lyft.com", "/api/v1/groups", "GET")));
+  EXPECT_EQ("v1", cluster_name(genHeaders("www.lyft.com", "/api/v1/?users", "GET")));
+  EXPECT_EQ("static", cluster_name(genHeaders("www.lyft.com", "/static/a.css?v=1", "GET")));
+  EXPECT_EQ("ignore", cluster_name(genHeaders("www.lyft.com", "/ignore/1", "GET")));
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/API/v1/users", "GET")));
+  EXPECT_EQ("default", cluster_name(genHeaders("www.lyft.com", "/api/v2", "GET")));
+}
+
 // Virtual cluster that contains neither pattern nor regex. This must be checked while pattern is
 // deprecated.
 TEST_F(RouteMatcherTest, TestRoutesWithInvalidVirtualCluster) {
@@ -11123,6 +11231,17 @@ virtual_hosts:
 
   const auto route5 = config.route(genHeaders("host3", "/route5", "GET"), 0);
   EXPECT_TRUE(route5->filterDisabled("test.filter").value());
+
+  // The decisions of each route may be cached by an id of the route, which is not reused by the
+  // routes of another configuration.
+  EXPECT_NE(0, route1->filterDisabledCacheId());
+  EXPECT_NE(route1->filterDisabledCacheId(), route2->filterDisabledCacheId());
+  EXPECT_EQ(route1->filterDisabledCacheId(),
+            config.route(genHeaders("host1", "/route1", "GET"), 0)->filterDisabledCacheId());
+  const TestConfigImpl other_config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                                    creation_status_);
+  EXPECT_NE(route1->filterDisabledCacheId(),
+            other_config.route(genHeaders("host1", "/route1", "GET"), 0)->filterDisabledCacheId());
 }
 
 class RouteMatchOverrideTest : public testing::Test, public ConfigImplTestBase {};
@@ -46,5 +46,35 @@ static void bmEvaluateHeaders(benchmark::State& state) {
 
 BENCHMARK(bmEvaluateHeaders)->DenseRange(2, 20, 2);
 
+// Measures the evaluation of headers whose values only depend on the downstream connection. The
+// argument indicates whether the stream info has a connection ID, which allows the values to be
+// cached per connection rather than formatted for each stream.
+static void bmEvaluateConnectionHeaders(benchmark::State& state) {
+  Event::SimulatedTimeSystem time_system;
+  const auto stream_info = std::make_unique<Envoy::TestStreamInfo>(time_system);
+  stream_info->downstream_connection_info_provider_->setRequestedServerName("www.example.com");
+  if (state.range(0)) {
+    stream_info->downstream_connection_info_provider_->setConnectionID(1);
+  }
+
+  Protobuf::RepeatedPtrField<envoy::config::core::v3::HeaderValueOption> headers_to_add;
+  for (const absl::string_view value :
+       {"%REQUESTED_SERVER_NAME%", "%CONNECTION_ID%",
+        "sni=%REQUESTED_SERVER_NAME%;id=%CONNECTION_ID%"}) {
+    envoy::config::core::v3::HeaderValueOption* header_value_option = headers_to_add.Add();
+    header_value_option->set_append_action(HeaderValueOption::OVERWRITE_IF_EXISTS_OR_ADD);
+    header_value_option->mutable_header()->set_key(fmt::format("test{}", headers_to_add.size()));
+    header_value_option->mutable_header()->set_value(value);
+  }
+  HeaderParserPtr header_parser = HeaderParser::configure(headers_to_add).value();
+
+  auto request_header = Http::RequestHeaderMapImpl::create();
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    header_parser->evaluateHeaders(*request_header, {request_header.get()}, *stream_info);
+  }
+}
+
+BENCHMARK(bmEvaluateConnectionHeaders)->Arg(0)->Arg(1);
+
 } // namespace Router
 } // namespace Envoy
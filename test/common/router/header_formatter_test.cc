@@ -476,6 +476,117 @@ request_headers_to_add:
   EXPECT_EQ("static-value", header_map.get_("static-header"));
 }
 
+// Values without commands are rendered once, and referenced by the headers rather than copied.
+TEST(HeaderParserTest, EvaluateConstantHeaders) {
+  const std::string yaml = R"EOF(
+match: { prefix: "/new_endpoint" }
+route:
+  cluster: "www2"
+request_headers_to_add:
+  - header:
+      key: "constant-header"
+      value: "100%% constant"
+    append_action: OVERWRITE_IF_EXISTS_OR_ADD
+  - header:
+      key: "appended-header"
+      value: "appended"
+    append_action: APPEND_IF_EXISTS_OR_ADD
+)EOF";
+
+  HeaderParserPtr req_header_parser =
+      HeaderParser::configure(parseRouteFromV3Yaml(yaml).request_headers_to_add()).value();
+  Http::TestRequestHeaderMapImpl header_map{{":method", "POST"}, {"constant-header", "old"}};
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  req_header_parser->evaluateHeaders(header_map, stream_info);
+  EXPECT_EQ("100% constant", header_map.get_("constant-header"));
+  EXPECT_EQ("appended", header_map.get_("appended-header"));
+  EXPECT_TRUE(header_map.get(Http::LowerCaseString("constant-header"))[0]->value().isReference());
+  EXPECT_TRUE(header_map.get(Http::LowerCaseString("appended-header"))[0]->value().isReference());
+}
+
+// Values whose commands only depend on the downstream connection are formatted once per
+// connection.
+TEST(HeaderParserTest, EvaluateConnectionHeaders) {
+  const std::string yaml = R"EOF(
+match: { prefix: "/new_endpoint" }
+route:
+  cluster: "www2"
+request_headers_to_add:
+  - header:
+      key: "x-sni"
+      value: "sni=%REQUESTED_SERVER_NAME%"
+  - header:
+      key: "x-sni-and-protocol"
+      value: "%REQUESTED_SERVER_NAME% %PROTOCOL%"
+)EOF";
+
+  HeaderParserPtr req_header_parser =
+      HeaderParser::configure(parseRouteFromV3Yaml(yaml).request_headers_to_add()).value();
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  stream_info.downstream_connection_info_provider_->setConnectionID(1234);
+  stream_info.downstream_connection_info_provider_->setRequestedServerName("first.example.com");
+  absl::optional<Http::Protocol> protocol = Http::Protocol::Http11;
+  ON_CALL(stream_info, protocol()).WillByDefault(ReturnPointee(&protocol));
+
+  Http::TestRequestHeaderMapImpl first_header_map;
+  req_header_parser->evaluateHeaders(first_header_map, stream_info);
+  EXPECT_EQ("sni=first.example.com", first_header_map.get_("x-sni"));
+  EXPECT_EQ("first.example.com HTTP/1.1", first_header_map.get_("x-sni-and-protocol"));
+
+  // The server name can't change for a given connection, so a change is only observed for the
+  // values which are formatted for each stream.
+  stream_info.downstream_connection_info_provider_->setRequestedServerName("second.example.com");
+  Http::TestRequestHeaderMapImpl second_header_map;
+  req_header_parser->evaluateHeaders(second_header_map, stream_info);
+  EXPECT_EQ("sni=first.example.com", second_header_map.get_("x-sni"));
+  EXPECT_EQ("second.example.com HTTP/1.1", second_header_map.get_("x-sni-and-protocol"));
+
+  stream_info.downstream_connection_info_provider_->setConnectionID(1235);
+  Http::TestRequestHeaderMapImpl third_header_map;
+  req_header_parser->evaluateHeaders(third_header_map, stream_info);
+  EXPECT_EQ("sni=second.example.com", third_header_map.get_("x-sni"));
+}
+
+// The addresses of a QUIC connection change when it migrates, so they are formatted for each
+// stream even though they belong to the connection.
+TEST(HeaderParserTest, EvaluateAddressHeadersPerStream) {
+  const std::string yaml = R"EOF(
+match: { prefix: "/new_endpoint" }
+route:
+  cluster: "www2"
+request_headers_to_add:
+  - header:
+      key: "x-direct-remote"
+      value: "%DOWNSTREAM_DIRECT_REMOTE_ADDRESS%"
+  - header:
+      key: "x-local"
+      value: "%DOWNSTREAM_LOCAL_ADDRESS%"
+)EOF";
+
+  HeaderParserPtr req_header_parser =
+      HeaderParser::configure(parseRouteFromV3Yaml(yaml).request_headers_to_add()).value();
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  stream_info.downstream_connection_info_provider_->setConnectionID(1234);
+  stream_info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+      std::make_shared<Network::Address::Ipv4Instance>("10.0.0.1", 1000));
+  stream_info.downstream_connection_info_provider_->setLocalAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("10.0.0.2", 443));
+
+  Http::TestRequestHeaderMapImpl first_header_map;
+  req_header_parser->evaluateHeaders(first_header_map, stream_info);
+  EXPECT_EQ("10.0.0.1:1000", first_header_map.get_("x-direct-remote"));
+  EXPECT_EQ("10.0.0.2:443", first_header_map.get_("x-local"));
+
+  stream_info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+      std::make_shared<Network::Address::Ipv4Instance>("10.0.0.3", 2000));
+  stream_info.downstream_connection_info_provider_->setLocalAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("10.0.0.4", 443));
+  Http::TestRequestHeaderMapImpl second_header_map;
+  req_header_parser->evaluateHeaders(second_header_map, stream_info);
+  EXPECT_EQ("10.0.0.3:2000", second_header_map.get_("x-direct-remote"));
+  EXPECT_EQ("10.0.0.4:443", second_header_map.get_("x-local"));
+}
+
 TEST(HeaderParserTest, EvaluateCompoundHeaders) {
   const std::string yaml = R"EOF(
 match: { prefix: "/new_endpoint" }
@@ -278,6 +278,20 @@ TEST_F(StatsMatcherTest, CheckMultipleExcludeRegex) {
   EXPECT_FALSE(stats_matcher_impl_->rejectsAll());
 }
 
+// Regex matchers using the deprecated google_re2 field are matched separately from the others.
+TEST_F(StatsMatcherTest, CheckMultipleExcludeRegexWithGoogleRe2) {
+  exclusionList()->MergeFrom(TestUtility::createRegexMatcher(".*envoy.*"));
+  exclusionList()->MergeFrom(TestUtility::createRegexMatcher(".*absl.*"));
+  exclusionList()->mutable_safe_regex()->set_regex(".*grpc.*");
+  exclusionList()->mutable_safe_regex()->mutable_google_re2();
+  exclusionList()->set_suffix("requests");
+  initMatcher();
+  expectAccepted({"Abseil", "EnvoyProxy", "requests.total"});
+  expectDenied({"envoy.matchers", "stats.absl.2xx", "stats.grpc.2xx", "cluster.requests"});
+  EXPECT_FALSE(stats_matcher_impl_->acceptsAll());
+  EXPECT_FALSE(stats_matcher_impl_->rejectsAll());
+}
+
 // Multiple prefix/suffix/regex matchers.
 //
 // Matchers are "any_of", so strings matching any of the rules are expected to pass or fail,
@@ -170,6 +170,23 @@ TEST_F(StatNameTest, TestDynamicPools) {
   EXPECT_NE(dynamic2.data(), dynamic.data());
 }
 
+TEST_F(StatNameTest, AppendTo) {
+  StatNameDynamicPool dynamic(table_);
+  SymbolTable::StoragePtr joined = table_.join({makeStat("a.b"), dynamic.add("c.d")});
+
+  std::string out = "prefix.";
+  table_.appendTo(StatName(joined.get()), out);
+  EXPECT_EQ("prefix.a.b.c.d", out);
+  table_.appendTo(makeStat(""), out);
+  EXPECT_EQ("prefix.a.b.c.d", out);
+  table_.appendTo(StatName(), out);
+  EXPECT_EQ("prefix.a.b.c.d", out);
+
+  out.clear();
+  table_.appendTo(makeStat("e"), out);
+  EXPECT_EQ("e", out);
+}
+
 TEST_F(StatNameTest, TestDynamicHash) {
   StatNameDynamicPool dynamic(table_);
   const StatName d1 = dynamic.add("dynamic");
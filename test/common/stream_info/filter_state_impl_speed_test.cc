@@ -0,0 +1,120 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+#include <vector>
+
+#include "source/common/stream_info/filter_state_impl.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace StreamInfo {
+namespace {
+
+class TestObject : public FilterState::Object {};
+
+constexpr size_t NumWellKnownKeys = 5;
+
+std::vector<std::string> wellKnownNames() {
+  std::vector<std::string> names;
+  for (size_t i = 0; i < NumWellKnownKeys; ++i) {
+    names.push_back(absl::StrCat("envoy.test.well_known_", i));
+  }
+  return names;
+}
+
+std::vector<FilterState::InlineKey> registerWellKnownKeys() {
+  std::vector<FilterState::InlineKey> keys;
+  for (const std::string& name : wellKnownNames()) {
+    keys.push_back(FilterState::registerInlineKey(name));
+  }
+  return keys;
+}
+
+// Registered before the keys are finalized.
+const std::vector<FilterState::InlineKey> WellKnownKeys = registerWellKnownKeys();
+
+// Creates the filter state of a request, with 20 objects of other filters, and the well-known
+// objects stored with the given life span.
+std::unique_ptr<FilterStateImpl> createFilterState(FilterState::LifeSpan life_span) {
+  // As the server does on startup.
+  FilterState::finalizeInlineKeys();
+  auto filter_state = std::make_unique<FilterStateImpl>(FilterState::LifeSpan::FilterChain);
+  for (size_t i = 0; i < 20; ++i) {
+    filter_state->setData(absl::StrCat("envoy.test.dynamic_", i), std::make_shared<TestObject>(),
+                          FilterState::StateType::ReadOnly, FilterState::LifeSpan::Request);
+  }
+  for (const std::string& name : wellKnownNames()) {
+    filter_state->setData(name, std::make_shared<TestObject>(), FilterState::StateType::ReadOnly,
+                          life_span);
+  }
+  return filter_state;
+}
+
+// Range args are:
+// 0 - the life span of the well-known objects.
+// Looks up the well-known objects by name.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FilterStateGetByName(benchmark::State& state) {
+  const auto filter_state = createFilterState(FilterState::LifeSpan(state.range(0)));
+  const std::vector<std::string> names = wellKnownNames();
+  for (auto _ : state) { // NOLINT
+    for (const std::string& name : names) {
+      benchmark::DoNotOptimize(filter_state->getDataReadOnly<TestObject>(name));
+    }
+  }
+}
+BENCHMARK(BM_FilterStateGetByName)
+    ->Arg(FilterState::LifeSpan::FilterChain)
+    ->Arg(FilterState::LifeSpan::Connection);
+
+// Range args are:
+// 0 - the life span of the well-known objects.
+// Looks up the well-known objects by inline key.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FilterStateGetByInlineKey(benchmark::State& state) {
+  const auto filter_state = createFilterState(FilterState::LifeSpan(state.range(0)));
+  for (auto _ : state) { // NOLINT
+    for (const FilterState::InlineKey& key : WellKnownKeys) {
+      benchmark::DoNotOptimize(filter_state->getDataReadOnly<TestObject>(key));
+    }
+  }
+}
+BENCHMARK(BM_FilterStateGetByInlineKey)
+    ->Arg(FilterState::LifeSpan::FilterChain)
+    ->Arg(FilterState::LifeSpan::Connection);
+
+// Looks up the well-known objects by inline key when they are not set, which is the most common
+// case for most of them.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FilterStateGetMissingByInlineKey(benchmark::State& state) {
+  auto filter_state = std::make_unique<FilterStateImpl>(FilterState::LifeSpan::FilterChain);
+  filter_state->setData("envoy.test.dynamic", std::make_shared<TestObject>(),
+                        FilterState::StateType::ReadOnly, FilterState::LifeSpan::Connection);
+  for (auto _ : state) { // NOLINT
+    for (const FilterState::InlineKey& key : WellKnownKeys) {
+      benchmark::DoNotOptimize(filter_state->getDataReadOnly<TestObject>(key));
+    }
+  }
+}
+BENCHMARK(BM_FilterStateGetMissingByInlineKey);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_FilterStateGetMissingByName(benchmark::State& state) {
+  auto filter_state = std::make_unique<FilterStateImpl>(FilterState::LifeSpan::FilterChain);
+  filter_state->setData("envoy.test.dynamic", std::make_shared<TestObject>(),
+                        FilterState::StateType::ReadOnly, FilterState::LifeSpan::Connection);
+  const std::vector<std::string> names = wellKnownNames();
+  for (auto _ : state) { // NOLINT
+    for (const std::string& name : names) {
+      benchmark::DoNotOptimize(filter_state->getDataReadOnly<TestObject>(name));
+    }
+  }
+}
+BENCHMARK(BM_FilterStateGetMissingByName);
+
+} // namespace
+} // namespace StreamInfo
+} // namespace Envoy
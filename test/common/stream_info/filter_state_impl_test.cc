@@ -454,5 +454,88 @@ TEST_F(FilterStateImplTest, SetSameDataWithDifferentLifeSpan) {
   EXPECT_EQ(2, filterState().getDataMutable<SimpleType>("test_2")->access());
 }
 
+namespace {
+// Registered before any filter state is created.
+const FilterState::InlineKey TestInlineKey = FilterState::registerInlineKey("test_inline");
+const FilterState::InlineKey TestSharedInlineKey =
+    FilterState::registerInlineKey("test_shared_inline");
+} // namespace
+
+TEST_F(FilterStateImplTest, InlineKey) {
+  EXPECT_EQ(nullptr, filterState().getDataReadOnly<SimpleType>(TestInlineKey));
+
+  filterState().setData("test_inline", std::make_unique<SimpleType>(1),
+                        FilterState::StateType::Mutable, FilterState::LifeSpan::FilterChain);
+  filterState().setData("test_dynamic", std::make_unique<SimpleType>(2),
+                        FilterState::StateType::ReadOnly, FilterState::LifeSpan::FilterChain);
+  EXPECT_EQ(1, filterState().getDataReadOnly<SimpleType>(TestInlineKey)->access());
+  EXPECT_EQ(1, filterState().getDataReadOnly<SimpleType>("test_inline")->access());
+  EXPECT_EQ(2, filterState().getDataReadOnly<SimpleType>("test_dynamic")->access());
+  EXPECT_TRUE(filterState().hasData<SimpleType>(TestInlineKey));
+  EXPECT_FALSE(filterState().hasData<TestStoredTypeTracking>(TestInlineKey));
+  EXPECT_TRUE(filterState().hasDataWithName("test_inline"));
+
+  filterState().getDataMutable<SimpleType>(TestInlineKey)->set(3);
+  EXPECT_EQ(3, filterState().getDataReadOnly<SimpleType>("test_inline")->access());
+
+  // Overwriting mutable data by name replaces the data of the key.
+  filterState().setData("test_inline", std::make_unique<SimpleType>(4),
+                        FilterState::StateType::Mutable, FilterState::LifeSpan::FilterChain);
+  EXPECT_EQ(4, filterState().getDataReadOnly<SimpleType>(TestInlineKey)->access());
+  EXPECT_ENVOY_BUG(filterState().setData("test_inline", std::make_unique<SimpleType>(5),
+                                         FilterState::StateType::ReadOnly,
+                                         FilterState::LifeSpan::FilterChain),
+                   "FilterStateAccessViolation: FilterState::setData<T> called twice with "
+                   "different state types.");
+}
+
+TEST_F(FilterStateImplTest, InlineKeyLifeSpans) {
+  filterState().setData("test_inline", std::make_shared<SimpleType>(1),
+                        FilterState::StateType::ReadOnly, FilterState::LifeSpan::Connection);
+  filterState().setData("test_shared_inline", std::make_shared<SimpleType>(2),
+                        FilterState::StateType::Mutable, FilterState::LifeSpan::Request,
+                        StreamSharingMayImpactPooling::SharedWithUpstreamConnection);
+  EXPECT_TRUE(filterState().hasDataAtOrAboveLifeSpan(FilterState::LifeSpan::Connection));
+
+  FilterStateImpl new_filter_state(filterState().parent(), FilterState::LifeSpan::FilterChain);
+  EXPECT_EQ(1, new_filter_state.getDataReadOnly<SimpleType>(TestInlineKey)->access());
+  EXPECT_EQ(2, new_filter_state.getDataMutable<SimpleType>(TestSharedInlineKey)->access());
+  EXPECT_ENVOY_BUG(new_filter_state.getDataMutable<SimpleType>(TestInlineKey),
+                   "FilterStateAccessViolation: FilterState accessed immutable data as mutable.");
+
+  auto objects = new_filter_state.objectsSharedWithUpstreamConnection();
+  ASSERT_EQ(objects->size(), 1);
+  EXPECT_EQ(objects->at(0).name_, "test_shared_inline");
+  EXPECT_EQ(objects->at(0).data_.get(),
+            new_filter_state.getDataReadOnly<SimpleType>(TestSharedInlineKey));
+}
+
+TEST_F(FilterStateImplTest, InlineKeyRegisteredAfterFinalize) {
+  // Finalizing again is a no-op.
+  FilterState::finalizeInlineKeys();
+  ASSERT_TRUE(FilterState::inlineKeyDescriptor().finalized());
+  EXPECT_TRUE(TestInlineKey.handle().has_value());
+
+  filterState().setData("test_inline", std::make_unique<SimpleType>(1),
+                        FilterState::StateType::Mutable, FilterState::LifeSpan::FilterChain);
+
+  // Names registered after finalize look the data up by name, even if they have a slot.
+  const FilterState::InlineKey inline_key = FilterState::registerInlineKey("test_inline");
+  EXPECT_FALSE(inline_key.handle().has_value());
+  EXPECT_EQ(1, filterState().getDataReadOnly<SimpleType>(inline_key)->access());
+  EXPECT_EQ(1, filterState().getDataReadOnly<SimpleType>(TestInlineKey)->access());
+
+  const FilterState::InlineKey late_key = FilterState::registerInlineKey("test_late_inline");
+  EXPECT_FALSE(late_key.handle().has_value());
+  EXPECT_EQ("test_late_inline", late_key.name());
+  EXPECT_FALSE(filterState().hasData<SimpleType>(late_key));
+
+  filterState().setData("test_late_inline", std::make_unique<SimpleType>(2),
+                        FilterState::StateType::Mutable, FilterState::LifeSpan::Request);
+  EXPECT_EQ(2, filterState().getDataReadOnly<SimpleType>(late_key)->access());
+  filterState().getDataMutable<SimpleType>(late_key)->set(3);
+  EXPECT_EQ(3, filterState().getDataReadOnly<SimpleType>("test_late_inline")->access());
+}
+
 } // namespace StreamInfo
 } // namespace Envoy
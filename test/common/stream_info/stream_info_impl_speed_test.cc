@@ -0,0 +1,46 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <memory>
+
+#include "source/common/common/utility.h"
+#include "source/common/stream_info/stream_info_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace StreamInfo {
+namespace {
+
+// Creates the stream info of a request which no filter or access log inspects.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_StreamInfoCreate(benchmark::State& state) {
+  RealTimeSource time_source;
+  for (auto _ : state) { // NOLINT
+    auto stream_info = std::make_unique<StreamInfoImpl>(time_source, nullptr,
+                                                        FilterState::LifeSpan::FilterChain);
+    benchmark::DoNotOptimize(stream_info.get());
+  }
+  state.counters["stream_info_size"] = sizeof(StreamInfoImpl);
+}
+BENCHMARK(BM_StreamInfoCreate);
+
+// Creates the stream info of a request which is routed upstream, and so replaces its upstream
+// bytes meter with the one of the upstream request.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_StreamInfoCreateWithUpstream(benchmark::State& state) {
+  RealTimeSource time_source;
+  for (auto _ : state) { // NOLINT
+    auto stream_info = std::make_unique<StreamInfoImpl>(time_source, nullptr,
+                                                        FilterState::LifeSpan::FilterChain);
+    stream_info->setUpstreamInfo(std::make_shared<UpstreamInfoImpl>());
+    stream_info->setUpstreamBytesMeter(std::make_shared<BytesMeter>());
+    benchmark::DoNotOptimize(stream_info->getUpstreamBytesMeter().get());
+  }
+  state.counters["stream_info_size"] = sizeof(StreamInfoImpl);
+}
+BENCHMARK(BM_StreamInfoCreateWithUpstream);
+
+} // namespace
+} // namespace StreamInfo
+} // namespace Envoy
@@ -41,11 +41,11 @@ class StreamInfoImplTest : public testing::Test {
 protected:
   void assertStreamInfoSize(StreamInfoImpl stream_info) {
     ASSERT_TRUE(
-        sizeof(stream_info) == 840 || sizeof(stream_info) == 856 || sizeof(stream_info) == 888 ||
-        sizeof(stream_info) == 776 || sizeof(stream_info) == 728 || sizeof(stream_info) == 744 ||
-        sizeof(stream_info) == 680 || sizeof(stream_info) == 696 || sizeof(stream_info) == 688 ||
-        sizeof(stream_info) == 736 || sizeof(stream_info) == 728 || sizeof(stream_info) == 712 ||
-        sizeof(stream_info) == 704)
+        sizeof(stream_info) == 824 || sizeof(stream_info) == 840 || sizeof(stream_info) == 872 ||
+        sizeof(stream_info) == 760 || sizeof(stream_info) == 712 || sizeof(stream_info) == 728 ||
+        sizeof(stream_info) == 664 || sizeof(stream_info) == 680 || sizeof(stream_info) == 672 ||
+        sizeof(stream_info) == 720 || sizeof(stream_info) == 712 || sizeof(stream_info) == 696 ||
+        sizeof(stream_info) == 688)
         << "If adding fields to StreamInfoImpl, please check to see if you "
            "need to add them to setFromForRecreateStream or setFrom! Current size "
         << sizeof(stream_info);
@@ -573,6 +573,25 @@ TEST_F(StreamInfoImplTest, DownstreamTransportFailureReason) {
   EXPECT_EQ(stream_info.downstreamTransportFailureReason(), "TLS error");
 }
 
+TEST_F(StreamInfoImplTest, UpstreamBytesMeter) {
+  StreamInfoImpl stream_info(test_time_.timeSystem(), nullptr, FilterState::LifeSpan::FilterChain);
+  // The meter of the upstream request can be set before the default one is used.
+  auto upstream_bytes_meter = std::make_shared<BytesMeter>();
+  stream_info.setUpstreamBytesMeter(upstream_bytes_meter);
+  EXPECT_EQ(upstream_bytes_meter, stream_info.getUpstreamBytesMeter());
+
+  // Otherwise the default meter is created on first use and stays the same.
+  StreamInfoImpl other_stream_info(test_time_.timeSystem(), nullptr,
+                                   FilterState::LifeSpan::FilterChain);
+  const BytesMeterSharedPtr default_bytes_meter = other_stream_info.getUpstreamBytesMeter();
+  ASSERT_NE(nullptr, default_bytes_meter);
+  default_bytes_meter->addWireBytesSent(10);
+  EXPECT_EQ(default_bytes_meter, other_stream_info.getUpstreamBytesMeter());
+  EXPECT_EQ(10, other_stream_info.getUpstreamBytesMeter()->wireBytesSent());
+  other_stream_info.setUpstreamBytesMeter(upstream_bytes_meter);
+  EXPECT_EQ(upstream_bytes_meter, other_stream_info.getUpstreamBytesMeter());
+}
+
 TEST(UpstreamInfoImplTest, DumpState) {
   UpstreamInfoImpl upstream_info;
 
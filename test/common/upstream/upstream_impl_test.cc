@@ -1643,6 +1643,28 @@ TEST_F(HostImplTest, HostLbPolicyData) {
   EXPECT_EQ(test_policy_data->foo, 42);
 }
 
+TEST_F(HostImplTest, HappyEyeballsOutcome) {
+  MockClusterMockPrioritySet cluster;
+  HostSharedPtr host = makeTestHost(cluster.info_, "tcp://10.0.0.1:1234", simTime(), 1);
+  EXPECT_FALSE(host->happyEyeballsOutcome().has_value());
+
+  host->setHappyEyeballsOutcome(
+      HappyEyeballsOutcome{Network::Address::IpVersion::v6, std::chrono::milliseconds(25)});
+  ASSERT_TRUE(host->happyEyeballsOutcome().has_value());
+  EXPECT_EQ(Network::Address::IpVersion::v6, host->happyEyeballsOutcome()->family_);
+  EXPECT_EQ(std::chrono::milliseconds(25), host->happyEyeballsOutcome()->connect_time_);
+
+  // A zero connect time is still an outcome.
+  host->setHappyEyeballsOutcome(
+      HappyEyeballsOutcome{Network::Address::IpVersion::v4, std::chrono::milliseconds(0)});
+  ASSERT_TRUE(host->happyEyeballsOutcome().has_value());
+  EXPECT_EQ(Network::Address::IpVersion::v4, host->happyEyeballsOutcome()->family_);
+  EXPECT_EQ(std::chrono::milliseconds(0), host->happyEyeballsOutcome()->connect_time_);
+
+  host->setHappyEyeballsOutcome(absl::nullopt);
+  EXPECT_FALSE(host->happyEyeballsOutcome().has_value());
+}
+
 TEST_F(HostImplTest, HostnameCanaryAndLocality) {
   MockClusterMockPrioritySet cluster;
   envoy::config::core::v3::Metadata metadata;
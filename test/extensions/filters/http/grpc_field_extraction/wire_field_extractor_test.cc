@@ -0,0 +1,165 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/http/grpc_field_extraction/wire_field_extractor.h"
+
+#include "test/proto/apikeys.pb.h"
+#include "test/test_common/utility.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcFieldExtraction {
+namespace {
+
+using ::apikeys::CreateApiKeyRequest;
+
+constexpr absl::string_view RequestTypeUrl = "type.googleapis.com/apikeys.CreateApiKeyRequest";
+
+class WireFieldExtractorTest : public ::testing::Test {
+protected:
+  WireFieldExtractorTest()
+      : type_resolver_(Protobuf::util::NewTypeResolverForDescriptorPool(
+            "type.googleapis.com", Protobuf::DescriptorPool::generated_pool())),
+        type_finder_([this](const std::string& type_url) -> const Protobuf::Type* {
+          auto& type = types_[type_url];
+          if (type == nullptr) {
+            type = std::make_unique<Protobuf::Type>();
+            if (!type_resolver_->ResolveMessageType(type_url, type.get()).ok()) {
+              type.reset();
+            }
+          }
+          return type.get();
+        }) {}
+
+  WireFieldExtractorPtr createExtractor(const std::vector<absl::string_view>& paths) {
+    auto extractor = WireFieldExtractor::create(type_finder_, RequestTypeUrl, paths);
+    EXPECT_TRUE(extractor.ok()) << extractor.status();
+    return std::move(extractor.value());
+  }
+
+  // Extracts the paths from `bytes`, split into slices of `slice_size` bytes.
+  std::vector<std::vector<std::string>> extract(const std::vector<absl::string_view>& paths,
+                                                absl::string_view bytes, size_t slice_size = 1) {
+    Buffer::OwnedImpl message;
+    for (size_t i = 0; i < bytes.size(); i += slice_size) {
+      message.appendSliceForTest(bytes.substr(i, slice_size));
+    }
+    auto values = createExtractor(paths)->extract(message);
+    EXPECT_TRUE(values.ok()) << values.status();
+
+    std::vector<std::vector<std::string>> result;
+    for (const ProtobufWkt::Value& value : *values) {
+      result.emplace_back();
+      for (const ProtobufWkt::Value& element : value.list_value().values()) {
+        result.back().push_back(element.string_value());
+      }
+    }
+    return result;
+  }
+
+  std::unique_ptr<Protobuf::util::TypeResolver> type_resolver_;
+  absl::flat_hash_map<std::string, std::unique_ptr<Protobuf::Type>> types_;
+  const TypeFinder type_finder_;
+};
+
+CreateApiKeyRequest makeRequest(absl::string_view pb) {
+  CreateApiKeyRequest request;
+  EXPECT_TRUE(Protobuf::TextFormat::ParseFromString(pb, &request));
+  return request;
+}
+
+TEST_F(WireFieldExtractorTest, SupportedTypesAcrossSlices) {
+  const CreateApiKeyRequest request = makeRequest(R"pb(
+    parent: "project-id"
+    key { name: "key-name" display_name: "skipped" }
+    supported_types {
+      string: "1" uint32: 2 uint64: 3 int32: -4 int64: -5 sint32: -6 sint64: -7
+      fixed32: 8 fixed64: 9 sfixed32: -10 sfixed64: -11 float: 1.2 double: 1.3
+    }
+    repeated_supported_types { int32: [ 1, -1 ] string: [ "a", "b" ] double: [ 0.5, 2 ] }
+  )pb");
+  const std::string bytes = request.SerializeAsString();
+
+  for (size_t slice_size : {1, 3, 1024}) {
+    EXPECT_THAT(
+        extract({"parent", "key.name", "supported_types.string", "supported_types.uint32",
+                 "supported_types.uint64", "supported_types.int32", "supported_types.int64",
+                 "supported_types.sint32", "supported_types.sint64", "supported_types.fixed32",
+                 "supported_types.fixed64", "supported_types.sfixed32", "supported_types.sfixed64",
+                 "supported_types.float", "supported_types.double",
+                 "repeated_supported_types.int32", "repeated_supported_types.string",
+                 "repeated_supported_types.double", "repeated_supported_types.uint32"},
+                bytes, slice_size),
+        testing::ElementsAre(
+            testing::ElementsAre("project-id"), testing::ElementsAre("key-name"),
+            testing::ElementsAre("1"), testing::ElementsAre("2"), testing::ElementsAre("3"),
+            testing::ElementsAre("-4"), testing::ElementsAre("-5"), testing::ElementsAre("-6"),
+            testing::ElementsAre("-7"), testing::ElementsAre("8"), testing::ElementsAre("9"),
+            testing::ElementsAre("-10"), testing::ElementsAre("-11"),
+            testing::ElementsAre("1.2"), testing::ElementsAre("1.3"),
+            testing::ElementsAre("1", "-1"), testing::ElementsAre("a", "b"),
+            testing::ElementsAre("0.5", "2"), testing::IsEmpty()));
+  }
+}
+
+// Repeated numeric fields may be sent either packed or not.
+TEST_F(WireFieldExtractorTest, UnpackedRepeatedField) {
+  // repeated_supported_types { uint32: 7 uint32: 8 }, with a field per value.
+  const std::string bytes("\x22\x04\x10\x07\x10\x08", 6);
+  EXPECT_THAT(extract({"repeated_supported_types.uint32"}, bytes),
+              testing::ElementsAre(testing::ElementsAre("7", "8")));
+}
+
+// As when parsing the message, the last value of a singular field wins, and the occurrences of a
+// singular message field are merged.
+TEST_F(WireFieldExtractorTest, LastValueOfSingularFieldWins) {
+  const std::string bytes =
+      makeRequest(R"pb(parent: "first" key { name: "name" })pb").SerializeAsString() +
+      makeRequest(R"pb(parent: "second" key { display_name: "display" })pb").SerializeAsString();
+  EXPECT_THAT(extract({"parent", "key.name", "key.display_name"}, bytes),
+              testing::ElementsAre(testing::ElementsAre("second"), testing::ElementsAre("name"),
+                                   testing::ElementsAre("display")));
+}
+
+TEST_F(WireFieldExtractorTest, SkipsUnknownFields) {
+  // An unknown group (field 9) containing a varint, then parent: "p" and an unknown fixed64.
+  const std::string bytes("\x4b\x08\x01\x4c\x0a\x01p\x51\x01\x02\x03\x04\x05\x06\x07\x08", 16);
+  EXPECT_THAT(extract({"parent"}, bytes), testing::ElementsAre(testing::ElementsAre("p")));
+}
+
+TEST_F(WireFieldExtractorTest, MalformedMessage) {
+  const std::string bytes =
+      makeRequest(R"pb(parent: "project-id" key { name: "key-name" })pb").SerializeAsString();
+  const size_t parent_size = makeRequest(R"pb(parent: "project-id")pb").ByteSizeLong();
+  WireFieldExtractorPtr extractor = createExtractor({"key.name"});
+  for (size_t length = 1; length < bytes.size(); ++length) {
+    if (length == parent_size) {
+      // A valid message.
+      continue;
+    }
+    Buffer::OwnedImpl message(bytes.substr(0, length));
+    EXPECT_EQ(extractor->extract(message).status().code(), absl::StatusCode::kInvalidArgument)
+        << length;
+  }
+
+  // A group which isn't closed by its own end tag.
+  Buffer::OwnedImpl message(absl::string_view("\x4b\x54", 2));
+  EXPECT_EQ(extractor->extract(message).status().code(), absl::StatusCode::kInvalidArgument);
+}
+
+TEST_F(WireFieldExtractorTest, InvalidPaths) {
+  for (absl::string_view path :
+       {"unknown", "key.create_time", "unsupported_types.bool", "parent.name",
+        "repeated_supported_types.map.key"}) {
+    EXPECT_FALSE(WireFieldExtractor::create(type_finder_, RequestTypeUrl, {path}).ok()) << path;
+  }
+}
+
+} // namespace
+} // namespace GrpcFieldExtraction
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,132 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/extensions/filters/http/grpc_json_transcoder/v3/transcoder.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/grpc/common.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/grpc_json_transcoder/json_transcoder_filter.h"
+
+#include "test/mocks/http/mocks.h"
+#include "test/proto/bookstore.pb.h"
+#include "test/test_common/utility.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcJsonTranscoder {
+namespace {
+
+// Adds the descriptor of `file` and of all its dependencies to `descriptor_set`, dependencies
+// first, so that the config can be built from the descriptors compiled into the binary.
+void addFileDescriptors(const Protobuf::FileDescriptor& file,
+                        absl::flat_hash_set<std::string>& added,
+                        Protobuf::FileDescriptorSet& descriptor_set) {
+  if (!added.insert(file.name()).second) {
+    return;
+  }
+  for (int i = 0; i < file.dependency_count(); ++i) {
+    addFileDescriptors(*file.dependency(i), added, descriptor_set);
+  }
+  file.CopyTo(descriptor_set.add_file());
+}
+
+JsonTranscoderConfigSharedPtr makeBookstoreConfig(Api::Api& api) {
+  Protobuf::FileDescriptorSet descriptor_set;
+  absl::flat_hash_set<std::string> added;
+  addFileDescriptors(*bookstore::Book::descriptor()->file(), added, descriptor_set);
+
+  envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder proto_config;
+  proto_config.set_proto_descriptor_bin(descriptor_set.SerializeAsString());
+  proto_config.add_services("bookstore.Bookstore");
+  return std::make_shared<JsonTranscoderConfig>(proto_config, api);
+}
+
+// Transcodes the gRPC `response` of the method at `path`, arriving in data chunks of `chunk_size`.
+void transcodeResponse(benchmark::State& state, const std::string& path,
+                       const std::string& response, uint64_t chunk_size) {
+  Stats::IsolatedStoreImpl store;
+  Api::ApiPtr api = Api::createApiForTest();
+  JsonTranscoderConfigSharedPtr config = makeBookstoreConfig(*api);
+  GrpcJsonTranscoderFilterStatsSharedPtr stats = std::make_shared<GrpcJsonTranscoderFilterStats>(
+      GrpcJsonTranscoderFilterStats::generateStats("prefix", *store.rootScope()));
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+  NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks;
+  ON_CALL(decoder_callbacks, decoderBufferLimit()).WillByDefault(Return(1 << 20));
+  ON_CALL(encoder_callbacks, encoderBufferLimit()).WillByDefault(Return(1 << 20));
+
+  for (auto _ : state) { // NOLINT
+    state.PauseTiming();
+    JsonTranscoderFilter filter(config, stats);
+    filter.setDecoderFilterCallbacks(decoder_callbacks);
+    filter.setEncoderFilterCallbacks(encoder_callbacks);
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"}, {":path", path}};
+    filter.decodeHeaders(request_headers, true);
+    Http::TestResponseHeaderMapImpl response_headers{{"content-type", "application/grpc"},
+                                                     {":status", "200"}};
+    filter.encodeHeaders(response_headers, false);
+    state.ResumeTiming();
+
+    for (uint64_t offset = 0; offset < response.size(); offset += chunk_size) {
+      Buffer::OwnedImpl data(absl::string_view(response).substr(offset, chunk_size));
+      filter.encodeData(data, offset + chunk_size >= response.size());
+      benchmark::DoNotOptimize(data.length());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * response.size());
+}
+
+// Measures the transcoding of a server streaming response of 512 KiB, made of messages of the size
+// given by the first argument, arriving in data chunks of the size given by the second argument.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ServerStreamingResponse(benchmark::State& state) {
+  const uint64_t message_size = state.range(0);
+  constexpr uint64_t ResponseSize = 512 << 10;
+
+  bookstore::Book book;
+  book.set_id(1);
+  book.set_author("Leo Tolstoy");
+  book.set_title("War and Peace");
+  while (book.ByteSizeLong() < message_size) {
+    book.add_quotes("Happy families are all alike; every unhappy family is unhappy in its own way");
+  }
+  const std::string frame = Grpc::Common::serializeToGrpcFrame(book)->toString();
+  std::string response;
+  while (response.size() < ResponseSize) {
+    response += frame;
+  }
+
+  transcodeResponse(state, "/shelves/1/books", response, state.range(1));
+}
+BENCHMARK(BM_ServerStreamingResponse)
+    ->ArgsProduct({{100, 4096, 65536}, {16384, 262144}})
+    ->Unit(benchmark::kMillisecond);
+
+// Measures the transcoding of a unary response with the number of shelves given by the argument,
+// arriving in data chunks of 16 KiB.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_UnaryResponse(benchmark::State& state) {
+  bookstore::ListShelvesResponse shelves;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    bookstore::Shelf* shelf = shelves.add_shelves();
+    shelf->set_id(i);
+    shelf->set_theme("Children");
+  }
+  const std::string response = Grpc::Common::serializeToGrpcFrame(shelves)->toString();
+
+  transcodeResponse(state, "/shelves", response, 16384);
+}
+BENCHMARK(BM_UnaryResponse)->Arg(100)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace GrpcJsonTranscoder
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
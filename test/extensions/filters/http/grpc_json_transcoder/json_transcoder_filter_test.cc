@@ -18,6 +18,8 @@
 #include "test/test_common/printers.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -860,6 +862,50 @@ TEST_F(GrpcJsonTranscoderFilterTest, ResponseBodyExceedsBufferLimit) {
             filter_.encodeData(second_half_response_data, false));
 }
 
+// The encoder buffer limit of server streaming responses applies to each message, not to the data
+// received at once.
+TEST_F(GrpcJsonTranscoderFilterTest, ServerStreamingResponseExceedsBufferLimitPerMessage) {
+  constexpr int kBufferLimit = 64;
+  EXPECT_CALL(encoder_callbacks_, encoderBufferLimit())
+      .Times(testing::AtLeast(1))
+      .WillRepeatedly(Return(kBufferLimit));
+
+  Http::TestRequestHeaderMapImpl request_headers{{":method", "GET"},
+                                                 {":path", "/shelves/1/books"}};
+  EXPECT_CALL(decoder_callbacks_.downstream_callbacks_, clearRouteCache());
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers, true));
+
+  Http::TestResponseHeaderMapImpl response_headers{{"content-type", "application/grpc"},
+                                                   {":status", "200"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.encodeHeaders(response_headers, false));
+
+  // Many small messages in a single chunk of data, larger than the limit.
+  Buffer::OwnedImpl response_data;
+  for (int i = 1; i <= 10; ++i) {
+    bookstore::Book book;
+    book.set_id(i);
+    book.set_title(absl::StrCat("Title ", i));
+    response_data.move(*Grpc::Common::serializeToGrpcFrame(book));
+  }
+  ASSERT_GT(response_data.length(), kBufferLimit);
+
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply).Times(0);
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.encodeData(response_data, false));
+  const std::string response_json = response_data.toString();
+  for (int i = 1; i <= 10; ++i) {
+    EXPECT_TRUE(absl::StrContains(response_json, absl::StrCat("\"title\":\"Title ", i, "\"")));
+  }
+
+  // A single message larger than the limit is rejected.
+  bookstore::Book book;
+  book.set_id(11);
+  book.set_title(std::string(kBufferLimit, 'a'));
+  auto large_response_data = Grpc::Common::serializeToGrpcFrame(book);
+  EXPECT_CALL(encoder_callbacks_, sendLocalReply(Http::Code::InternalServerError, _, _, _, _));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer,
+            filter_.encodeData(*large_response_data, false));
+}
+
 class GrpcJsonTranscoderFilterSkipRecalculatingTest : public GrpcJsonTranscoderFilterTest {
 public:
   GrpcJsonTranscoderFilterSkipRecalculatingTest()
@@ -0,0 +1,75 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/grpc/codec.h"
+#include "source/common/grpc/context_impl.h"
+#include "source/common/http/headers.h"
+#include "source/extensions/filters/http/grpc_web/grpc_web_filter.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/http/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcWeb {
+
+// Measures the base64 encoding of a server-streaming response in application/grpc-web-text, with
+// frames of the message size given by the first argument, arriving in data chunks of the size given
+// by the second argument.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_TextResponseStreaming(benchmark::State& state) {
+  const uint64_t message_size = state.range(0);
+  const uint64_t chunk_size = state.range(1);
+  constexpr uint64_t ResponseSize = 4 << 20;
+
+  Buffer::OwnedImpl frame;
+  TestUtility::feedBufferWithRandomCharacters(frame, message_size);
+  Grpc::Encoder().prependFrameHeader(Grpc::GRPC_FH_DEFAULT, frame);
+  std::string response;
+  while (response.size() < ResponseSize) {
+    response += frame.toString();
+  }
+
+  Stats::TestUtil::TestSymbolTable symbol_table;
+  Grpc::ContextImpl grpc_context(*symbol_table);
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks;
+  NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks;
+
+  for (auto _ : state) { // NOLINT
+    state.PauseTiming();
+    GrpcWebFilter filter(grpc_context);
+    filter.setDecoderFilterCallbacks(decoder_callbacks);
+    filter.setEncoderFilterCallbacks(encoder_callbacks);
+    Http::TestRequestHeaderMapImpl request_headers{
+        {":path", "/"},
+        {"content-type", Http::Headers::get().ContentTypeValues.GrpcWebText},
+        {"accept", Http::Headers::get().ContentTypeValues.GrpcWebText}};
+    filter.decodeHeaders(request_headers, true);
+    Http::TestResponseHeaderMapImpl response_headers{
+        {":status", "200"}, {"content-type", Http::Headers::get().ContentTypeValues.Grpc}};
+    filter.encodeHeaders(response_headers, false);
+    state.ResumeTiming();
+
+    for (uint64_t offset = 0; offset < response.size(); offset += chunk_size) {
+      Buffer::OwnedImpl data(absl::string_view(response).substr(offset, chunk_size));
+      filter.encodeData(data, false);
+      benchmark::DoNotOptimize(data.length());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * response.size());
+}
+BENCHMARK(BM_TextResponseStreaming)
+    ->ArgsProduct({{100, 16384, 1 << 20}, {4096, 16384, 65536}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace GrpcWeb
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -308,6 +308,58 @@ TEST_F(GrpcWebFilterTest, Base64NoPadding) {
   EXPECT_EQ(decoder_callbacks_.details(), "grpc_base_64_decode_failed_bad_size");
 }
 
+TEST_F(GrpcWebFilterTest, Base64ConcatenatedPaddedMessages) {
+  request_headers_.addCopy(Http::Headers::get().ContentType,
+                           Http::Headers::get().ContentTypeValues.GrpcWebText);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers_, false));
+
+  // Messages which are encoded separately are padded, and may arrive in the same data.
+  Buffer::OwnedImpl request_buffer;
+  request_buffer.add(&B64_MESSAGE, B64_MESSAGE_SIZE);
+  request_buffer.add(&B64_MESSAGE, B64_MESSAGE_SIZE - 2);
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.decodeData(request_buffer, false));
+  Buffer::OwnedImpl decoded_buffer;
+  decoded_buffer.move(request_buffer);
+
+  request_buffer.add(&B64_MESSAGE[B64_MESSAGE_SIZE - 2], 2);
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.decodeData(request_buffer, true));
+  decoded_buffer.move(request_buffer);
+  EXPECT_EQ(absl::StrCat(absl::string_view(TEXT_MESSAGE, TEXT_MESSAGE_SIZE),
+                         absl::string_view(TEXT_MESSAGE, TEXT_MESSAGE_SIZE)),
+            decoded_buffer.toString());
+}
+
+TEST_F(GrpcWebFilterTest, TextResponseStreamsFrames) {
+  request_headers_.addCopy(Http::Headers::get().ContentType,
+                           Http::Headers::get().ContentTypeValues.GrpcWebText);
+  request_headers_.addCopy(Http::CustomHeaders::get().Accept,
+                           Http::Headers::get().ContentTypeValues.GrpcWebText);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers_, false));
+  Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "200"}, {"content-type", Http::Headers::get().ContentTypeValues.Grpc}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.encodeHeaders(response_headers, false));
+
+  // A large frame followed by a small one. The large frame is encoded as its data comes in,
+  // rather than once it is complete.
+  const std::string large_message(100000, 'a');
+  Buffer::OwnedImpl frames;
+  Grpc::Encoder().prependFrameHeader(Grpc::GRPC_FH_DEFAULT, frames, large_message.size());
+  frames.add(large_message);
+  const std::string large_frame = frames.toString();
+  frames.add(&TEXT_MESSAGE, TEXT_MESSAGE_SIZE);
+
+  std::string encoded;
+  while (frames.length() > 0) {
+    Buffer::OwnedImpl response_buffer;
+    response_buffer.move(frames, 1000);
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.encodeData(response_buffer, false));
+    encoded += response_buffer.toString();
+  }
+  EXPECT_EQ(absl::StrCat(Base64::encode(large_frame.data(), large_frame.size()),
+                         absl::string_view(B64_MESSAGE, B64_MESSAGE_SIZE)),
+            encoded);
+}
+
 TEST_F(GrpcWebFilterTest, InvalidUpstreamResponseForText) {
   Http::TestRequestHeaderMapImpl request_headers{
       {"content-type", Http::Headers::get().ContentTypeValues.GrpcWebText}, {":path", "/"}};
@@ -584,11 +636,13 @@ TEST_P(GrpcWebFilterTest, Unary) {
     Buffer::OwnedImpl encoded_buffer;
     for (size_t i = 0; i < TEXT_MESSAGE_SIZE; i++) {
       response_buffer.add(&TEXT_MESSAGE[i], 1);
-      if (i < TEXT_MESSAGE_SIZE - 1) {
+      // The frame is encoded as it streams in, a whole base64 block at a time, and padded at its
+      // end.
+      if (i % 3 == 2 || i == TEXT_MESSAGE_SIZE - 1) {
+        EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.encodeData(response_buffer, false));
+      } else {
         EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer,
                   filter_.encodeData(response_buffer, false));
-      } else {
-        EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.encodeData(response_buffer, false));
       }
       encoded_buffer.move(response_buffer);
     }
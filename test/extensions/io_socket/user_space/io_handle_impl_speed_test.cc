@@ -0,0 +1,102 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <memory>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/io_socket/user_space/io_handle_impl.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace IoSocket {
+namespace UserSpace {
+
+namespace {
+
+// A chain of internal connections, as used when tunneling HTTP through several internal
+// listeners. Each hop writes into one handle of a pair and reads from the peer handle, like a TCP
+// proxy reading a downstream internal connection and writing an upstream one.
+class InternalChain {
+public:
+  InternalChain(uint64_t hops, bool zero_copy) : buffers_(hops + 1) {
+    for (uint64_t i = 0; i < hops; i++) {
+      handles_.push_back(IoHandleFactory::createBufferLimitedIoHandlePair(1024 * 1024, zero_copy));
+    }
+  }
+
+  // Moves all the data of the first buffer through the chain into the last buffer.
+  void transfer() {
+    for (size_t i = 0; i < handles_.size(); i++) {
+      Buffer::Instance& src = buffers_[i];
+      Buffer::Instance& dst = buffers_[i + 1];
+      while (src.length() > 0) {
+        handles_[i].first->write(src);
+        while (handles_[i].second->read(dst, absl::nullopt).return_value_ > 0) {
+        }
+      }
+    }
+  }
+
+  Buffer::OwnedImpl& source() { return buffers_.front(); }
+  Buffer::OwnedImpl& sink() { return buffers_.back(); }
+
+private:
+  std::vector<std::pair<IoHandleImplPtr, IoHandleImplPtr>> handles_;
+  std::vector<Buffer::OwnedImpl> buffers_;
+};
+
+// Adds a request of the given body size to the buffer, made of a header block and body chunks
+// of 16KiB, as an HTTP/1 codec would produce them.
+void addRequest(Buffer::Instance& buffer, uint64_t body_size) {
+  buffer.add("POST /tunnel HTTP/1.1\r\nhost: internal\r\ntransfer-encoding: chunked\r\n\r\n");
+  const std::string chunk(16 * 1024, 'a');
+  for (uint64_t i = 0; i < body_size; i += chunk.size()) {
+    buffer.add(chunk.data(), std::min<uint64_t>(chunk.size(), body_size - i));
+  }
+}
+
+} // namespace
+
+// Measures the throughput of a chain of internal connections. The same data is moved through the
+// chain at every iteration.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_InternalChainThroughput(benchmark::State& state) {
+  const uint64_t hops = state.range(0);
+  const bool zero_copy = state.range(1) != 0;
+  const uint64_t body_size = 4 * 1024 * 1024;
+  InternalChain chain(hops, zero_copy);
+  addRequest(chain.source(), body_size);
+
+  uint64_t bytes = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    chain.transfer();
+    bytes += chain.sink().length();
+    chain.source().move(chain.sink());
+  }
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_InternalChainThroughput)->ArgsProduct({{1, 3}, {0, 1}});
+
+// Measures the time for a small request to cross a chain of internal connections, excluding the
+// event loop.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_InternalChainLatency(benchmark::State& state) {
+  const uint64_t hops = state.range(0);
+  const bool zero_copy = state.range(1) != 0;
+  InternalChain chain(hops, zero_copy);
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    addRequest(chain.source(), 1024);
+    chain.transfer();
+    chain.sink().drain(chain.sink().length());
+  }
+}
+BENCHMARK(BM_InternalChainLatency)->ArgsProduct({{1, 3}, {0, 1}});
+
+} // namespace UserSpace
+} // namespace IoSocket
+} // namespace Extensions
+} // namespace Envoy
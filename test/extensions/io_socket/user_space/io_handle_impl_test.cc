@@ -3,16 +3,19 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/network/address_impl.h"
+#include "source/common/network/raw_buffer_socket.h"
 #include "source/common/stream_info/filter_state_impl.h"
 #include "source/extensions/io_socket/user_space/io_handle_impl.h"
 
 #include "test/mocks/event/mocks.h"
+#include "test/mocks/network/mocks.h"
 
 #include "absl/container/fixed_array.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 using testing::NiceMock;
+using testing::ReturnRef;
 
 namespace Envoy {
 namespace Extensions {
@@ -508,6 +511,99 @@ TEST_F(IoHandleImplTest, PartialWrite) {
   }
 }
 
+TEST_F(IoHandleImplTest, ZeroCopyPartialWrite) {
+  io_handle_->setZeroCopy(true);
+  io_handle_peer_->setWatermarks(15000);
+
+  int released = 0;
+  std::vector<const void*> fragment_data;
+  // Immutable fragments are neither copied nor coalesced by the buffer.
+  Buffer::OwnedImpl pending_data;
+  for (int i = 0; i < 3; i++) {
+    auto fragment = Buffer::OwnedBufferFragmentImpl::create(
+        std::string(10000, 'a'), [&released](const Buffer::OwnedBufferFragmentImpl* fragment) {
+          released++;
+          delete fragment;
+        });
+    fragment_data.push_back(fragment->data());
+    pending_data.addBufferFragment(*fragment.release());
+  }
+
+  {
+    // Moving the second fragment would exceed the 16K limit of a write, so only the first
+    // fragment is moved instead of copying a part of the second one.
+    auto result = io_handle_->write(pending_data);
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(10000, result.return_value_);
+    EXPECT_EQ(20000, pending_data.length());
+    EXPECT_TRUE(io_handle_peer_->isWritable());
+    EXPECT_EQ(fragment_data[0], io_handle_peer_->getWriteBuffer()->frontSlice().mem_);
+  }
+  {
+    // The first slice is always moved, even if it exceeds the high watermark.
+    auto result = io_handle_->write(pending_data);
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(10000, result.return_value_);
+    EXPECT_EQ(10000, pending_data.length());
+    EXPECT_FALSE(io_handle_peer_->isWritable());
+  }
+  {
+    auto result = io_handle_->write(pending_data);
+    ASSERT_EQ(result.err_->getErrorCode(), Api::IoError::IoErrorCode::Again);
+  }
+
+  Buffer::OwnedImpl read_buffer;
+  io_handle_peer_->read(read_buffer, absl::nullopt);
+  EXPECT_EQ(20000, read_buffer.length());
+  EXPECT_EQ(0, released);
+  read_buffer.drain(read_buffer.length());
+  EXPECT_EQ(2, released);
+}
+
+// Internal connections read through a raw buffer socket, whose reads must not be capped by the
+// adaptive read size, so that the written fragments are moved rather than split and copied.
+TEST_F(IoHandleImplTest, ZeroCopyReadThroughRawBufferSocket) {
+  io_handle_->setZeroCopy(true);
+  io_handle_peer_->setZeroCopy(true);
+  EXPECT_FALSE(io_handle_peer_->supportsAdaptiveReadSize());
+
+  int released = 0;
+  std::vector<const void*> fragment_data;
+  for (int i = 0; i < 3; i++) {
+    auto fragment = Buffer::OwnedBufferFragmentImpl::create(
+        std::string(10000, 'a'), [&released](const Buffer::OwnedBufferFragmentImpl* fragment) {
+          released++;
+          delete fragment;
+        });
+    fragment_data.push_back(fragment->data());
+    Buffer::OwnedImpl pending_data;
+    pending_data.addBufferFragment(*fragment.release());
+    auto result = io_handle_->write(pending_data);
+    EXPECT_EQ(10000, result.return_value_);
+  }
+
+  NiceMock<Network::MockTransportSocketCallbacks> callbacks;
+  ON_CALL(callbacks, ioHandle()).WillByDefault(ReturnRef(*io_handle_peer_));
+  Network::RawBufferSocket socket;
+  socket.setTransportSocketCallbacks(callbacks);
+
+  Buffer::OwnedImpl read_buffer;
+  Network::IoResult result = socket.doRead(read_buffer);
+  EXPECT_EQ(Network::PostIoAction::KeepOpen, result.action_);
+  EXPECT_EQ(30000, result.bytes_processed_);
+  EXPECT_FALSE(result.end_stream_read_);
+
+  auto slices = read_buffer.getRawSlices();
+  ASSERT_EQ(3, slices.size());
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(fragment_data[i], slices[i].mem_);
+    EXPECT_EQ(10000, slices[i].len_);
+  }
+  EXPECT_EQ(0, released);
+  read_buffer.drain(read_buffer.length());
+  EXPECT_EQ(3, released);
+}
+
 TEST_F(IoHandleImplTest, WriteErrorAfterShutdown) {
   Buffer::OwnedImpl buf("0123456789");
   // Write after shutdown.
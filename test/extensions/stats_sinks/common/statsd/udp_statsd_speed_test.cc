@@ -0,0 +1,104 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/extensions/stat_sinks/common/statsd/statsd.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/stats/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace Common {
+namespace Statsd {
+
+namespace {
+
+// Counts the datagrams instead of sending them.
+class NullWriter : public UdpStatsdSink::Writer {
+public:
+  void write(const std::string& message) override {
+    ++datagrams_;
+    bytes_ += message.size();
+  }
+  void writeBuffer(Buffer::Instance& data) override {
+    ++datagrams_;
+    bytes_ += data.length();
+  }
+
+  uint64_t datagrams_{0};
+  uint64_t bytes_{0};
+};
+
+class FlushFixture {
+public:
+  // Creates a snapshot of num_stats counters and num_stats gauges, of which only one in a hundred
+  // changes between flushes.
+  explicit FlushFixture(uint64_t num_stats) {
+    for (uint64_t i = 0; i < num_stats; i++) {
+      Stats::Counter& counter = store_.counter(absl::StrCat("cluster.c", i, ".upstream_rq"));
+      counter.inc();
+      snapshot_.counters_.push_back({i % 100 == 0 ? 1UL : 0UL, counter});
+
+      Stats::Gauge& gauge = store_.gauge(absl::StrCat("cluster.c", i, ".membership_total"),
+                                         Stats::Gauge::ImportMode::Accumulate);
+      gauge.set(i);
+      snapshot_.gauges_.push_back(gauge);
+      gauges_.push_back(&gauge);
+    }
+  }
+
+  void updateGauges() {
+    for (size_t i = 0; i < gauges_.size(); i += 100) {
+      gauges_[i]->inc();
+    }
+  }
+
+  Stats::TestUtil::TestStore store_;
+  NiceMock<Stats::MockMetricSnapshot> snapshot_;
+  std::vector<Stats::Gauge*> gauges_;
+};
+
+} // namespace
+
+// Measures the time to flush a snapshot into datagrams of at most 1432 bytes, sending either all
+// the stats or only the changed ones.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_UdpStatsdFlush(benchmark::State& state) {
+  const uint64_t num_stats = state.range(0);
+  const bool changed_only = state.range(1) != 0;
+  FlushFixture fixture(num_stats);
+  NiceMock<ThreadLocal::MockInstance> tls;
+  auto writer = std::make_shared<NullWriter>();
+  UdpStatsdSink sink(tls, writer, false, getDefaultPrefix(), 1432, getDefaultTagFormat(),
+                     changed_only);
+  // Prime the last flushed gauge values.
+  sink.flush(fixture.snapshot_);
+  writer->datagrams_ = 0;
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    fixture.updateGauges();
+    state.ResumeTiming();
+
+    sink.flush(fixture.snapshot_);
+  }
+  state.counters["datagrams_per_flush"] =
+      benchmark::Counter(writer->datagrams_, benchmark::Counter::kAvgIterations);
+  tls.shutdownThread();
+}
+BENCHMARK(BM_UdpStatsdFlush)
+    ->ArgsProduct({{10000, 1000000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace Statsd
+} // namespace Common
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
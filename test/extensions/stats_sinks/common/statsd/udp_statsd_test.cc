@@ -355,6 +355,55 @@ TEST(UdpStatsdSinkTest, CheckBufferedWritesExceedingBufferSize) {
   tls_.shutdownThread();
 }
 
+TEST(UdpStatsdSinkTest, ExportChangedMetricsOnly) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  writer_ptr->delegateBufferFake();
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  UdpStatsdSink sink(tls_, writer_ptr, false, getDefaultPrefix(), 1024, getDefaultTagFormat(),
+                     true);
+
+  NiceMock<Stats::MockCounter> counter_1;
+  counter_1.name_ = "test_counter_1";
+  counter_1.used_ = true;
+  snapshot.counters_.push_back({1, counter_1});
+
+  NiceMock<Stats::MockCounter> counter_2;
+  counter_2.name_ = "test_counter_2";
+  counter_2.used_ = true;
+  snapshot.counters_.push_back({0, counter_2});
+
+  NiceMock<Stats::MockGauge> gauge;
+  gauge.name_ = "test_gauge";
+  gauge.value_ = 1;
+  gauge.used_ = true;
+  snapshot.gauges_.push_back(gauge);
+
+  Stats::PrimitiveGauge host_gauge;
+  host_gauge.add(2);
+  Stats::PrimitiveGaugeSnapshot host_gauge_snapshot(host_gauge);
+  host_gauge_snapshot.setName("test_host_gauge");
+  snapshot.host_gauges_.push_back(host_gauge_snapshot);
+
+  // Counters without a delta are skipped, and all gauges are flushed the first time.
+  sink.flush(snapshot);
+  ASSERT_EQ(writer_ptr->buffer_writes.size(), 1);
+  EXPECT_EQ(writer_ptr->buffer_writes.at(0),
+            "envoy.test_counter_1:1|c\nenvoy.test_gauge:1|g\nenvoy.test_host_gauge:2|g");
+
+  // Gauges are skipped until their value changes.
+  sink.flush(snapshot);
+  ASSERT_EQ(writer_ptr->buffer_writes.size(), 2);
+  EXPECT_EQ(writer_ptr->buffer_writes.at(1), "envoy.test_counter_1:1|c");
+
+  gauge.value_ = 3;
+  sink.flush(snapshot);
+  ASSERT_EQ(writer_ptr->buffer_writes.size(), 3);
+  EXPECT_EQ(writer_ptr->buffer_writes.at(2), "envoy.test_counter_1:1|c\nenvoy.test_gauge:3|g");
+
+  tls_.shutdownThread();
+}
+
 TEST(UdpStatsdSinkTest, CheckActualStatsWithCustomPrefix) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
@@ -3,7 +3,9 @@
 #include "source/common/tracing/null_span_impl.h"
 #include "source/extensions/stat_sinks/open_telemetry/open_telemetry_impl.h"
 
+#include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/grpc/mocks.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/test_common/simulated_time_system.h"
@@ -136,6 +138,7 @@ public:
     snapshot_.histograms_.push_back(*histogram_storage_.back());
   }
 
+  Stats::TestUtil::TestStore stats_store_;
   long long int expected_time_ns_;
   std::vector<histogram_t*> histogram_ptrs_;
   std::vector<std::unique_ptr<Stats::HistogramStatisticsImpl>> hist_stats_;
@@ -254,7 +257,7 @@ public:
 };
 
 TEST_F(OtlpMetricsFlusherTests, MetricsWithDefaultOptions) {
-  OtlpMetricsFlusherImpl flusher(otlpOptions());
+  OtlpMetricsFlusherImpl flusher(otlpOptions(), *stats_store_.rootScope());
 
   addCounterToSnapshot("test_counter", 1, 1);
   addHostCounterToSnapshot("test_host_counter", 2, 3);
@@ -301,7 +304,8 @@ TEST_F(OtlpMetricsFlusherTests, MetricsWithDefaultOptions) {
 }
 
 TEST_F(OtlpMetricsFlusherTests, MetricsWithStatsPrefix) {
-  OtlpMetricsFlusherImpl flusher(otlpOptions(false, false, true, true, "prefix"));
+  OtlpMetricsFlusherImpl flusher(otlpOptions(false, false, true, true, "prefix"),
+                                 *stats_store_.rootScope());
 
   addCounterToSnapshot("test_counter", 1, 1);
   addHostCounterToSnapshot("test_host_counter", 1, 1);
@@ -319,7 +323,7 @@ TEST_F(OtlpMetricsFlusherTests, MetricsWithStatsPrefix) {
 }
 
 TEST_F(OtlpMetricsFlusherTests, MetricsWithNoTaggedName) {
-  OtlpMetricsFlusherImpl flusher(otlpOptions(false, false, true, false));
+  OtlpMetricsFlusherImpl flusher(otlpOptions(false, false, true, false), *stats_store_.rootScope());
 
   addCounterToSnapshot("test_counter", 1, 1);
   addGaugeToSnapshot("test_gauge", 1);
@@ -333,7 +337,7 @@ TEST_F(OtlpMetricsFlusherTests, MetricsWithNoTaggedName) {
 }
 
 TEST_F(OtlpMetricsFlusherTests, MetricsWithNoAttributes) {
-  OtlpMetricsFlusherImpl flusher(otlpOptions(false, false, false, true));
+  OtlpMetricsFlusherImpl flusher(otlpOptions(false, false, false, true), *stats_store_.rootScope());
 
   addCounterToSnapshot("test_counter", 1, 1);
   addGaugeToSnapshot("test_gauge", 1);
@@ -362,7 +366,7 @@ TEST_F(OtlpMetricsFlusherTests, MetricsWithNoAttributes) {
 }
 
 TEST_F(OtlpMetricsFlusherTests, GaugeMetric) {
-  OtlpMetricsFlusherImpl flusher(otlpOptions());
+  OtlpMetricsFlusherImpl flusher(otlpOptions(), *stats_store_.rootScope());
 
   addGaugeToSnapshot("test_gauge1", 1);
   addGaugeToSnapshot("test_gauge2", 2);
@@ -378,7 +382,7 @@ TEST_F(OtlpMetricsFlusherTests, GaugeMetric) {
 }
 
 TEST_F(OtlpMetricsFlusherTests, CumulativeCounterMetric) {
-  OtlpMetricsFlusherImpl flusher(otlpOptions());
+  OtlpMetricsFlusherImpl flusher(otlpOptions(), *stats_store_.rootScope());
 
   addCounterToSnapshot("test_counter1", 1, 1);
   addCounterToSnapshot("test_counter2", 2, 3);
@@ -394,7 +398,7 @@ TEST_F(OtlpMetricsFlusherTests, CumulativeCounterMetric) {
 }
 
 TEST_F(OtlpMetricsFlusherTests, DeltaCounterMetric) {
-  OtlpMetricsFlusherImpl flusher(otlpOptions(true, false, true, true));
+  OtlpMetricsFlusherImpl flusher(otlpOptions(true, false, true, true), *stats_store_.rootScope());
 
   addCounterToSnapshot("test_counter1", 1, 1);
   addCounterToSnapshot("test_counter2", 2, 3);
@@ -410,7 +414,7 @@ TEST_F(OtlpMetricsFlusherTests, DeltaCounterMetric) {
 }
 
 TEST_F(OtlpMetricsFlusherTests, CumulativeHistogramMetric) {
-  OtlpMetricsFlusherImpl flusher(otlpOptions());
+  OtlpMetricsFlusherImpl flusher(otlpOptions(), *stats_store_.rootScope());
 
   addHistogramToSnapshot("test_histogram1");
   addHistogramToSnapshot("test_histogram2");
@@ -422,7 +426,7 @@ TEST_F(OtlpMetricsFlusherTests, CumulativeHistogramMetric) {
 }
 
 TEST_F(OtlpMetricsFlusherTests, DeltaHistogramMetric) {
-  OtlpMetricsFlusherImpl flusher(otlpOptions(false, true, true, true));
+  OtlpMetricsFlusherImpl flusher(otlpOptions(false, true, true, true), *stats_store_.rootScope());
 
   addHistogramToSnapshot("test_histogram1", true);
   addHistogramToSnapshot("test_histogram2", true);
@@ -433,6 +437,101 @@ TEST_F(OtlpMetricsFlusherTests, DeltaHistogramMetric) {
   expectHistogram(metricAt(1, metrics), getTagExtractedName("test_histogram2"), true);
 }
 
+TEST_F(OtlpMetricsFlusherTests, ExportChangedMetricsOnly) {
+  envoy::extensions::stat_sinks::open_telemetry::v3::SinkConfig sink_config;
+  sink_config.set_export_changed_metrics_only(true);
+  OtlpMetricsFlusherImpl flusher(std::make_shared<OtlpOptions>(sink_config),
+                                 *stats_store_.rootScope());
+
+  Stats::Gauge& gauge1 = stats_store_.gauge("test_gauge1", Stats::Gauge::ImportMode::Accumulate);
+  Stats::Gauge& gauge2 = stats_store_.gauge("test_gauge2", Stats::Gauge::ImportMode::Accumulate);
+  gauge1.set(1);
+  gauge2.set(2);
+  snapshot_.gauges_.push_back(gauge1);
+  snapshot_.gauges_.push_back(gauge2);
+  addHostGaugeToSnapshot("test_host_gauge", 3);
+  addCounterToSnapshot("test_counter1", 0, 5);
+  addCounterToSnapshot("test_counter2", 1, 6);
+  addHostCounterToSnapshot("test_host_counter", 0, 3);
+  addHistogramToSnapshot("test_histogram1", true);
+  addHistogramToSnapshot("test_histogram2");
+
+  // All gauges are new, while only one counter and one histogram have changed.
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 5);
+  expectGauge(metricAt(0, metrics), "test_gauge1", 1);
+  expectGauge(metricAt(1, metrics), "test_gauge2", 2);
+  expectGauge(metricAt(2, metrics), getTagExtractedName("test_host_gauge"), 3);
+  expectSum(metricAt(3, metrics), getTagExtractedName("test_counter2"), 6, false);
+  EXPECT_EQ(getTagExtractedName("test_histogram1"), metricAt(4, metrics).name());
+
+  // Gauges are skipped until their value changes.
+  gauge2.set(7);
+  metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 3);
+  expectGauge(metricAt(0, metrics), "test_gauge2", 7);
+  expectSum(metricAt(1, metrics), getTagExtractedName("test_counter2"), 6, false);
+  EXPECT_EQ(getTagExtractedName("test_histogram1"), metricAt(2, metrics).name());
+
+  // A gauge which returns to its previous value is exported again.
+  gauge2.set(2);
+  metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 3);
+  expectGauge(metricAt(0, metrics), "test_gauge2", 2);
+}
+
+TEST_F(OtlpMetricsFlusherTests, MaxDataPointsPerMetric) {
+  envoy::extensions::stat_sinks::open_telemetry::v3::SinkConfig sink_config;
+  sink_config.mutable_max_data_points_per_metric()->set_value(2);
+  OtlpMetricsFlusherImpl flusher(std::make_shared<OtlpOptions>(sink_config),
+                                 *stats_store_.rootScope());
+
+  // All the counters share the same tag extracted name.
+  addCounterToSnapshot("test_counter", 1, 1);
+  addCounterToSnapshot("test_counter", 1, 2);
+  addCounterToSnapshot("test_counter", 1, 3);
+  addHostCounterToSnapshot("test_counter", 1, 4);
+  addGaugeToSnapshot("test_gauge", 1);
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 3);
+  expectGauge(metricAt(0, metrics), getTagExtractedName("test_gauge"), 1);
+  expectSum(metricAt(1, metrics), getTagExtractedName("test_counter"), 1, false);
+  expectSum(metricAt(2, metrics), getTagExtractedName("test_counter"), 2, false);
+  EXPECT_EQ(2, stats_store_.counter("open_telemetry_sink.cardinality_limited").value());
+
+  // The limit applies to each flush separately.
+  metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 3);
+  EXPECT_EQ(4, stats_store_.counter("open_telemetry_sink.cardinality_limited").value());
+}
+
+TEST_F(OtlpMetricsFlusherTests, ExportChangedMetricsOnlyWithMaxDataPointsPerMetric) {
+  envoy::extensions::stat_sinks::open_telemetry::v3::SinkConfig sink_config;
+  sink_config.set_export_changed_metrics_only(true);
+  sink_config.mutable_max_data_points_per_metric()->set_value(1);
+  OtlpMetricsFlusherImpl flusher(std::make_shared<OtlpOptions>(sink_config),
+                                 *stats_store_.rootScope());
+
+  // Both gauges share the same tag extracted name.
+  addGaugeToSnapshot("test_gauge", 1);
+  addHostGaugeToSnapshot("test_gauge", 2);
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 1);
+  expectGauge(metricAt(0, metrics), getTagExtractedName("test_gauge"), 1);
+  EXPECT_EQ(1, stats_store_.counter("open_telemetry_sink.cardinality_limited").value());
+
+  // The gauge dropped by the limit was not exported, so it is not skipped as unchanged.
+  metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 1);
+  expectGauge(metricAt(0, metrics), getTagExtractedName("test_gauge"), 2);
+  EXPECT_EQ(1, stats_store_.counter("open_telemetry_sink.cardinality_limited").value());
+
+  metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 0);
+}
+
 class MockOpenTelemetryGrpcMetricsExporter : public OpenTelemetryGrpcMetricsExporter {
 public:
   MOCK_METHOD(void, send, (MetricsExportRequestPtr &&));
@@ -442,7 +541,7 @@ public:
 
 class MockOtlpMetricsFlusher : public OtlpMetricsFlusher {
 public:
-  MOCK_METHOD(MetricsExportRequestPtr, flush, (Stats::MetricSnapshot&), (const));
+  MOCK_METHOD(MetricsExportRequestPtr, flush, (Stats::MetricSnapshot&));
 };
 
 class OpenTelemetryGrpcSinkTests : public OpenTelemetryStatsSinkTests {
@@ -451,8 +550,31 @@ public:
       : flusher_(std::make_shared<MockOtlpMetricsFlusher>()),
         exporter_(std::make_shared<MockOpenTelemetryGrpcMetricsExporter>()) {}
 
+  MetricsExportRequestPtr requestWithGauges(int count) {
+    auto request = std::make_unique<MetricsExportRequest>();
+    auto* scope_metrics = request->add_resource_metrics()->add_scope_metrics();
+    for (int i = 0; i < count; i++) {
+      auto* metric = scope_metrics->add_metrics();
+      metric->set_name(absl::StrCat("gauge", i));
+      metric->mutable_gauge()->add_data_points()->set_as_int(i);
+    }
+    return request;
+  }
+
+  void expectRequestWithGauges(const MetricsExportRequest& request,
+                               const std::vector<std::string>& names) {
+    ASSERT_EQ(1, request.resource_metrics().size());
+    ASSERT_EQ(1, request.resource_metrics()[0].scope_metrics().size());
+    const auto& metrics = request.resource_metrics()[0].scope_metrics()[0].metrics();
+    ASSERT_EQ(static_cast<int>(names.size()), metrics.size());
+    for (size_t i = 0; i < names.size(); i++) {
+      EXPECT_EQ(names[i], metrics[i].name());
+    }
+  }
+
   const std::shared_ptr<MockOtlpMetricsFlusher> flusher_;
   const std::shared_ptr<MockOpenTelemetryGrpcMetricsExporter> exporter_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
 };
 
 TEST_F(OpenTelemetryGrpcSinkTests, BasicFlow) {
@@ -464,6 +586,80 @@ TEST_F(OpenTelemetryGrpcSinkTests, BasicFlow) {
   sink.flush(snapshot_);
 }
 
+TEST_F(OpenTelemetryGrpcSinkTests, MaxDataPointsPerRequest) {
+  auto* send_pending_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
+  OpenTelemetryGrpcSink sink(flusher_, exporter_, dispatcher_, *stats_store_.rootScope(), 2);
+
+  EXPECT_CALL(*flusher_, flush(_)).WillOnce(Return(ByMove(requestWithGauges(5))));
+  std::vector<MetricsExportRequestPtr> requests;
+  EXPECT_CALL(*exporter_, send(_)).WillRepeatedly([&requests](MetricsExportRequestPtr&& request) {
+    requests.push_back(std::move(request));
+  });
+
+  // The first request is sent right away, the rest on the next event loop iterations.
+  EXPECT_CALL(*send_pending_cb, scheduleCallbackNextIteration());
+  sink.flush(snapshot_);
+  ASSERT_EQ(1, requests.size());
+  expectRequestWithGauges(*requests[0], {"gauge0", "gauge1"});
+
+  EXPECT_CALL(*send_pending_cb, scheduleCallbackNextIteration());
+  send_pending_cb->invokeCallback();
+  ASSERT_EQ(2, requests.size());
+  expectRequestWithGauges(*requests[1], {"gauge2", "gauge3"});
+
+  EXPECT_CALL(*send_pending_cb, scheduleCallbackNextIteration()).Times(0);
+  send_pending_cb->invokeCallback();
+  ASSERT_EQ(3, requests.size());
+  expectRequestWithGauges(*requests[2], {"gauge4"});
+}
+
+TEST_F(OpenTelemetryGrpcSinkTests, MaxPendingRequests) {
+  auto* send_pending_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
+  OpenTelemetryGrpcSink sink(flusher_, exporter_, dispatcher_, *stats_store_.rootScope(), 1, 2);
+
+  std::vector<MetricsExportRequestPtr> requests;
+  EXPECT_CALL(*exporter_, send(_)).WillRepeatedly([&requests](MetricsExportRequestPtr&& request) {
+    requests.push_back(std::move(request));
+  });
+
+  // The first request is sent right away, two wait to be sent and the last one is dropped.
+  EXPECT_CALL(*flusher_, flush(_)).WillOnce(Return(ByMove(requestWithGauges(4))));
+  sink.flush(snapshot_);
+  ASSERT_EQ(1, requests.size());
+  EXPECT_EQ(1, stats_store_.counter("open_telemetry_sink.requests_dropped").value());
+
+  // The requests of the next flush are dropped while the previous ones are pending.
+  EXPECT_CALL(*flusher_, flush(_)).WillOnce(Return(ByMove(requestWithGauges(2))));
+  sink.flush(snapshot_);
+  ASSERT_EQ(2, requests.size());
+  EXPECT_EQ(2, stats_store_.counter("open_telemetry_sink.requests_dropped").value());
+
+  send_pending_cb->invokeCallback();
+  send_pending_cb->invokeCallback();
+  ASSERT_EQ(4, requests.size());
+  expectRequestWithGauges(*requests[0], {"gauge0"});
+  expectRequestWithGauges(*requests[1], {"gauge0"});
+  expectRequestWithGauges(*requests[2], {"gauge1"});
+  expectRequestWithGauges(*requests[3], {"gauge2"});
+
+  // Once the pending requests are sent, the requests of a flush wait to be sent again.
+  EXPECT_CALL(*flusher_, flush(_)).WillOnce(Return(ByMove(requestWithGauges(2))));
+  sink.flush(snapshot_);
+  send_pending_cb->invokeCallback();
+  ASSERT_EQ(6, requests.size());
+  EXPECT_EQ(2, stats_store_.counter("open_telemetry_sink.requests_dropped").value());
+}
+
+TEST_F(OpenTelemetryGrpcSinkTests, MaxDataPointsPerRequestEmptyRequest) {
+  auto* send_pending_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
+  OpenTelemetryGrpcSink sink(flusher_, exporter_, dispatcher_, *stats_store_.rootScope(), 2);
+
+  EXPECT_CALL(*flusher_, flush(_)).WillOnce(Return(ByMove(requestWithGauges(0))));
+  EXPECT_CALL(*exporter_, send(_));
+  EXPECT_CALL(*send_pending_cb, scheduleCallbackNextIteration()).Times(0);
+  sink.flush(snapshot_);
+}
+
 } // namespace
 } // namespace OpenTelemetry
 } // namespace StatSinks
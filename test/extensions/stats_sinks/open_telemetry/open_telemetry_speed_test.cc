@@ -0,0 +1,87 @@
+#include "source/extensions/stat_sinks/open_telemetry/open_telemetry_impl.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/stats/mocks.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace StatSinks {
+namespace OpenTelemetry {
+
+namespace {
+
+class FlushFixture {
+public:
+  // Creates a snapshot of num_stats counters and num_stats gauges, of which only one in a hundred
+  // changes between flushes.
+  explicit FlushFixture(uint64_t num_stats) {
+    ON_CALL(snapshot_, snapshotTime()).WillByDefault(Return(SystemTime()));
+    for (uint64_t i = 0; i < num_stats; i++) {
+      Stats::Counter& counter = store_.counter(absl::StrCat("cluster.c", i, ".upstream_rq"));
+      counter.inc();
+      snapshot_.counters_.push_back({i % 100 == 0 ? 1UL : 0UL, counter});
+
+      Stats::Gauge& gauge = store_.gauge(absl::StrCat("cluster.c", i, ".membership_total"),
+                                         Stats::Gauge::ImportMode::Accumulate);
+      gauge.set(i);
+      snapshot_.gauges_.push_back(gauge);
+      gauges_.push_back(&gauge);
+    }
+  }
+
+  // Changes one in a hundred gauges, so that the changed-only export has something to send.
+  void updateGauges() {
+    for (size_t i = 0; i < gauges_.size(); i += 100) {
+      gauges_[i]->inc();
+    }
+  }
+
+  Stats::TestUtil::TestStore store_;
+  NiceMock<Stats::MockMetricSnapshot> snapshot_;
+  std::vector<Stats::Gauge*> gauges_;
+};
+
+} // namespace
+
+// Measures the cost of converting a snapshot into an export request, exporting either all the
+// metrics or only the changed ones.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_OtlpMetricsFlush(benchmark::State& state) {
+  const uint64_t num_stats = state.range(0);
+  const bool changed_only = state.range(1) != 0;
+  FlushFixture fixture(num_stats);
+
+  envoy::extensions::stat_sinks::open_telemetry::v3::SinkConfig sink_config;
+  sink_config.set_export_changed_metrics_only(changed_only);
+  OtlpMetricsFlusherImpl flusher(std::make_shared<OtlpOptions>(sink_config),
+                                 *fixture.store_.rootScope());
+  // Prime the last exported gauge values.
+  flusher.flush(fixture.snapshot_);
+
+  size_t exported_metrics = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    fixture.updateGauges();
+    state.ResumeTiming();
+
+    MetricsExportRequestPtr request = flusher.flush(fixture.snapshot_);
+    exported_metrics += request->resource_metrics(0).scope_metrics(0).metrics_size();
+  }
+  benchmark::DoNotOptimize(exported_metrics);
+  state.counters["exported_metrics_per_flush"] =
+      benchmark::Counter(exported_metrics, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_OtlpMetricsFlush)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace OpenTelemetry
+} // namespace StatSinks
+} // namespace Extensions
+} // namespace Envoy
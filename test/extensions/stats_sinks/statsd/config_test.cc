@@ -109,6 +109,36 @@ TEST_P(StatsConfigParameterizedTest, UdpSinkCustomPrefix) {
   EXPECT_EQ(udp_sink->getPrefix(), customPrefix);
 }
 
+TEST_P(StatsConfigParameterizedTest, UdpSinkBufferSizeAndChangedMetricsOnly) {
+  envoy::config::metrics::v3::StatsdSink sink_config;
+  envoy::config::core::v3::Address& address = *sink_config.mutable_address();
+  envoy::config::core::v3::SocketAddress& socket_address = *address.mutable_socket_address();
+  socket_address.set_protocol(envoy::config::core::v3::SocketAddress::UDP);
+  if (GetParam() == Network::Address::IpVersion::v4) {
+    socket_address.set_address("127.0.0.1");
+  } else {
+    socket_address.set_address("::1");
+  }
+  socket_address.set_port_value(8125);
+  sink_config.mutable_max_bytes_per_datagram()->set_value(1400);
+  sink_config.set_export_changed_metrics_only(true);
+
+  Server::Configuration::StatsSinkFactory* factory =
+      Registry::FactoryRegistry<Server::Configuration::StatsSinkFactory>::getFactory(StatsdName);
+  ASSERT_NE(factory, nullptr);
+  ProtobufTypes::MessagePtr message = factory->createEmptyConfigProto();
+  TestUtility::jsonConvert(sink_config, *message);
+
+  NiceMock<Server::Configuration::MockServerFactoryContext> server;
+  Stats::SinkPtr sink = factory->createStatsSink(*message, server);
+  ASSERT_NE(sink, nullptr);
+
+  auto udp_sink = dynamic_cast<Common::Statsd::UdpStatsdSink*>(sink.get());
+  ASSERT_NE(udp_sink, nullptr);
+  EXPECT_EQ(udp_sink->getBufferSizeForTest(), 1400);
+  EXPECT_TRUE(udp_sink->getExportChangedMetricsOnlyForTest());
+}
+
 TEST(StatsConfigTest, TcpSinkDefaultPrefix) {
   envoy::config::metrics::v3::StatsdSink sink_config;
   const auto& defaultPrefix = Common::Statsd::getDefaultPrefix();
@@ -0,0 +1,318 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/tracers/opentelemetry/samplers/v3/adaptive_sampler.pb.h"
+
+#include "source/extensions/tracers/opentelemetry/samplers/adaptive/adaptive_sampler.h"
+#include "source/extensions/tracers/opentelemetry/span_context.h"
+#include "source/extensions/tracers/opentelemetry/tracer.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/runtime/mocks.h"
+#include "test/mocks/server/tracer_factory_context.h"
+#include "test/mocks/tracing/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+
+using testing::NiceMock;
+using testing::Return;
+
+class AdaptiveSamplerTest : public testing::Test {
+protected:
+  std::shared_ptr<AdaptiveSampler> createSampler(const std::string& yaml) {
+    envoy::extensions::tracers::opentelemetry::samplers::v3::AdaptiveSamplerConfig config;
+    TestUtility::loadFromYaml(yaml, config);
+    return std::make_shared<AdaptiveSampler>(config, context_);
+  }
+
+  SamplingResult sampleRoot(AdaptiveSampler& sampler) {
+    return sampler.shouldSample(absl::nullopt, "trace_id", "operation_name",
+                                ::opentelemetry::proto::trace::v1::Span::SPAN_KIND_SERVER, {}, {});
+  }
+
+  uint64_t counter(const std::string& name) {
+    return TestUtility::findCounter(context_.server_factory_context_.store_, name)->value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Server::Configuration::MockTracerFactoryContext> context_;
+  NiceMock<Random::MockRandomGenerator>& random_{context_.server_factory_context_.api_.random_};
+};
+
+// Spans with a parent follow the decision of the parent.
+TEST_F(AdaptiveSamplerTest, ParentBased) {
+  auto sampler = createSampler("spans_per_second: 1");
+  EXPECT_EQ(sampler->getDescription(), "AdaptiveSampler");
+  EXPECT_EQ(sampler->maxDeferredSpans(), 0);
+
+  SpanContext sampled_parent("0", "12345", "45678", true, "some_tracestate");
+  auto result = sampler->shouldSample(sampled_parent, "12345", "operation_name",
+                                      ::opentelemetry::proto::trace::v1::Span::SPAN_KIND_CLIENT,
+                                      {}, {});
+  EXPECT_EQ(result.decision, Decision::RecordAndSample);
+  EXPECT_EQ(result.tracestate, "some_tracestate");
+
+  SpanContext unsampled_parent("0", "12345", "45678", false, "");
+  result = sampler->shouldSample(unsampled_parent, "12345", "operation_name",
+                                 ::opentelemetry::proto::trace::v1::Span::SPAN_KIND_CLIENT, {},
+                                 {});
+  EXPECT_EQ(result.decision, Decision::Drop);
+
+  EXPECT_EQ(1U, counter("tracing.opentelemetry.adaptive_sampler.sampled"));
+  EXPECT_EQ(1U, counter("tracing.opentelemetry.adaptive_sampler.not_sampled"));
+}
+
+// Root spans are not sampled once the budget of the window is used up.
+TEST_F(AdaptiveSamplerTest, BudgetExhausted) {
+  auto sampler = createSampler("spans_per_second: 2");
+
+  EXPECT_EQ(sampleRoot(*sampler).decision, Decision::RecordAndSample);
+  EXPECT_EQ(sampleRoot(*sampler).decision, Decision::RecordAndSample);
+  EXPECT_EQ(sampleRoot(*sampler).decision, Decision::Drop);
+  EXPECT_EQ(1U, counter("tracing.opentelemetry.adaptive_sampler.budget_exhausted"));
+
+  // A new window starts with a fresh budget.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0));
+  EXPECT_EQ(sampleRoot(*sampler).decision, Decision::RecordAndSample);
+}
+
+// The root sampling probability follows the observed rate of the previous window.
+TEST_F(AdaptiveSamplerTest, ProbabilityAdjustsToTraffic) {
+  auto sampler = createSampler("spans_per_second: 10");
+
+  for (int i = 0; i < 100; ++i) {
+    sampleRoot(*sampler);
+  }
+  EXPECT_EQ(10U, counter("tracing.opentelemetry.adaptive_sampler.sampled"));
+  EXPECT_DOUBLE_EQ(sampler->rootSamplingProbability(), 1.0);
+
+  // 100 root spans per second are expected, so only every tenth one is sampled.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_CALL(random_, random()).WillOnce(Return(UINT64_MAX));
+  EXPECT_EQ(sampleRoot(*sampler).decision, Decision::Drop);
+  EXPECT_DOUBLE_EQ(sampler->rootSamplingProbability(), 0.1);
+  EXPECT_CALL(random_, random()).WillOnce(Return(UINT64_MAX / 20));
+  EXPECT_EQ(sampleRoot(*sampler).decision, Decision::RecordAndSample);
+
+  // After an idle period the probability goes back up.
+  time_system_.advanceTimeWait(std::chrono::seconds(5));
+  sampleRoot(*sampler);
+  EXPECT_DOUBLE_EQ(sampler->rootSamplingProbability(), 1.0);
+}
+
+// Child spans of sampled root spans count against the budget.
+TEST_F(AdaptiveSamplerTest, ChildSpansCountAgainstBudget) {
+  auto sampler = createSampler("spans_per_second: 10");
+  SpanContext sampled_parent("0", "12345", "45678", true, "");
+
+  for (int i = 0; i < 10; ++i) {
+    if (sampleRoot(*sampler).isSampled()) {
+      sampler->shouldSample(sampled_parent, "12345", "operation_name",
+                            ::opentelemetry::proto::trace::v1::Span::SPAN_KIND_CLIENT, {}, {});
+    }
+  }
+  // 5 root spans with one child each use up the budget.
+  EXPECT_EQ(10U, counter("tracing.opentelemetry.adaptive_sampler.sampled"));
+  EXPECT_EQ(5U, counter("tracing.opentelemetry.adaptive_sampler.budget_exhausted"));
+
+  // 10 root spans per second with two spans each are expected.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0));
+  sampleRoot(*sampler);
+  EXPECT_DOUBLE_EQ(sampler->rootSamplingProbability(), 0.5);
+}
+
+// With tail sampling, spans which are not sampled are recorded.
+TEST_F(AdaptiveSamplerTest, TailSamplingRecordsNotSampledSpans) {
+  auto sampler = createSampler(R"EOF(
+    spans_per_second: 1
+    tail_sampling:
+      latency_threshold: 1s
+      sample_errors: true
+      max_buffered_spans: 5
+  )EOF");
+  EXPECT_EQ(sampler->maxDeferredSpans(), 5);
+
+  EXPECT_EQ(sampleRoot(*sampler).decision, Decision::RecordAndSample);
+  EXPECT_EQ(sampleRoot(*sampler).decision, Decision::RecordOnly);
+  SpanContext unsampled_parent("0", "12345", "45678", false, "");
+  EXPECT_EQ(sampler
+                ->shouldSample(unsampled_parent, "12345", "operation_name",
+                               ::opentelemetry::proto::trace::v1::Span::SPAN_KIND_CLIENT, {}, {})
+                .decision,
+            Decision::RecordOnly);
+  EXPECT_EQ(2U, counter("tracing.opentelemetry.adaptive_sampler.deferred"));
+}
+
+// The deferred decision keeps slow and failed requests.
+TEST_F(AdaptiveSamplerTest, ShouldSampleOnEnd) {
+  auto sampler = createSampler(R"EOF(
+    spans_per_second: 1
+    tail_sampling:
+      latency_threshold: 1s
+      sample_errors: true
+  )EOF");
+
+  ::opentelemetry::proto::trace::v1::Span span;
+  span.set_start_time_unix_nano(1000000000);
+  span.set_end_time_unix_nano(1500000000);
+  EXPECT_FALSE(sampler->shouldSampleOnEnd(span));
+
+  span.set_end_time_unix_nano(2000000000);
+  EXPECT_TRUE(sampler->shouldSampleOnEnd(span));
+
+  span.set_end_time_unix_nano(1500000000);
+  span.mutable_status()->set_code(::opentelemetry::proto::trace::v1::Status::STATUS_CODE_ERROR);
+  EXPECT_TRUE(sampler->shouldSampleOnEnd(span));
+
+  span.clear_status();
+  auto* attribute = span.add_attributes();
+  attribute->set_key("error");
+  attribute->mutable_value()->set_string_value("true");
+  EXPECT_TRUE(sampler->shouldSampleOnEnd(span));
+}
+
+// Errors are ignored unless sample_errors is set.
+TEST_F(AdaptiveSamplerTest, ShouldSampleOnEndIgnoresErrors) {
+  auto sampler = createSampler(R"EOF(
+    spans_per_second: 1
+    tail_sampling: {}
+  )EOF");
+
+  ::opentelemetry::proto::trace::v1::Span span;
+  span.set_start_time_unix_nano(0);
+  span.set_end_time_unix_nano(100000000000);
+  span.mutable_status()->set_code(::opentelemetry::proto::trace::v1::Status::STATUS_CODE_ERROR);
+  EXPECT_FALSE(sampler->shouldSampleOnEnd(span));
+}
+
+class AdaptiveSamplerTracerTest : public AdaptiveSamplerTest {
+protected:
+  void createTracer(const std::string& yaml) {
+    sampler_ = createSampler(yaml);
+    tracer_ = std::make_unique<Tracer>(
+        nullptr, time_system_, random_, runtime_, dispatcher_,
+        OpenTelemetryTracerStats{OPENTELEMETRY_TRACER_STATS(
+            POOL_COUNTER_PREFIX(*store_.rootScope(), "tracing.opentelemetry"))},
+        std::make_shared<Resource>(), sampler_);
+  }
+
+  Tracing::SpanPtr startRootSpan() {
+    return tracer_->startSpan("operation_name", time_system_.systemTime(),
+                              Tracing::Decision{Tracing::Reason::Sampling, true}, {},
+                              ::opentelemetry::proto::trace::v1::Span::SPAN_KIND_SERVER);
+  }
+
+  uint64_t tracerCounter(const std::string& name) {
+    return TestUtility::findCounter(store_, name)->value();
+  }
+
+  NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<Tracing::MockConfig> tracing_config_;
+  Stats::TestUtil::TestStore store_;
+  std::shared_ptr<AdaptiveSampler> sampler_;
+  std::unique_ptr<Tracer> tracer_;
+};
+
+// Spans of a slow request are exported when the local root span ends.
+TEST_F(AdaptiveSamplerTracerTest, DeferredSpansSentForSlowRequest) {
+  createTracer(R"EOF(
+    spans_per_second: 1
+    tail_sampling:
+      latency_threshold: 1s
+  )EOF");
+  // Use up the budget.
+  Tracing::SpanPtr sampled_span = startRootSpan();
+
+  Tracing::SpanPtr root_span = startRootSpan();
+  Tracing::SpanPtr child_span =
+      root_span->spawnChild(tracing_config_, "child", time_system_.systemTime());
+  child_span->finishSpan();
+  EXPECT_EQ(1U, tracer_->deferredSpansBuffered());
+  EXPECT_EQ(0U, tracerCounter("tracing.opentelemetry.deferred_spans_sent"));
+
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  root_span->finishSpan();
+  EXPECT_EQ(0U, tracer_->deferredSpansBuffered());
+  EXPECT_EQ(2U, tracerCounter("tracing.opentelemetry.deferred_spans_sent"));
+
+  // A child span ending after the local root span follows its decision.
+  Tracing::SpanPtr late_child_span =
+      root_span->spawnChild(tracing_config_, "late_child", time_system_.systemTime());
+  late_child_span->finishSpan();
+  EXPECT_EQ(3U, tracerCounter("tracing.opentelemetry.deferred_spans_sent"));
+}
+
+// Spans of a fast, successful request are dropped.
+TEST_F(AdaptiveSamplerTracerTest, DeferredSpansDroppedForFastRequest) {
+  createTracer(R"EOF(
+    spans_per_second: 1
+    tail_sampling:
+      latency_threshold: 1s
+  )EOF");
+  Tracing::SpanPtr sampled_span = startRootSpan();
+
+  Tracing::SpanPtr root_span = startRootSpan();
+  Tracing::SpanPtr child_span =
+      root_span->spawnChild(tracing_config_, "child", time_system_.systemTime());
+  child_span->finishSpan();
+  root_span->finishSpan();
+  EXPECT_EQ(0U, tracer_->deferredSpansBuffered());
+  EXPECT_EQ(0U, tracerCounter("tracing.opentelemetry.deferred_spans_sent"));
+  EXPECT_EQ(2U, tracerCounter("tracing.opentelemetry.deferred_spans_dropped"));
+}
+
+// The number of buffered spans per worker is bounded.
+TEST_F(AdaptiveSamplerTracerTest, DeferredSpansOverflow) {
+  createTracer(R"EOF(
+    spans_per_second: 1
+    tail_sampling:
+      latency_threshold: 1s
+      max_buffered_spans: 1
+  )EOF");
+  Tracing::SpanPtr sampled_span = startRootSpan();
+
+  Tracing::SpanPtr root_span = startRootSpan();
+  for (int i = 0; i < 3; ++i) {
+    root_span->spawnChild(tracing_config_, "child", time_system_.systemTime())->finishSpan();
+  }
+  EXPECT_EQ(1U, tracer_->deferredSpansBuffered());
+  EXPECT_EQ(2U, tracerCounter("tracing.opentelemetry.deferred_spans_overflow"));
+
+  // Buffered spans are released if the local root span goes away without ending.
+  root_span.reset();
+  EXPECT_EQ(0U, tracer_->deferredSpansBuffered());
+}
+
+// Explicitly not sampled spans are never exported.
+TEST_F(AdaptiveSamplerTracerTest, SetSampledFalseDisablesDeferredDecision) {
+  createTracer(R"EOF(
+    spans_per_second: 1
+    tail_sampling:
+      latency_threshold: 1s
+  )EOF");
+  Tracing::SpanPtr sampled_span = startRootSpan();
+
+  Tracing::SpanPtr root_span = startRootSpan();
+  root_span->setSampled(false);
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  root_span->finishSpan();
+  EXPECT_EQ(0U, tracerCounter("tracing.opentelemetry.deferred_spans_sent"));
+  EXPECT_EQ(0U, tracerCounter("tracing.opentelemetry.deferred_spans_dropped"));
+}
+
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
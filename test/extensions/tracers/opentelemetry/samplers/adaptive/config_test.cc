@@ -0,0 +1,62 @@
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/tracers/opentelemetry/samplers/adaptive/config.h"
+
+#include "test/mocks/server/tracer_factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+
+// Test create sampler via factory
+TEST(AdaptiveSamplerFactoryTest, Test) {
+  auto* factory = Registry::FactoryRegistry<SamplerFactory>::getFactory(
+      "envoy.tracers.opentelemetry.samplers.adaptive");
+  ASSERT_NE(factory, nullptr);
+  EXPECT_STREQ(factory->name().c_str(), "envoy.tracers.opentelemetry.samplers.adaptive");
+  EXPECT_NE(factory->createEmptyConfigProto(), nullptr);
+
+  envoy::config::core::v3::TypedExtensionConfig typed_config;
+  const std::string yaml = R"EOF(
+    name: envoy.tracers.opentelemetry.samplers.adaptive
+    typed_config:
+        "@type": type.googleapis.com/envoy.extensions.tracers.opentelemetry.samplers.v3.AdaptiveSamplerConfig
+        spans_per_second: 10
+        tail_sampling:
+          latency_threshold: 1s
+          sample_errors: true
+  )EOF";
+  TestUtility::loadFromYaml(yaml, typed_config);
+  NiceMock<Server::Configuration::MockTracerFactoryContext> context;
+  auto sampler = factory->createSampler(typed_config.typed_config(), context);
+  ASSERT_NE(sampler, nullptr);
+  EXPECT_EQ(sampler->getDescription(), "AdaptiveSampler");
+  EXPECT_EQ(sampler->maxDeferredSpans(), 10000);
+}
+
+// A zero budget is rejected by validation.
+TEST(AdaptiveSamplerFactoryTest, ZeroBudget) {
+  auto* factory = Registry::FactoryRegistry<SamplerFactory>::getFactory(
+      "envoy.tracers.opentelemetry.samplers.adaptive");
+  ASSERT_NE(factory, nullptr);
+
+  envoy::config::core::v3::TypedExtensionConfig typed_config;
+  const std::string yaml = R"EOF(
+    name: envoy.tracers.opentelemetry.samplers.adaptive
+    typed_config:
+        "@type": type.googleapis.com/envoy.extensions.tracers.opentelemetry.samplers.v3.AdaptiveSamplerConfig
+        spans_per_second: 0
+  )EOF";
+  TestUtility::loadFromYaml(yaml, typed_config);
+  NiceMock<Server::Configuration::MockTracerFactoryContext> context;
+  EXPECT_THROW(factory->createSampler(typed_config.typed_config(), context), EnvoyException);
+}
+
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
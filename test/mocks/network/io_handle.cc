@@ -2,10 +2,14 @@
 
 #include "envoy/network/address.h"
 
+using testing::Return;
+
 namespace Envoy {
 namespace Network {
 
-MockIoHandle::MockIoHandle() = default;
+MockIoHandle::MockIoHandle() {
+  ON_CALL(*this, supportsAdaptiveReadSize()).WillByDefault(Return(true));
+}
 MockIoHandle::~MockIoHandle() = default;
 
 } // namespace Network
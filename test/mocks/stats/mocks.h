@@ -74,7 +74,9 @@ public:
   std::string tagExtractedName() const override {
     return tag_extracted_name_.empty() ? name() : tag_extracted_name_;
   }
-  StatName tagExtractedStatName() const override { return tag_extracted_stat_name_->statName(); }
+  StatName tagExtractedStatName() const override {
+    return tag_extracted_stat_name_ == nullptr ? statName() : tag_extracted_stat_name_->statName();
+  }
   void iterateTagStatNames(const Metric::TagStatNameIterFn& fn) const override {
     ASSERT((tag_names_and_values_.size() % 2) == 0);
     for (size_t i = 0; i < tag_names_and_values_.size(); i += 2) {
@@ -46,6 +46,13 @@ MockHostDescription::MockHostDescription()
       .WillByDefault(Invoke([this](Upstream::ResourcePriority pri) -> bool {
         return cluster().resourceManager(pri).connections().canCreate();
       }));
+  ON_CALL(*this, happyEyeballsOutcome()).WillByDefault(Invoke([this]() {
+    return happy_eyeballs_outcome_;
+  }));
+  ON_CALL(*this, setHappyEyeballsOutcome(_))
+      .WillByDefault(Invoke([this](absl::optional<HappyEyeballsOutcome> outcome) {
+        happy_eyeballs_outcome_ = outcome;
+      }));
 }
 
 MockHostDescription::~MockHostDescription() = default;
@@ -63,6 +70,13 @@ MockHost::MockHost() : socket_factory_(new testing::NiceMock<Network::MockTransp
   ON_CALL(*this, lbPolicyData()).WillByDefault(Invoke([this]() -> OptRef<HostLbPolicyData> {
     return makeOptRefFromPtr(lb_policy_data_.get());
   }));
+  ON_CALL(*this, happyEyeballsOutcome()).WillByDefault(Invoke([this]() {
+    return happy_eyeballs_outcome_;
+  }));
+  ON_CALL(*this, setHappyEyeballsOutcome(_))
+      .WillByDefault(Invoke([this](absl::optional<HappyEyeballsOutcome> outcome) {
+        happy_eyeballs_outcome_ = outcome;
+      }));
 }
 
 MockHost::~MockHost() = default;
@@ -106,6 +106,9 @@ public:
   MOCK_METHOD(void, priority, (uint32_t));
   MOCK_METHOD(absl::optional<MonotonicTime>, lastHcPassTime, (), (const));
   MOCK_METHOD(void, setLastHcPassTime, (MonotonicTime last_hc_pass_time));
+  MOCK_METHOD(absl::optional<HappyEyeballsOutcome>, happyEyeballsOutcome, (), (const));
+  MOCK_METHOD(void, setHappyEyeballsOutcome, (absl::optional<HappyEyeballsOutcome> outcome),
+              (const));
   Stats::StatName localityZoneStatName() const override {
     locality_zone_stat_name_ =
         std::make_unique<Stats::StatNameManagedStorage>(locality().zone(), *symbol_table_);
@@ -125,6 +128,7 @@ public:
   HostStats stats_;
   LoadMetricStatsImpl load_metric_stats_;
   envoy::config::core::v3::Locality locality_;
+  mutable absl::optional<HappyEyeballsOutcome> happy_eyeballs_outcome_;
   mutable Stats::TestUtil::TestSymbolTable symbol_table_;
   mutable std::unique_ptr<Stats::StatNameManagedStorage> locality_zone_stat_name_;
 };
@@ -209,6 +213,9 @@ public:
   MOCK_METHOD(void, priority, (uint32_t));
   MOCK_METHOD(bool, warmed, (), (const));
   MOCK_METHOD(absl::optional<MonotonicTime>, lastHcPassTime, (), (const));
+  MOCK_METHOD(absl::optional<HappyEyeballsOutcome>, happyEyeballsOutcome, (), (const));
+  MOCK_METHOD(void, setHappyEyeballsOutcome, (absl::optional<HappyEyeballsOutcome> outcome),
+              (const));
   MOCK_METHOD(void, setLbPolicyData, (HostLbPolicyDataPtr lb_policy_data));
   MOCK_METHOD(OptRef<HostLbPolicyData>, lbPolicyData, (), (const));
 
@@ -237,6 +244,7 @@ public:
   HostStats stats_;
   LoadMetricStatsImpl load_metric_stats_;
   HostLbPolicyDataPtr lb_policy_data_;
+  mutable absl::optional<HappyEyeballsOutcome> happy_eyeballs_outcome_;
   mutable Stats::TestUtil::TestSymbolTable symbol_table_;
   mutable std::unique_ptr<Stats::StatNameManagedStorage> locality_zone_stat_name_;
 };
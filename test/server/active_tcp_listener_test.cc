@@ -283,10 +283,6 @@ TEST_F(ActiveTcpListenerTest, ListenerFilterWithInspectDataMultipleFilters) {
         EXPECT_EQ(128, size);
         return Api::IoCallUint64Result(128, Api::IoError::none());
       })
-      .WillOnce([&](void*, size_t size, int) {
-        EXPECT_EQ(512, size);
-        return Api::IoCallUint64Result(512, Api::IoError::none());
-      })
       .WillOnce([&](void*, size_t size, int) {
         EXPECT_EQ(512, size);
         return Api::IoCallUint64Result(512, Api::IoError::none());
@@ -301,13 +297,11 @@ TEST_F(ActiveTcpListenerTest, ListenerFilterWithInspectDataMultipleFilters) {
 
   EXPECT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
 
+  // The data peeked for the second filter is large enough for the third filter, which inspects it
+  // without peeking again.
   EXPECT_CALL(*inspect_data_filter2, onData(_)).WillOnce(Return(Network::FilterStatus::Continue));
-  EXPECT_CALL(io_handle_, activateFileEvents(Event::FileReadyType::Read));
   EXPECT_CALL(*inspect_data_filter3, onAccept(_))
       .WillOnce(Return(Network::FilterStatus::StopIteration));
-
-  EXPECT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
-
   EXPECT_CALL(*inspect_data_filter3, onData(_)).WillOnce(Return(Network::FilterStatus::Continue));
   EXPECT_CALL(manager_, findFilterChain(_, _)).WillOnce(Return(nullptr));
 
@@ -367,10 +361,6 @@ TEST_F(ActiveTcpListenerTest, ListenerFilterWithInspectDataMultipleFilters2) {
         EXPECT_EQ(128, size);
         return Api::IoCallUint64Result(128, Api::IoError::none());
       })
-      .WillOnce([&](void*, size_t size, int) {
-        EXPECT_EQ(512, size);
-        return Api::IoCallUint64Result(512, Api::IoError::none());
-      })
       .WillOnce([&](void*, size_t size, int) {
         EXPECT_EQ(512, size);
         return Api::IoCallUint64Result(512, Api::IoError::none());
@@ -394,13 +384,10 @@ TEST_F(ActiveTcpListenerTest, ListenerFilterWithInspectDataMultipleFilters2) {
 
   EXPECT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
 
+  // The third filter inspects the data peeked for the second filter without peeking again.
   EXPECT_CALL(*inspect_data_filter2, onData(_)).WillOnce(Return(Network::FilterStatus::Continue));
   EXPECT_CALL(*inspect_data_filter3, onAccept(_))
       .WillOnce(Return(Network::FilterStatus::StopIteration));
-  EXPECT_CALL(io_handle_, activateFileEvents(Event::FileReadyType::Read));
-
-  EXPECT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
-
   EXPECT_CALL(*inspect_data_filter3, onData(_)).WillOnce(Return(Network::FilterStatus::Continue));
   EXPECT_CALL(manager_, findFilterChain(_, _)).WillOnce(Return(nullptr));
 
@@ -464,10 +451,6 @@ TEST_F(ActiveTcpListenerTest, ListenerFilterWithInspectDataMultipleFilters3) {
         EXPECT_EQ(128, size);
         return Api::IoCallUint64Result(128, Api::IoError::none());
       })
-      .WillOnce([&](void*, size_t size, int) {
-        EXPECT_EQ(512, size);
-        return Api::IoCallUint64Result(512, Api::IoError::none());
-      })
       .WillOnce([&](void*, size_t size, int) {
         EXPECT_EQ(512, size);
         return Api::IoCallUint64Result(512, Api::IoError::none());
@@ -500,16 +483,13 @@ TEST_F(ActiveTcpListenerTest, ListenerFilterWithInspectDataMultipleFilters3) {
 
   EXPECT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
 
+  // The third filter inspects the data peeked for the second filter without peeking again.
   EXPECT_CALL(*inspect_data_filter3, onAccept(_))
       .WillOnce(Return(Network::FilterStatus::StopIteration));
-  EXPECT_CALL(io_handle_, activateFileEvents(Event::FileReadyType::Read));
-
-  tcp_socket1->continueFilterChain(true);
-
   EXPECT_CALL(*inspect_data_filter3, onData(_)).WillOnce(Return(Network::FilterStatus::Continue));
   EXPECT_CALL(manager_, findFilterChain(_, _)).WillOnce(Return(nullptr));
 
-  EXPECT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  tcp_socket1->continueFilterChain(true);
 }
 
 /**
@@ -2,6 +2,8 @@
 
 #include <regex>
 
+#include "envoy/stream_info/filter_state.h"
+
 #include "source/common/common/logger.h"
 #include "source/common/common/logger_delegates.h"
 #include "source/common/common/thread.h"
@@ -160,6 +162,9 @@ int TestRunner::runTests(int argc, char** argv) {
   // Reset all ENVOY_BUG counters.
   Envoy::Assert::resetEnvoyBugCountersForTest();
 
+  // Finalize the well-known filter state data names, as the server does before starting workers.
+  StreamInfo::FilterState::finalizeInlineKeys();
+
 #ifdef FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
   // Fuzz tests may run Envoy tests in fuzzing mode to generate corpora. In this case, we do not
   // want to fail building the fuzz test because of a failed test run, which can happen when testing